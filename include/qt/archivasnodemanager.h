@@ -2,58 +2,177 @@
 #define ARCHIVAS_NODE_MANAGER_H
 
 #include <QObject>
-#include <QTimer>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QList>
+#include <QSocketNotifier>
 #include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QMetaType>
+#include <functional>
 
 extern "C" {
 #include "go/bridge/node.h"
 #include "go/bridge/farmer.h"
+#include "go/bridge/events.h"
+#include "go/bridge/logs.h"
 }
 
+// One log line drained from the bridge log arena
+struct LogRecord {
+    enum Source {
+        Node = ARCHIVAS_LOG_SOURCE_NODE,
+        Farmer = ARCHIVAS_LOG_SOURCE_FARMER
+    };
+
+    Source source;
+    QString level;       // "DEBUG", "INFO", "WARN" or "ERROR"
+    QString message;
+    qint64 timestampNs;  // Unix nanoseconds
+};
+Q_DECLARE_METATYPE(LogRecord)
+
+// Formats the records from source as "[time] [LEVEL] message" lines joined by '\n'
+QString formatLogRecords(const QVector<LogRecord> &records, LogRecord::Source source);
+
 class ArchivasNodeManager : public QObject {
     Q_OBJECT
 
 public:
+    enum SyncStage {
+        SyncIdle = ARCHIVAS_SYNC_IDLE,
+        SyncRunning = ARCHIVAS_SYNC_RUNNING,
+        SyncComplete = ARCHIVAS_SYNC_COMPLETE,
+        SyncFailed = ARCHIVAS_SYNC_FAILED
+    };
+    Q_ENUM(SyncStage)
+
+    // Lifecycle of the embedded node or farmer (mirrors ARCHIVAS_SERVICE_*)
+    enum ServiceState {
+        Stopped = ARCHIVAS_SERVICE_STOPPED,
+        Starting = ARCHIVAS_SERVICE_STARTING,
+        Running = ARCHIVAS_SERVICE_RUNNING,
+        Stopping = ARCHIVAS_SERVICE_STOPPING,
+        Failed = ARCHIVAS_SERVICE_FAILED
+    };
+    Q_ENUM(ServiceState)
+
     explicit ArchivasNodeManager(QObject *parent = nullptr);
     ~ArchivasNodeManager();
 
+    // Start, stop and restart never block. Start and restart futures finish with
+    // true once the service is running, false if startup failed or was cancelled;
+    // stop futures finish with true once teardown is complete. A start requested
+    // while the previous instance is still stopping begins as soon as it has stopped.
+
     // Node methods
-    bool startNode(const QString &networkId, const QString &rpcBind, const QString &dataDir, const QString &bootnodes, const QString &genesisPath);
-    void stopNode();
-    bool isNodeRunning() const;
+    QFuture<bool> startNode(const QString &networkId, const QString &rpcBind, const QString &dataDir, const QString &bootnodes, const QString &genesisPath);
+    QFuture<bool> stopNode();
+    QFuture<bool> restartNode(const QString &networkId, const QString &rpcBind, const QString &dataDir, const QString &bootnodes, const QString &genesisPath);
+    ServiceState nodeState() const;
+    bool isNodeRunning() const;  // Starting, Running or Stopping
 
     // Farmer methods
-    bool startFarmer(const QString &nodeUrl, const QString &plotsPath, const QString &farmerPrivkey);
-    void stopFarmer();
-    bool isFarmerRunning() const;
+    QFuture<bool> startFarmer(const QString &nodeUrl, const QString &plotsPath, const QString &farmerPrivkey);
+    QFuture<bool> stopFarmer();
+    QFuture<bool> restartFarmer(const QString &nodeUrl, const QString &plotsPath, const QString &farmerPrivkey);
+    ServiceState farmerState() const;
+    bool isFarmerRunning() const;  // Starting, Running or Stopping
     bool createPlot(const QString &plotPath, unsigned int kSize, const QString &farmerPrivkeyPath);
 
-    // Status queries
+    // Stops the farmer and node; finishes once both have fully stopped
+    QFuture<bool> shutdown();
+
+    // Display name and status label style for a lifecycle state
+    static QString serviceStateName(ServiceState state);
+    static QString serviceStateStyle(ServiceState state);
+
+    // Status queries (served from the snapshot refreshed whenever bridge events arrive)
     int getCurrentHeight() const;
     QString getTipHash() const;
+    quint64 getDifficulty() const;
     int getPeerCount() const;
     int getPlotCount() const;
     QString getLastProof() const;
+    bool isIbdRunning() const;
+    quint64 getIbdTargetHeight() const;
+    quint64 getStatusSequence() const;
+
+    // Log level gating, applied inside the bridge before messages are formatted
+    static QStringList logLevelNames();
+    void setLogLevel(LogRecord::Source source, const QString &level);
+
+    // Listen address of the node's event stream, used from the next start; empty disables it
+    void setStreamBind(const QString &bind);
+    QString logLevel(LogRecord::Source source) const;
 
 signals:
     void nodeStarted();
     void nodeStopped();
-    void nodeLog(const QString &level, const QString &message);
     void farmerStarted();
     void farmerStopped();
-    void farmerLog(const QString &level, const QString &message);
+    void nodeStateChanged(ArchivasNodeManager::ServiceState state);
+    void farmerStateChanged(ArchivasNodeManager::ServiceState state);
     void statusUpdated();
 
+    // Node and farmer logs, delivered at most once per frame
+    void logBatch(const QVector<LogRecord> &records);
+    void logLevelChanged(LogRecord::Source source, const QString &level);
+
+    // Pushed from the Go bridge event ring
+    void tipChanged(quint64 height, const QString &tipHash, quint64 difficulty);
+    void peerConnected(const QString &address);
+    void peerDisconnected(const QString &address);
+    void peerCountChanged(int peerCount);
+    void syncStageChanged(ArchivasNodeManager::SyncStage stage);
+    void syncProgress(quint64 currentHeight, quint64 targetHeight);
+    void farmerProofFound(quint64 quality, quint64 height, const QString &proofHash);
+    void plotLoaded(const QString &plotName, int plotCount);
+
 private slots:
-    void updateStatus();
-    void emitNodeLog(const QString &level, const QString &message);
-    void emitFarmerLog(const QString &level, const QString &message);
+    void onEventsReady();
+    void flushLogs();
 
 private:
-    QTimer *m_statusTimer;
+    // Lifecycle bookkeeping for the node or the farmer
+    struct ServiceControl {
+        int (*bridgeState)();
+        void (*bridgeStop)();
+        ServiceState state;
+        std::function<int()> deferredStart;          // Start waiting for a stop to finish
+        QList<QFutureInterface<bool>> startWaiters;
+        QList<QFutureInterface<bool>> stopWaiters;
+    };
+
+    QFuture<bool> requestStart(ServiceControl &service, const std::function<int()> &launch);
+    QFuture<bool> requestStop(ServiceControl &service);
+    void syncServiceState(ServiceControl &service);
+    void setServiceState(ServiceControl &service, ServiceState state);
+    void checkShutdown();
+
+    void refreshSnapshot();
+    void dispatchEvent(const archivas_event &event);
+    void scheduleLogFlush();
+
+    // Per-line log delivery, used only when the event pipe (and so the log
+    // arena's wakeup) could not be set up. Called from Go threads.
+    static ArchivasNodeManager* s_instance;
+    static void postLogRecord(LogRecord::Source source, const char* level, const char* message);
     static void logCallback(char* level, char* message);
     static void farmerLogCallback(char* level, char* message);
-    static ArchivasNodeManager* s_instance;
+
+    int m_eventPipe[2];
+    QSocketNotifier *m_eventNotifier;
+    ServiceControl m_node;
+    ServiceControl m_farmer;
+    QList<QFutureInterface<bool>> m_shutdownWaiters;
+    archivas_status_snapshot m_snapshot;
+    QTimer *m_logFlushTimer;
+    QElapsedTimer m_lastLogFlush;
+    QString m_logLevels[2];
 };
 
 #endif // ARCHIVAS_NODE_MANAGER_H
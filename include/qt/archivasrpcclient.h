@@ -7,39 +7,69 @@
 #include <QString>
 #include <QList>
 #include <QJsonObject>
+#include <QJsonDocument>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QFutureInterface>
+#include <functional>
+#include "chaintypes.h"
+#include "rpcendpointpool.h"
 
-struct ChainTip {
-    QString height;
-    QString hash;
-    QString difficulty;
-    QString timestamp;
+// Request counters since the client was created
+struct RpcStats {
+    quint64 issued = 0;     // HTTP requests sent, including fallback retries
+    quint64 coalesced = 0;  // Calls that joined an identical request in flight
+    quint64 cached = 0;     // Calls answered from a result younger than the TTL
+    quint64 retried = 0;    // Requests resent to another endpoint after an error
+    quint64 hedged = 0;     // GETs also sent to a second endpoint for being slow
+    quint64 timedOut = 0;   // Requests aborted at their deadline
+    quint64 superseded = 0; // Requests aborted because a newer one for the resource was issued
+    quint64 stale = 0;      // Results dropped because a newer one was already delivered
+    quint64 batched = 0;    // Batches answered by /batch in one round trip
 };
 
-struct BlockInfo {
-    QString height;
-    QString hash;
-    QString farmer;
-    int txCount;
-    QString timestamp;
-    QString difficulty;
+// Results of one RpcBatch, delivered together. Parts that were not asked for
+// stay empty.
+struct RpcBatchResult {
+    bool ok = true;         // False if any part could not be fetched
+    bool hasTip = false;
+    ChainTip tip;
+    QList<BlockInfo> blocks;
+    QList<TransactionInfo> txs;
+    QList<AccountInfo> accounts;
 };
 
-struct TransactionInfo {
-    QString hash;
-    QString from;
-    QString to;
-    QString amount;
-    QString fee;
-    QString height;
-    QString timestamp;
-};
+class ArchivasRpcClient;
+
+// Several queries sent in one round trip:
+//   client->batch().chainTip().recentBlocks(20).recentTxs(50).accounts(list).send()
+// Results are also emitted through the client's usual signals.
+class RpcBatch
+{
+public:
+    RpcBatch& chainTip() { m_tip = true; return *this; }
+    RpcBatch& recentBlocks(int limit) { m_blocks = limit; return *this; }
+    RpcBatch& recentTxs(int limit) { m_txs = limit; return *this; }
+    RpcBatch& accounts(const QStringList& addresses);
+    QFuture<RpcBatchResult> send();
 
-struct AccountInfo {
-    QString address;
-    QString balance;
-    QString nonce;
+private:
+    friend class ArchivasRpcClient;
+    explicit RpcBatch(ArchivasRpcClient* client) : m_client(client) {}
+
+    ArchivasRpcClient* m_client;
+    bool m_tip = false;
+    int m_blocks = 0;
+    int m_txs = 0;
+    QStringList m_accounts;
 };
 
+class QThreadPool;
+
 class ArchivasRpcClient : public QObject
 {
     Q_OBJECT
@@ -48,24 +78,105 @@ public:
     explicit ArchivasRpcClient(QObject *parent = nullptr);
     ~ArchivasRpcClient();
 
-    void setBaseUrl(const QString& url);
-    void setFallbackUrl(const QString& url);
-    QString getBaseUrl() const { return m_baseUrl; }
+    // Endpoints in preference order. Requests go to the best-scoring healthy
+    // one and fail over to the next; see RpcEndpointPool.
+    void setEndpoints(const QStringList& urls);
+    QString currentUrl() const { return m_endpointPool->pick(); }
+    RpcEndpointPool* endpointPool() const { return m_endpointPool; }
+
+    // Resend an unanswered GET to a second endpoint after the first one's p95 latency
+    void setHedgingEnabled(bool enabled) { m_hedging = enabled; }
+
+    // RPC bind address of the embedded node. While that node is running and the
+    // base URL points at it, chain queries are answered in-process through the
+    // bridge instead of over HTTP. Pass an empty string to always use HTTP.
+    void setEmbeddedRpcBind(const QString& bind);
+
+    // Identical GET requests share one reply while it is in flight, and its
+    // parsed result is replayed to later callers for ttlMs. 0 disables the cache.
+    void setCacheTtl(int ttlMs);
+    RpcStats stats() const { return m_stats; }
+
+    // Each request is aborted once it has been unanswered for timeoutMs,
+    // counting retries and hedges. A single endpoint gets at most half of it.
+    void setRequestTimeout(int timeoutMs);
+
+    // Track the chain from the newest window blocks onwards. Each chain tip
+    // update then fetches only the blocks above the last one delivered, via
+    // /blocks/range, and reports them through blocksAppended / reorgDetected.
+    void followBlocks(int window = 20);
+
+    // Long-lived Server-Sent Events subscription to new tips, blocks and mempool
+    // transactions (GET /events, see stream.go). Streamed blocks that extend the
+    // followed chain are appended without a range request. The stream
+    // reconnects with backoff and resumes after the last block delivered. An
+    // empty url unsubscribes.
+    void subscribe(const QString& url);
+    bool isSubscribed() const { return m_streamLive; }
 
     // Async RPC methods
     void getChainTip();
     void getRecentBlocks(int limit = 20);
     void getRecentTransactions(int limit = 50);
     void getAccount(const QString& address);
+    // limit blocks from height from up, through /blocks/range, for browsing
+    // history. Independent of followBlocks; pages never supersede each other.
+    void getBlockPage(quint64 from, int limit);
     void submitTransaction(const QByteArray& txData);
 
+    // POSTs the queries to /batch beside the subscribed event stream (see
+    // subscribe). Without a stream URL, or when that service lacks /batch
+    // (404 or 405, remembered), batches are sent as individual requests in
+    // parallel, which also coalesce and use the cache.
+    RpcBatch batch() { return RpcBatch(this); }
+
     bool isConnected() const { return m_connected; }
 
+    // Typed result of decoding one reply
+    struct ParsedReply {
+        enum Kind { Unrecognized, Invalid, Tip, Blocks, BlockRange, BlockPage, Transactions, Account };
+        Kind kind = Unrecognized;
+        ChainTip tip;
+        QList<BlockInfo> blocks;
+        QList<TransactionInfo> txs;
+        AccountInfo account;
+    };
+    // The decoders the client runs on its parse pool. Pure functions of their
+    // input, so any thread may call them.
+    static ParsedReply parseTipReply(const QJsonDocument& doc);
+    static ParsedReply parseBlocksReply(const QJsonDocument& doc);
+    static ParsedReply parseBlockRangeReply(const QJsonDocument& doc);
+    static ParsedReply parseBlockPageReply(const QJsonDocument& doc);
+    static ParsedReply parseTransactionsReply(const QJsonDocument& doc);
+    static ParsedReply parseAccountReply(const QJsonDocument& doc);
+    static ChainTip parseChainTip(const QJsonObject& json);
+    static QList<BlockInfo> parseBlocks(const QJsonArray& jsonArray);
+    static QList<BlockInfo> parseBlockRange(const QJsonArray& jsonArray);
+    static QList<TransactionInfo> parseBlockRangeTxs(const QJsonArray& jsonArray);
+    static QList<TransactionInfo> parseTransactions(const QJsonArray& jsonArray);
+    static AccountInfo parseAccount(const QJsonObject& json);
+
 signals:
     void chainTipUpdated(const ChainTip& tip);
     void blocksUpdated(const QList<BlockInfo>& blocks);
+    // New blocks above the last ones delivered, in ascending height order
+    void blocksAppended(const QList<BlockInfo>& blocks);
+    // Blocks delivered earlier at fromHeight and above are no longer on the chain
+    void reorgDetected(quint64 fromHeight);
+    // The endpoints changed, so blocks delivered earlier may or may not be on
+    // the new servers' chain. Stores should check what they hold against it
+    // rather than drop everything.
+    void sourceChanged();
     void transactionsUpdated(const QList<TransactionInfo>& txs);
     void accountUpdated(const AccountInfo& account);
+    // Answer to getBlockPage; fewer than limit blocks when the page reaches the
+    // tip. txs are the transactions of those blocks, in chain order.
+    void blockPageLoaded(quint64 from, const QList<BlockInfo>& blocks, const QList<TransactionInfo>& txs);
+    // A pending transaction from the event stream. Its hash is an id the
+    // node gives it until it is mined, and height the block expected to hold it.
+    void mempoolTransactionAdded(const TransactionInfo& tx);
+    // The event stream connected (live) or dropped; polling covers the gaps
+    void subscriptionChanged(bool live);
     void connected();
     void disconnected();
     void error(const QString& message);
@@ -73,21 +184,116 @@ signals:
 private slots:
     void onReplyFinished(QNetworkReply* reply);
     void onNetworkError(QNetworkReply::NetworkError error);
+    void onFollowedChainTip(const ChainTip& tip);
+    void onStreamReadyRead();
+    void onStreamFinished();
 
 private:
     QNetworkAccessManager* m_networkManager;
-    QString m_baseUrl;
-    QString m_fallbackUrl;
+    // Requests with their own completion handling (event stream, batches), so
+    // they never reach onReplyFinished
+    QNetworkAccessManager* m_directManager;
+    RpcEndpointPool* m_endpointPool;
+    QString m_embeddedRpcBind;
     bool m_connected;
-    bool m_usingFallback;
-
-    QNetworkReply* makeGetRequest(const QString& endpoint);
-    QNetworkReply* makePostRequest(const QString& endpoint, const QByteArray& data);
-    ChainTip parseChainTip(const QJsonObject& json);
-    QList<BlockInfo> parseBlocks(const QJsonArray& jsonArray);
-    QList<TransactionInfo> parseTransactions(const QJsonArray& jsonArray);
-    AccountInfo parseAccount(const QJsonObject& json);
+    bool m_hedging;
+
+    // Continuation chosen by the caller that issued the request; decodes the
+    // reply body on the parse pool
+    using ReplyParser = ParsedReply (*)(const QJsonDocument& doc);
+
+    // HTTP requests in flight, by id. Ids increase monotonically and double as
+    // sequence numbers. One request can have several replies while hedged, and
+    // is resent to the next endpoint when a reply fails.
+    struct PendingRequest {
+        QString key;        // Single-flight key; empty for POSTs
+        QString resource;   // Path without the query; what the result replaces
+        QString endpoint;   // Path and query below the endpoint URL
+        ReplyParser parse = nullptr;  // Null when the reply body is not used
+        QByteArray body;
+        bool post = false;
+        qint64 deadlineMs = 0;  // On m_clock
+        QStringList tried;  // Endpoints this request has been sent to
+        QList<QNetworkReply*> replies;
+    };
+    QHash<quint64, PendingRequest> m_requests;
+    QHash<QString, quint64> m_latestRequest;     // Newest request id per resource
+    QHash<QString, quint64> m_deliveredSequence; // Id of the newest result delivered per resource
+    quint64 m_nextRequestId;
+    int m_requestTimeoutMs;
+    QElapsedTimer m_clock;
+
+    void startRequest(PendingRequest request);
+    void sendRequest(quint64 id, const QString& baseUrl);
+    void cancelRequest(quint64 id);
+    void expireRequest(quint64 id);
+    bool acceptResult(const QString& resource, quint64 sequence);
+    static QString resourceOf(const QString& endpoint);
+
+    // Single-flight state, keyed by normalized endpoint
+    struct CachedResult {
+        qint64 fetchedAtMs;
+        std::function<void()> replay;
+    };
+    QSet<QString> m_inFlight;
+    QHash<QString, CachedResult> m_cache;
+    int m_cacheTtlMs;
+    RpcStats m_stats;
+
+    // Block cursor: hashes of the newest blocks delivered, by height. The
+    // highest key is the cursor; lower ones let a replaced block be spotted.
+    QMap<quint64, Hash32> m_deliveredBlocks;
+    int m_blockWindow;
+    bool m_blockRangePending;
+
+    void requestBlockRange(quint64 from, int limit);
+    void applyBlockRange(const QList<BlockInfo>& blocks);
+    void rewindBlocks(quint64 fromHeight);
+
+    // Event stream
+    QNetworkReply* m_streamReply;
+    QString m_streamUrl;
+    QByteArray m_streamBuffer;  // Bytes after the last complete line
+    QString m_streamEvent;      // Fields of the event being read
+    QByteArray m_streamData;
+    QByteArray m_streamLastId;
+    int m_streamRetryMs;
+    bool m_streamLive;
+
+    void openStream();
+    void closeStream();
+    void dispatchStreamEvent(const QString& event, const QByteArray& data);
+
+    // Batches
+    friend class RpcBatch;
+    QSet<QString> m_noBatchEndpoints;
+
+    QFuture<RpcBatchResult> sendBatch(const RpcBatch& batch);
+    void sendBatchParallel(const RpcBatch& batch, QFutureInterface<RpcBatchResult> promise);
+    void deliverBatch(const RpcBatch& batch, quint64 sequence, const RpcBatchResult& result);
+    static RpcBatchResult parseBatchReply(const QByteArray& data);
+
+    static QString normalizeEndpoint(const QString& endpoint);
+    bool beginRequest(const QString& key);
+    void finishRequest(const QString& key, const std::function<void()>& replay);
+    void abandonRequest(const QString& key);
+
+    QThreadPool* m_parsePool;
+
+    void deliverReply(quint64 sequence, const QString& resource, const QString& key, const ParsedReply& parsed);
+
+    void makeGetRequest(const QString& endpoint, ReplyParser parse);
+    void makePostRequest(const QString& endpoint, const QByteArray& data);
     void checkConnection();
+    void markConnected();
+
+    // In-process backend (see query.h)
+    bool useEmbeddedNode() const;
+    void queryEmbeddedChainTip(const QString& key);
+    void queryEmbeddedBlocks(const QString& key, int limit);
+    void queryEmbeddedBlockRange(quint64 from, int limit);
+    void queryEmbeddedBlockPage(const QString& key, quint64 from, int limit);
+    void queryEmbeddedTransactions(const QString& key, int limit);
 };
 
 #endif // ARCHIVASRPCCLIENT_H
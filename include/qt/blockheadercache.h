@@ -0,0 +1,83 @@
+#ifndef BLOCKHEADERCACHE_H
+#define BLOCKHEADERCACHE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include "archivasrpcclient.h"
+
+class QFile;
+
+// Block headers from genesis up, kept on disk in one fixed-width file per
+// field and read through memory maps, so history shows at launch without a
+// request or a parse. Entry n is height n. When the first chain tip arrives
+// the newest entry is checked against the node, and dropped entries walk back
+// until one matches; after that the cache grows from followed blocks and
+// background page requests until it reaches the tip. Switching endpoints
+// repeats the check against the new servers.
+class BlockHeaderCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BlockHeaderCache(ArchivasRpcClient* rpcClient, QObject *parent = nullptr);
+    ~BlockHeaderCache();
+
+    // Maps the cache under dir, creating it if needed. An unusable dir leaves
+    // the cache empty and closed.
+    bool open(const QString& dir);
+    void close();
+    bool isOpen() const { return !m_dir.isEmpty(); }
+
+    quint64 count() const { return m_count; }
+    bool contains(quint64 height) const { return height < m_count; }
+
+    // Unchecked; height must be below count()
+    Hash32 hash(quint64 height) const;
+    QString farmer(quint64 height) const;
+    quint32 txCount(quint64 height) const;
+    qint64 timestamp(quint64 height) const;
+    quint64 difficulty(quint64 height) const;
+    BlockInfo block(quint64 height) const;
+
+signals:
+    // Entries at fromHeight and above were added or dropped
+    void changed(quint64 fromHeight);
+
+private slots:
+    void onChainTipUpdated(const ChainTip& tip);
+    void onBlocksAppended(const QList<BlockInfo>& blocks);
+    void onReorgDetected(quint64 fromHeight);
+    void onSourceChanged();
+    void onBlockPageLoaded(quint64 from, const QList<BlockInfo>& blocks);
+    void requestNext();
+
+private:
+    enum Column { HashColumn, FarmerColumn, TxCountColumn, TimestampColumn, DifficultyColumn, ColumnCount };
+
+    ArchivasRpcClient* m_rpcClient;
+    QString m_dir;
+    QFile* m_files[ColumnCount];
+    uchar* m_maps[ColumnCount];
+    quint64 m_capacity;  // Entries the files have room for
+    quint64 m_count;
+    quint64 m_dirtyFrom;  // Lowest entry written since the count was last saved
+
+    bool m_hasTip;
+    quint64 m_tipHeight;
+    bool m_verified;     // The newest entry matched the node's chain
+    quint64 m_rewind;    // Entries dropped on the next mismatch
+
+    bool m_requestPending;
+    quint64 m_requestFrom;
+    QElapsedTimer m_requestTimer;
+
+    const uchar* cell(Column column, quint64 height) const;
+    bool reserve(quint64 count);
+    void append(const QList<BlockInfo>& blocks);
+    void truncate(quint64 count);
+    // Syncs entries written since the last save to disk, then records the count
+    void saveCount();
+};
+
+#endif // BLOCKHEADERCACHE_H
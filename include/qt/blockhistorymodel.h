@@ -0,0 +1,75 @@
+#ifndef BLOCKHISTORYMODEL_H
+#define BLOCKHISTORYMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QElapsedTimer>
+#include <QHash>
+#include "archivasrpcclient.h"
+#include "blockheadercache.h"
+#include "chaintablemodels.h"
+
+// Every block from genesis to the chain tip, newest first. Heights held by
+// the header cache are read straight from it. Other blocks are fetched a
+// fixed-size page at a time, only for rows that are painted or about to be,
+// and the least recently used pages are dropped once the resident ones exceed
+// a memory cap. Rows whose page is not loaded yet show only their height.
+class BlockHistoryModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { HeightColumn, HashColumn, FarmerColumn, TxCountColumn, TimestampColumn, DifficultyColumn, ColumnCount };
+
+    BlockHistoryModel(ArchivasRpcClient* rpcClient, BlockHeaderCache* headerCache, QObject *parent = nullptr);
+
+    bool hasTip() const { return m_hasTip; }
+    quint64 tipHeight() const { return m_tipHeight; }
+    // Invalid above the tip
+    QModelIndex indexOfHeight(quint64 height) const;
+
+    // Rows first..last are on screen: load their pages, and the next one in
+    // the direction the view last moved
+    void setVisibleRows(int first, int last);
+
+    // False while the row's page is not loaded
+    bool block(int row, BlockInfo* block) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private slots:
+    void onChainTipUpdated(const ChainTip& tip);
+    void onBlocksAppended(const QList<BlockInfo>& blocks);
+    void onReorgDetected(quint64 fromHeight);
+    void onBlockPageLoaded(quint64 from, const QList<BlockInfo>& blocks);
+    void onHeaderCacheChanged(quint64 fromHeight);
+
+private:
+    ArchivasRpcClient* m_rpcClient;
+    BlockHeaderCache* m_headerCache;
+    bool m_hasTip;
+    quint64 m_tipHeight;
+
+    // Pages by number (height / page size), in ascending height; cost in bytes.
+    // Mutable because painting a row refreshes its page's place in the LRU.
+    mutable QCache<quint64, BlockColumns> m_pages;
+    // When each partial or outstanding page was last requested, on m_clock
+    mutable QHash<quint64, qint64> m_requestedAtMs;
+    QElapsedTimer m_clock;
+    int m_firstVisibleRow;
+    int m_scrollDirection;  // +1 towards genesis, -1 towards the tip
+
+    quint64 heightOf(int row) const { return m_tipHeight - static_cast<quint64>(row); }
+    int rowOf(quint64 height) const { return static_cast<int>(m_tipHeight - height); }
+    const BlockColumns* findBlock(quint64 height, int* index) const;
+    void requestPage(quint64 number) const;
+    void loadPage(quint64 number) const;
+    void setTipHeight(quint64 height);
+    void truncateFrom(quint64 height);
+    void emitRowsChanged(quint64 lowest, quint64 highest);
+};
+
+#endif // BLOCKHISTORYMODEL_H
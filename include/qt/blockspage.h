@@ -3,31 +3,37 @@
 
 #include <QWidget>
 #include <QVBoxLayout>
-#include <QTableWidget>
+#include <QHBoxLayout>
+#include <QTableView>
 #include <QHeaderView>
-#include <QTimer>
+#include <QLineEdit>
+#include <QLabel>
+#include <QPushButton>
 #include "archivasrpcclient.h"
+#include "blockhistorymodel.h"
 
 class BlocksPage : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit BlocksPage(ArchivasRpcClient* rpcClient, QWidget *parent = nullptr);
+    BlocksPage(ArchivasRpcClient* rpcClient, BlockHeaderCache* headerCache, QWidget *parent = nullptr);
     ~BlocksPage();
 
 private slots:
-    void onBlocksUpdated(const QList<BlockInfo>& blocks);
-    void onTableDoubleClicked(int row, int column);
+    void onTableDoubleClicked(const QModelIndex& index);
+    void onGoToHeightClicked();
+    void updateVisibleRows();
 
 private:
     void setupUi();
-    void updateTable(const QList<BlockInfo>& blocks);
 
     ArchivasRpcClient* m_rpcClient;
-    QTableWidget* m_tableWidget;
-    QTimer* m_refreshTimer;
+    BlockHeaderCache* m_headerCache;
+    BlockHistoryModel* m_model;
+    QTableView* m_tableView;
+    QLineEdit* m_heightEdit;
+    bool m_columnsSized;
 };
 
 #endif // BLOCKSPAGE_H
-
@@ -0,0 +1,95 @@
+#ifndef CHAINTABLEMODELS_H
+#define CHAINTABLEMODELS_H
+
+#include <QAbstractTableModel>
+#include <QStyledItemDelegate>
+#include <QList>
+#include <QVector>
+#include "chaintypes.h"
+
+// Blocks in ascending height, one vector per field
+struct BlockColumns
+{
+    int size() const { return heights.size(); }
+    void append(const BlockInfo& block);
+    void removeLast(int count);
+    BlockInfo at(int i) const;
+
+    QVector<quint64> heights;
+    QVector<Hash32> hashes;
+    QVector<Hash32> prevHashes;
+    QVector<Address> farmers;
+    QVector<quint32> txCounts;
+    QVector<qint64> timestamps;
+    QVector<quint64> difficulties;
+};
+
+// Transactions oldest first, one vector per field
+struct TransactionColumns
+{
+    int size() const { return hashes.size(); }
+    void append(const TransactionInfo& tx);
+    void set(int i, const TransactionInfo& tx);
+    void removeFirst(int count);
+    void removeLast(int count);
+    void clear();
+    TransactionInfo at(int i) const;
+
+    QVector<Hash32> hashes;
+    QVector<quint32> indexes;
+    QVector<Address> froms;
+    QVector<Address> tos;
+    QVector<qint64> amounts;
+    QVector<qint64> fees;
+    QVector<quint64> heights;
+    QVector<qint64> timestamps;
+};
+
+// Newest transaction first, updated by diffing each refreshed list against the
+// rows already shown. Display roles hold raw values; ChainItemDelegate formats
+// them when a cell is painted, so only rows on screen pay for it.
+class TransactionTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { HashColumn, FromColumn, ToColumn, AmountColumn, FeeColumn, HeightColumn, TimestampColumn, ColumnCount };
+
+    explicit TransactionTableModel(QObject *parent = nullptr);
+
+    // txs newest first, as the client reports them. Rows that are still
+    // listed stay in place; only new, dropped and changed rows are signalled.
+    void setTransactions(const QList<TransactionInfo>& txs);
+
+    TransactionInfo transaction(int row) const { return m_txs.at(indexOf(row)); }
+    QString displayId(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    TransactionColumns m_txs;
+
+    int indexOf(int row) const { return m_txs.size() - 1 - row; }
+    void reset(const QList<TransactionInfo>& txs);
+};
+
+// Display formatting for the chain tables
+class ChainItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    enum Format { Plain, Abbreviated, Timestamp };
+
+    explicit ChainItemDelegate(Format format, QObject *parent = nullptr);
+
+    QString displayText(const QVariant& value, const QLocale& locale) const override;
+
+private:
+    Format m_format;
+};
+
+#endif // CHAINTABLEMODELS_H
@@ -0,0 +1,88 @@
+#ifndef CHAINTYPES_H
+#define CHAINTYPES_H
+
+#include <QString>
+#include <QtGlobal>
+#include <array>
+#include <cstdint>
+
+// Block or transaction hash, held by value
+struct Hash32 {
+    std::array<quint8, 32> bytes{};
+
+    bool isNull() const;
+    QString toHex() const;
+
+    // 64 hex digits in either case; anything else gives a null hash
+    static Hash32 fromHex(const QString& hex);
+    static Hash32 fromBytes(const uint8_t* data);
+
+    bool operator==(const Hash32& other) const { return bytes == other.bytes; }
+    bool operator!=(const Hash32& other) const { return bytes != other.bytes; }
+};
+
+// Handle to an address string stored once in a process-wide table. Chain
+// records repeat the same farmer and wallet addresses, so each one carries a
+// 4-byte id instead of its own copy. Interning is thread-safe.
+class Address {
+public:
+    Address() : m_id(0) {}
+
+    static Address intern(const QString& address);
+
+    bool isEmpty() const { return m_id == 0; }
+    QString toString() const;
+    // Same for equal addresses until the process exits; usable as a hash key
+    quint32 id() const { return m_id; }
+
+    bool operator==(const Address& other) const { return m_id == other.m_id; }
+    bool operator!=(const Address& other) const { return m_id != other.m_id; }
+
+private:
+    explicit Address(quint32 id) : m_id(id) {}
+
+    quint32 m_id;  // 0 is the empty address
+};
+
+// Display helpers; records keep raw values until they are shown
+QString formatTimestamp(qint64 seconds);
+QString abbreviate(const QString& text);  // first 8 + "..." + last 8 if longer than 16
+
+struct ChainTip {
+    quint64 height = 0;
+    Hash32 hash;
+    quint64 difficulty = 0;
+    qint64 timestamp = 0;  // Unix seconds, 0 if unknown
+};
+
+struct BlockInfo {
+    quint64 height = 0;
+    Hash32 hash;
+    Hash32 prevHash;
+    Address farmer;
+    quint32 txCount = 0;
+    qint64 timestamp = 0;
+    quint64 difficulty = 0;
+};
+
+struct TransactionInfo {
+    Hash32 hash;           // Null when the source has no transaction hash
+    quint32 index = 0;     // Position within the block, when known
+    Address from;
+    Address to;
+    qint64 amount = 0;
+    qint64 fee = 0;
+    quint64 height = 0;
+    qint64 timestamp = 0;
+
+    // Hash in hex, or "height:index" when there is no hash
+    QString displayId() const;
+};
+
+struct AccountInfo {
+    Address address;
+    qint64 balance = 0;
+    quint64 nonce = 0;
+};
+
+#endif // CHAINTYPES_H
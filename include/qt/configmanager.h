@@ -12,9 +12,11 @@ struct NodeConfig {
     QString executablePath;
     QString network;
     QString rpcBind;
+    QString streamBind;  // Event stream listener of the embedded node; empty disables it
     QString dataDir;
     QString bootnodes;
     bool autoStart;
+    QString logLevel;  // Lowest level shown: DEBUG, INFO, WARN or ERROR
 };
 
 struct FarmerConfig {
@@ -23,12 +25,16 @@ struct FarmerConfig {
     QString farmerPrivkeyPath;
     QString nodeUrl;
     bool autoStart;
+    QString logLevel;  // Lowest level shown: DEBUG, INFO, WARN or ERROR
 };
 
 struct RpcConfig {
-    QString url;
-    QString fallbackUrl;
+    QStringList urls;  // Endpoints in preference order
+    QString streamUrl;  // Server-Sent Events feed of new blocks; empty disables it
     int pollIntervalMs;
+    int cacheTtlMs;  // How long identical requests are answered from the last reply
+    bool hedgeRequests;  // Send slow GETs to a second endpoint as well
+    int requestTimeoutMs;  // Deadline for a request, across retries and hedges
 };
 
 struct UiConfig {
@@ -27,12 +27,14 @@ private slots:
     void onCreatePlot();
     void onFarmerStarted();
     void onFarmerStopped();
-    void onFarmerLog(const QString &level, const QString &message);
+    void onFarmerStateChanged();
+    void onLogBatch(const QVector<LogRecord> &records);
     void updateStatus();
 
 private:
     void setupUi();
     void updateControls();
+    void launchFarmer(bool restart);
 
     ArchivasNodeManager* m_nodeManager;
     ConfigManager* m_configManager;
@@ -46,7 +48,6 @@ private:
     QLineEdit* m_plotsPathEdit;
     QLineEdit* m_farmerPrivkeyPathEdit;
     QPlainTextEdit* m_logTextEdit;
-    QTimer* m_statusTimer;
 };
 
 #endif // FARMERPAGE_H
@@ -9,6 +9,7 @@
 #include <QPushButton>
 #include <QCheckBox>
 #include <QLineEdit>
+#include <QComboBox>
 #include "archivasnodemanager.h"
 
 class LogsPage : public QWidget
@@ -18,22 +19,22 @@ class LogsPage : public QWidget
 public:
     explicit LogsPage(ArchivasNodeManager* nodeManager, QWidget *parent = nullptr);
     ~LogsPage();
-    
-    // Public methods to add logs (called from MainWindow)
-    void addNodeLog(const QString &level, const QString &message);
-    void addFarmerLog(const QString &level, const QString &message);
 
 private slots:
-    void onNodeLog(const QString &level, const QString &message);
-    void onFarmerLog(const QString &level, const QString &message);
+    void onLogBatch(const QVector<LogRecord> &records);
     void onClearNodeLogs();
     void onClearFarmerLogs();
     void onSaveNodeLogs();
     void onSaveFarmerLogs();
     void onSearchChanged(const QString& text);
+    void onNodeLogLevelChanged(const QString& level);
+    void onFarmerLogLevelChanged(const QString& level);
+    void onManagerLogLevelChanged(LogRecord::Source source, const QString& level);
 
 private:
     void setupUi();
+    void appendLogs(QPlainTextEdit* view, const QString &lines);
+    QComboBox* createLevelCombo(LogRecord::Source source, QWidget* parent);
 
     ArchivasNodeManager* m_nodeManager;
     QTabWidget* m_tabWidget;
@@ -41,6 +42,8 @@ private:
     QPlainTextEdit* m_farmerLogs;
     QLineEdit* m_searchEdit;
     QCheckBox* m_autoScrollCheck;
+    QComboBox* m_nodeLevelCombo;
+    QComboBox* m_farmerLevelCombo;
     bool m_autoScroll;
 };
 
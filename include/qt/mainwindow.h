@@ -10,7 +10,10 @@
 #include <QTimer>
 #include "archivasnodemanager.h"
 #include "archivasrpcclient.h"
+#include "blockheadercache.h"
 #include "configmanager.h"
+#include "refreshscheduler.h"
+#include "transactionindex.h"
 #include "overviewpage.h"
 #include "nodepage.h"
 #include "farmerpage.h"
@@ -33,6 +36,12 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+protected:
+    void closeEvent(QCloseEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
 private slots:
     void onPageChanged(int index);
     void onNodeStatusChanged();
@@ -40,6 +49,7 @@ private slots:
     void onChainTipUpdated(const ChainTip& tip);
     void onRpcConnected();
     void onRpcDisconnected();
+    void onSubscriptionChanged(bool live);
     void showSettings();
     void about();
 
@@ -51,6 +61,7 @@ private:
     void setupPages();
     void updateStatusBar();
     void startPolling();
+    int tipPollIntervalMs() const;
     QString extractGenesisFile(); // Extract genesis file from Qt resources
 
     // UI Components
@@ -70,13 +81,19 @@ private:
     // Core components
     ArchivasNodeManager* m_nodeManager;
     ArchivasRpcClient* m_rpcClient;
+    BlockHeaderCache* m_headerCache;
+    TransactionIndex* m_txIndex;
     ConfigManager* m_configManager;
+    RefreshScheduler* m_scheduler;
 
     // Status
-    QTimer* m_pollTimer;
+    int m_tipTask;  // Scheduler task polling the chain tip; -1 until polling starts
+    bool m_transactionsRefreshDue;  // Sent with the next tip poll, in one /batch
+    ChainTip m_lastTip;
     bool m_nodeRunning;
     bool m_farmerRunning;
     bool m_rpcConnected;
+    bool m_shutdownComplete;
 
     // Menu actions
     QAction* m_settingsAction;
@@ -26,12 +26,14 @@ private slots:
     void onRestartNode();
     void onNodeStarted();
     void onNodeStopped();
-    void onNodeLog(const QString &level, const QString &message);
+    void onNodeStateChanged();
+    void onLogBatch(const QVector<LogRecord> &records);
     void updateStatus();
 
 private:
     void setupUi();
     void updateControls();
+    void launchNode(bool restart);
     QString extractGenesisFile(); // Extract genesis file from Qt resources
 
     ArchivasNodeManager* m_nodeManager;
@@ -43,7 +45,6 @@ private:
     QLabel* m_statusLabel;
     QLabel* m_peerCountLabel;
     QPlainTextEdit* m_logTextEdit;
-    QTimer* m_statusTimer;
 };
 
 #endif // NODEPAGE_H
@@ -6,7 +6,7 @@
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QLabel>
-#include <QTimer>
+#include <QTableWidget>
 #include "archivasrpcclient.h"
 #include "archivasnodemanager.h"
 
@@ -18,6 +18,9 @@ public:
     explicit OverviewPage(ArchivasRpcClient* rpcClient, ArchivasNodeManager* nodeManager, QWidget *parent = nullptr);
     ~OverviewPage();
 
+public slots:
+    void updateEndpoints();
+
 private slots:
     void onChainTipUpdated(const ChainTip& tip);
     void onNodeStatusChanged();
@@ -42,8 +45,8 @@ private:
     QLabel* m_farmerStatusLabel;
     QLabel* m_networkLabel;
     QLabel* m_rpcStatusLabel;
+    QTableWidget* m_endpointTable;
 
-    QTimer* m_updateTimer;
     ChainTip m_currentTip;
     bool m_nodeRunning;
     bool m_farmerRunning;
@@ -0,0 +1,71 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QVector>
+#include <functional>
+
+class QTimer;
+class QWidget;
+
+// Owns every periodic and on-demand refresh in the window and runs them from a
+// single timer, armed for the next task that is due. Tasks tied to a page run
+// at their base interval while that page is showing and back off
+// exponentially while it is not. Nothing runs while the window is minimized or
+// hidden to the tray.
+class RefreshScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RefreshScheduler(QObject *parent = nullptr);
+
+    // page is the widget whose results the task refreshes, or nullptr for a
+    // task that matters whenever the window is showing. intervalMs 0 makes an
+    // on-demand task that runs only after requestRun().
+    int addTask(QWidget* page, int intervalMs, std::function<void()> run);
+    void setInterval(int task, int intervalMs);
+
+    // Run the task on the next pass of the event loop; requests made before
+    // then share one run. A task whose page is hidden runs when it is shown.
+    void requestRun(int task);
+
+    // The task's last result matched the previous one: double its interval
+    void backOff(int task);
+    // Something changed: every task returns to its base interval
+    void snap();
+
+    void setCurrentPage(QWidget* page);
+    void setPaused(bool paused);
+
+    // Timer wakeups during the last minute
+    int wakeupsPerMinute();
+
+private slots:
+    void onTimeout();
+
+private:
+    struct Task {
+        QWidget* page = nullptr;
+        int intervalMs = 0;
+        int backoff = 0;      // Doublings applied to intervalMs
+        qint64 dueMs = -1;    // On m_clock; -1 while not scheduled
+        bool pending = false; // Requested while its page was hidden
+        std::function<void()> run;
+    };
+    QVector<Task> m_tasks;
+    QWidget* m_currentPage;
+    bool m_paused;
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    QQueue<qint64> m_wakeups;
+
+    bool isShowing(const Task& task) const;
+    qint64 effectiveIntervalMs(const Task& task) const;
+    void reschedule(Task& task);
+    void rearm();
+};
+
+#endif // REFRESHSCHEDULER_H
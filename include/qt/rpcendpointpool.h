@@ -0,0 +1,68 @@
+#ifndef RPCENDPOINTPOOL_H
+#define RPCENDPOINTPOOL_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QNetworkAccessManager;
+
+// Health and latency of one RPC endpoint
+struct RpcEndpointStats {
+    QString url;
+    bool healthy = true;
+    double latencyMs = 0;       // EWMA over successful requests
+    double errorRate = 0;       // EWMA of failures, 0..1
+    int consecutiveFailures = 0;
+    quint64 requests = 0;
+    quint64 failures = 0;
+    QVector<quint64> histogram; // Successes per RpcEndpointPool::latencyBucketBounds() bucket
+};
+
+// Ranks the configured RPC endpoints by latency and error rate. Endpoints are
+// demoted after repeated failures and promoted again once a health probe
+// succeeds, so a local node that comes back is preferred again.
+class RpcEndpointPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RpcEndpointPool(QObject *parent = nullptr);
+
+    // Endpoints in preference order; earlier ones win while scores are equal
+    void setUrls(const QStringList& urls);
+    QStringList urls() const;
+
+    // Best endpoint not in exclude: healthy ones first, then lowest score.
+    // Empty when every endpoint is excluded.
+    QString pick(const QStringList& exclude = QStringList()) const;
+
+    void recordSuccess(const QString& url, qint64 latencyMs);
+    void recordFailure(const QString& url);
+
+    // Latency under which 95% of successful requests to url completed
+    int p95LatencyMs(const QString& url) const;
+
+    QVector<RpcEndpointStats> stats() const { return m_endpoints; }
+
+    // Upper bounds of the histogram buckets in ms; the last bucket is open-ended
+    static const QVector<int>& latencyBucketBounds();
+
+public slots:
+    // Ask every endpoint for its chain tip. Run periodically by the owner so
+    // demoted endpoints get a chance to come back.
+    void probe();
+
+signals:
+    void statsChanged();
+
+private:
+    QVector<RpcEndpointStats> m_endpoints;
+    QNetworkAccessManager* m_probeManager;
+
+    int indexOf(const QString& url) const;
+    static double score(const RpcEndpointStats& endpoint);
+};
+
+#endif // RPCENDPOINTPOOL_H
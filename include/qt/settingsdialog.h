@@ -6,7 +6,9 @@
 #include <QHBoxLayout>
 #include <QTabWidget>
 #include <QLineEdit>
+#include <QPlainTextEdit>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QLabel>
 #include <QPushButton>
 #include <QGroupBox>
@@ -40,9 +42,11 @@ private:
     QLineEdit* m_nodeExecutableEdit;
     QLineEdit* m_nodeNetworkEdit;
     QLineEdit* m_nodeRpcBindEdit;
+    QLineEdit* m_nodeStreamBindEdit;
     QLineEdit* m_nodeDataDirEdit;
     QLineEdit* m_nodeBootnodesEdit;
     QCheckBox* m_nodeAutoStartCheck;
+    QComboBox* m_nodeLogLevelCombo;
 
     // Farmer settings
     QLineEdit* m_farmerExecutableEdit;
@@ -50,11 +54,15 @@ private:
     QLineEdit* m_farmerPrivkeyPathEdit;
     QLineEdit* m_farmerNodeUrlEdit;
     QCheckBox* m_farmerAutoStartCheck;
+    QComboBox* m_farmerLogLevelCombo;
 
     // RPC settings
-    QLineEdit* m_rpcUrlEdit;
-    QLineEdit* m_rpcFallbackUrlEdit;
+    QPlainTextEdit* m_rpcUrlsEdit;
+    QLineEdit* m_rpcStreamUrlEdit;
     QLineEdit* m_rpcPollIntervalEdit;
+    QLineEdit* m_rpcCacheTtlEdit;
+    QCheckBox* m_rpcHedgeCheck;
+    QLineEdit* m_rpcTimeoutEdit;
 
     // UI settings
     QLineEdit* m_uiThemeEdit;
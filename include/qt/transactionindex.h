@@ -0,0 +1,111 @@
+#ifndef TRANSACTIONINDEX_H
+#define TRANSACTIONINDEX_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include "archivasrpcclient.h"
+
+class QThreadPool;
+
+// Ranges a transaction has to fall in, bounds inclusive. The defaults let
+// everything through.
+struct TransactionFilter {
+    qint64 minAmount = std::numeric_limits<qint64>::min();
+    qint64 maxAmount = std::numeric_limits<qint64>::max();
+    qint64 minFee = std::numeric_limits<qint64>::min();
+    qint64 maxFee = std::numeric_limits<qint64>::max();
+    quint64 minHeight = 0;
+    quint64 maxHeight = std::numeric_limits<quint64>::max();
+    qint64 fromTime = std::numeric_limits<qint64>::min();  // Unix seconds
+    qint64 toTime = std::numeric_limits<qint64>::max();
+
+    bool isEmpty() const;
+};
+
+// Count and totals over every match, not only the rows sent back
+struct TransactionSummary {
+    int count = 0;
+    qint64 totalAmount = 0;
+    qint64 totalFee = 0;
+};
+
+// Search over every transaction on the chain. Transactions are found by
+// position ("height:index"), by hash when they have one, and by address
+// through per-address posting lists; sorted address and hash keys answer
+// prefixes as the user types. Amount, fee, height and time ranges are
+// checked against the stored columns, and the active search keeps its
+// totals current as blocks are indexed. The index lives on a worker thread,
+// is built from /blocks/range pages up to the tip and kept on disk, so after
+// a restart only blocks above the saved height are fetched, once the newest
+// indexed blocks have been checked against the node's chain.
+class TransactionIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TransactionIndex(ArchivasRpcClient* rpcClient, QObject *parent = nullptr);
+    ~TransactionIndex();
+
+    // Loads the index under dir in the background, creating it if needed
+    void open(const QString& dir);
+    void close();
+
+    bool isReady() const { return m_ready; }
+    // Blocks below this height are indexed
+    quint64 indexedHeight() const { return m_indexedHeight; }
+
+    // Matches of text within filter, newest first and at most limit of
+    // them, through searchFinished; empty text matches every transaction.
+    // A search still queued when the next one arrives is dropped, and the
+    // latest one is answered again whenever new blocks add matches.
+    void search(const QString& text, const TransactionFilter& filter, int limit);
+    void clearSearch();
+
+signals:
+    void searchFinished(const QString& text, const QList<TransactionInfo>& txs, const TransactionSummary& summary);
+    void indexedHeightChanged(quint64 height);
+
+private slots:
+    void onChainTipUpdated(const ChainTip& tip);
+    void onReorgDetected(quint64 fromHeight);
+    void onSourceChanged();
+    void onBlockPageLoaded(quint64 from, const QList<BlockInfo>& blocks, const QList<TransactionInfo>& txs);
+    void requestNext();
+
+private:
+    struct Store;
+    struct Query;
+
+    ArchivasRpcClient* m_rpcClient;
+    // One thread, so loads, updates and searches run in order without locks
+    QThreadPool* m_worker;
+    std::shared_ptr<Store> m_store;
+    std::shared_ptr<Query> m_query;  // The latest search; only the worker touches its fields
+    std::atomic<quint64> m_latestSearch;
+
+    bool m_ready;
+    quint64 m_indexedHeight;
+    bool m_hasTip;
+    quint64 m_tipHeight;
+    bool m_verified;  // The newest indexed blocks matched the node's chain
+
+    bool m_requestPending;
+    quint64 m_requestFrom;
+    QElapsedTimer m_requestTimer;
+
+    void truncate(quint64 height);
+    void setIndexedHeight(quint64 height);
+    // On the worker: brings query up to date with store and sends it if it changed
+    void refresh(const std::shared_ptr<Store>& store, const std::shared_ptr<Query>& query);
+    void post(const std::shared_ptr<Query>& query);
+
+    // Feeds pages straight to the store, without the backfill's pacing (tests/)
+    friend class IndexBenchmark;
+};
+
+#endif // TRANSACTIONINDEX_H
@@ -4,35 +4,69 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QTableWidget>
+#include <QTableView>
 #include <QLineEdit>
 #include <QLabel>
 #include <QPushButton>
-#include <QTimer>
 #include "archivasrpcclient.h"
+#include "chaintablemodels.h"
+#include "transactionindex.h"
 
 class TransactionsPage : public QWidget
 {
     Q_OBJECT
 
 public:
-    explicit TransactionsPage(ArchivasRpcClient* rpcClient, QWidget *parent = nullptr);
+    explicit TransactionsPage(ArchivasRpcClient* rpcClient, TransactionIndex* txIndex, QWidget *parent = nullptr);
     ~TransactionsPage();
 
+    // Adds the most recent transactions to batch; they arrive through the
+    // client's transactionsUpdated like a plain refresh
+    void addRefreshTo(RpcBatch& batch);
+
+public slots:
+    // Fetch the most recent transactions
+    void refresh();
+
 private slots:
     void onTransactionsUpdated(const QList<TransactionInfo>& txs);
-    void onTableDoubleClicked(int row, int column);
-    void onFilterClicked();
+    void onMempoolTransactionAdded(const TransactionInfo& tx);
+    void onTableDoubleClicked(const QModelIndex& index);
+    void onSearchFinished(const QString& text, const QList<TransactionInfo>& txs, const TransactionSummary& summary);
+    void runSearch();
+    void updateStatus();
 
 private:
+    enum FilterKind { AmountFilter, FeeFilter, HeightFilter, TimeFilter };
+
     void setupUi();
-    void updateTable(const QList<TransactionInfo>& txs);
+
+    void showTransactions(const QList<TransactionInfo>& txs);
+    // Pending transactions above the recent ones
+    QList<TransactionInfo> recentRows() const;
+    bool isMined(const TransactionInfo& pending) const;
+    void editFilter(FilterKind kind);
+    bool editRange(const QString& title, QString* min, QString* max);
+    bool editTimeWindow();
+    void removeFilter(FilterKind kind);
+    void updateChips();
+    void updateSummary();
 
     ArchivasRpcClient* m_rpcClient;
-    QTableWidget* m_tableWidget;
-    QLineEdit* m_filterEdit;
-    QTimer* m_refreshTimer;
-    QList<TransactionInfo> m_allTransactions;
+    TransactionIndex* m_txIndex;
+    TransactionTableModel* m_model;
+    QTableView* m_tableView;
+    QLineEdit* m_searchEdit;
+    QPushButton* m_addFilterButton;
+    QHBoxLayout* m_chipLayout;        // One removable chip per active range
+    QLabel* m_statusLabel;
+    QLabel* m_summaryLabel;
+    QList<TransactionInfo> m_recent;  // Shown while there is no search or filter
+    QList<TransactionInfo> m_pending; // Mempool transactions not yet in m_recent, newest first
+    TransactionFilter m_filter;
+    bool m_searching;                 // Rows come from the index rather than m_recent
+    TransactionSummary m_summary;
+    bool m_columnsSized;
 };
 
 #endif // TRANSACTIONSPAGE_H
@@ -0,0 +1,122 @@
+package main
+
+import (
+	"encoding/json"
+	"net/http"
+)
+
+// Upper bounds on what one /batch request may ask for
+const (
+	batchMaxBlocks   = 100
+	batchMaxTxs      = 500
+	batchMaxAccounts = 100
+)
+
+// batchRequest selects the queries answered by POST /batch. Zero values skip
+// a query.
+type batchRequest struct {
+	ChainTip     bool     `json:"chainTip"`
+	RecentBlocks int      `json:"recentBlocks"`
+	RecentTxs    int      `json:"recentTxs"`
+	Accounts     []string `json:"accounts"`
+}
+
+type batchTx struct {
+	From      string `json:"from"`
+	To        string `json:"to"`
+	Amount    int64  `json:"amount"`
+	Fee       int64  `json:"fee"`
+	Nonce     uint64 `json:"nonce"`
+	Height    uint64 `json:"height"`
+	Timestamp int64  `json:"timestamp"`
+}
+
+type batchAccount struct {
+	Address string `json:"address"`
+	Balance int64  `json:"balance"`
+	Nonce   uint64 `json:"nonce"`
+}
+
+// batchResponse has one member per query asked for, each shaped like the
+// reply of the matching single-resource endpoint
+type batchResponse struct {
+	ChainTip     *tipSummary    `json:"chainTip,omitempty"`
+	RecentBlocks []blockSummary `json:"recentBlocks,omitempty"`
+	RecentTxs    []batchTx      `json:"recentTxs,omitempty"`
+	Accounts     []batchAccount `json:"accounts,omitempty"`
+}
+
+// serveBatch answers several read-only queries from one consistent view of
+// the chain, saving a client one round trip per query
+func serveBatch(w http.ResponseWriter, r *http.Request) {
+	if r.Method != http.MethodPost {
+		http.Error(w, "POST required", http.StatusMethodNotAllowed)
+		return
+	}
+	var req batchRequest
+	if err := json.NewDecoder(http.MaxBytesReader(w, r.Body, 64<<10)).Decode(&req); err != nil {
+		http.Error(w, "invalid batch request", http.StatusBadRequest)
+		return
+	}
+	ns := runningNodeState()
+	if ns == nil {
+		http.Error(w, "node not running", http.StatusServiceUnavailable)
+		return
+	}
+
+	var resp batchResponse
+	ns.RLock()
+	if req.ChainTip {
+		// Built from the chain under the same lock, so the tip always matches
+		// the blocks and transactions in this reply
+		tip := summarizeTipLocked(ns)
+		resp.ChainTip = &tip
+	}
+	if limit := clampLimit(req.RecentBlocks, batchMaxBlocks); limit > 0 {
+		from := 0
+		if len(ns.Chain) > limit {
+			from = len(ns.Chain) - limit
+		}
+		resp.RecentBlocks = make([]blockSummary, 0, len(ns.Chain)-from)
+		for i := from; i < len(ns.Chain); i++ {
+			resp.RecentBlocks = append(resp.RecentBlocks, summarizeBlock(&ns.Chain[i]))
+		}
+	}
+	if limit := clampLimit(req.RecentTxs, batchMaxTxs); limit > 0 {
+		resp.RecentTxs = make([]batchTx, 0, limit)
+		for i := len(ns.Chain) - 1; i >= 0 && len(resp.RecentTxs) < limit; i-- {
+			b := &ns.Chain[i]
+			for j := len(b.Txs) - 1; j >= 0 && len(resp.RecentTxs) < limit; j-- {
+				tx := &b.Txs[j]
+				resp.RecentTxs = append(resp.RecentTxs, batchTx{
+					From: tx.From, To: tx.To, Amount: tx.Amount, Fee: tx.Fee, Nonce: tx.Nonce,
+					Height: b.Height, Timestamp: b.TimestampUnix,
+				})
+			}
+		}
+	}
+	if ns.WorldState != nil {
+		for i, addr := range req.Accounts {
+			if i == batchMaxAccounts {
+				break
+			}
+			account := batchAccount{Address: addr}
+			if state := ns.WorldState.Accounts[addr]; state != nil {
+				account.Balance = state.Balance
+				account.Nonce = state.Nonce
+			}
+			resp.Accounts = append(resp.Accounts, account)
+		}
+	}
+	ns.RUnlock()
+
+	w.Header().Set("Content-Type", "application/json")
+	json.NewEncoder(w).Encode(&resp)
+}
+
+func clampLimit(limit, max int) int {
+	if limit > max {
+		return max
+	}
+	return limit
+}
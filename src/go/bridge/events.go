@@ -0,0 +1,238 @@
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}
+#include "events.h"
+*/
+import "C"
+import (
+	"sync"
+	"sync/atomic"
+	"syscall"
+	"time"
+	"unsafe"
+)
+
+// eventRingSize is the number of events buffered between drains (power of two)
+const eventRingSize = 1024
+
+// Event ring shared with the GUI. Goroutines serialize through
+// eventProducerMutex so the ring itself stays single-producer/single-consumer;
+// the consumer is whichever thread calls archivas_events_drain.
+var (
+	eventRing          [eventRingSize]C.archivas_event
+	eventHead          atomic.Uint64 // Next slot to write
+	eventTail          atomic.Uint64 // Next slot to read
+	eventProducerMutex sync.Mutex
+	eventSequence      atomic.Uint64
+	eventDropped       atomic.Uint64
+
+	// Tip changes are coalesced: block application only marks the tip dirty and
+	// the drain reports the latest published tip once, so IBD cannot flood the ring
+	eventTipDirty atomic.Bool
+
+	eventNotifyFd      atomic.Int32
+	eventNotifyMutex   sync.RWMutex // Writers hold it shared; swapping the fd takes it exclusively
+	eventNotifyPending atomic.Bool
+)
+
+func init() {
+	eventNotifyFd.Store(-1)
+}
+
+// writeNotifyByte wakes the GUI through the notify pipe unless pending shows
+// a wakeup is already outstanding. Shared by the event ring and the log arena.
+func writeNotifyByte(pending *atomic.Bool) {
+	if eventNotifyFd.Load() < 0 || !pending.CompareAndSwap(false, true) {
+		return
+	}
+	// The fd is re-read under the lock so archivas_events_set_notify_fd can
+	// wait out a write in flight before the GUI closes the pipe
+	eventNotifyMutex.RLock()
+	defer eventNotifyMutex.RUnlock()
+	if fd := eventNotifyFd.Load(); fd >= 0 {
+		// A full pipe already guarantees a wakeup, so EAGAIN is fine to ignore
+		syscall.Write(int(fd), []byte{1})
+	}
+}
+
+// notifyEventConsumer wakes the consumer unless a wakeup is already pending
+func notifyEventConsumer() {
+	writeNotifyByte(&eventNotifyPending)
+}
+
+// pushEvent appends ev to the ring, counting it as dropped if the ring is full
+func pushEvent(ev C.archivas_event) {
+	ev.timestamp_ns = C.int64_t(time.Now().UnixNano())
+
+	eventProducerMutex.Lock()
+	head := eventHead.Load()
+	if head-eventTail.Load() >= eventRingSize {
+		eventProducerMutex.Unlock()
+		eventDropped.Add(1)
+		notifyEventConsumer()
+		return
+	}
+	ev.sequence = C.uint64_t(eventSequence.Add(1))
+	eventRing[head%eventRingSize] = ev
+	eventHead.Store(head + 1)
+	eventProducerMutex.Unlock()
+
+	notifyEventConsumer()
+}
+
+// setEventText copies s into ev.text, truncating and NUL-terminating it
+func setEventText(ev *C.archivas_event, s string) {
+	setCString(ev.text[:], s)
+}
+
+// markTipChanged records that the published tip changed since the last drain
+func markTipChanged() {
+	if eventTipDirty.CompareAndSwap(false, true) {
+		notifyEventConsumer()
+	}
+	notifyStreamClients()
+}
+
+// tipChangedEvent builds a TIP_CHANGED event from the currently published tip
+func tipChangedEvent() C.archivas_event {
+	var ev C.archivas_event
+	ev._type = C.ARCHIVAS_EVENT_TIP_CHANGED
+	ev.sequence = C.uint64_t(eventSequence.Add(1))
+	ev.timestamp_ns = C.int64_t(time.Now().UnixNano())
+	if tip := publishedTip.Load(); tip != nil {
+		height, difficulty, hash := tip.status()
+		ev.arg0 = C.uint64_t(height)
+		ev.arg1 = C.uint64_t(difficulty)
+		for i, b := range hash {
+			ev.hash[i] = C.uint8_t(b)
+		}
+	}
+	return ev
+}
+
+// emitPeerEvent reports a peer connecting or disconnecting
+func emitPeerEvent(connected bool, addr string, peerCount int) {
+	var ev C.archivas_event
+	ev._type = C.ARCHIVAS_EVENT_PEER_DISCONNECTED
+	if connected {
+		ev._type = C.ARCHIVAS_EVENT_PEER_CONNECTED
+	}
+	ev.arg0 = C.uint64_t(peerCount)
+	setEventText(&ev, addr)
+	pushEvent(ev)
+}
+
+// emitSyncStage reports an IBD stage change
+func emitSyncStage(stage int, height, targetHeight uint64) {
+	var ev C.archivas_event
+	ev._type = C.ARCHIVAS_EVENT_SYNC_STAGE
+	ev.code = C.int32_t(stage)
+	ev.arg0 = C.uint64_t(height)
+	ev.arg1 = C.uint64_t(targetHeight)
+	pushEvent(ev)
+}
+
+// emitProofFound reports a winning proof found by the farmer
+func emitProofFound(quality, height uint64, hash [32]byte) {
+	var ev C.archivas_event
+	ev._type = C.ARCHIVAS_EVENT_PROOF_FOUND
+	ev.arg0 = C.uint64_t(quality)
+	ev.arg1 = C.uint64_t(height)
+	for i, b := range hash {
+		ev.hash[i] = C.uint8_t(b)
+	}
+	pushEvent(ev)
+}
+
+// emitPlotLoaded reports a plot file opened by the farmer
+func emitPlotLoaded(loaded int, kSize uint64, name string) {
+	var ev C.archivas_event
+	ev._type = C.ARCHIVAS_EVENT_PLOT_LOADED
+	ev.arg0 = C.uint64_t(loaded)
+	ev.arg1 = C.uint64_t(kSize)
+	setEventText(&ev, name)
+	pushEvent(ev)
+}
+
+// emitServiceState reports a node or farmer lifecycle change (ARCHIVAS_SERVICE_*)
+func emitServiceState(eventType C.uint32_t, state C.int) {
+	var ev C.archivas_event
+	ev._type = eventType
+	ev.code = C.int32_t(state)
+	pushEvent(ev)
+}
+
+func emitNodeState(state C.int) {
+	emitServiceState(C.ARCHIVAS_EVENT_NODE_STATE, state)
+}
+
+func emitFarmerState(state C.int) {
+	emitServiceState(C.ARCHIVAS_EVENT_FARMER_STATE, state)
+}
+
+// waitDone waits up to timeoutMs (negative waits forever) for a service
+// goroutine to finish. Returns 1 if it has finished (or never ran), 0 on timeout.
+func waitDone(done chan struct{}, timeoutMs C.int) C.int {
+	if done == nil {
+		return 1
+	}
+	if timeoutMs < 0 {
+		<-done
+		return 1
+	}
+	timer := time.NewTimer(time.Duration(timeoutMs) * time.Millisecond)
+	defer timer.Stop()
+	select {
+	case <-done:
+		return 1
+	case <-timer.C:
+		return 0
+	}
+}
+
+//export archivas_events_set_notify_fd
+func archivas_events_set_notify_fd(fd C.int) {
+	eventNotifyMutex.Lock()
+	eventNotifyFd.Store(int32(fd))
+	eventNotifyMutex.Unlock()
+	eventNotifyPending.Store(false)
+	logNotifyPending.Store(false)
+	if fd >= 0 && (eventHead.Load() != eventTail.Load() || eventTipDirty.Load()) {
+		notifyEventConsumer()
+	}
+	if fd >= 0 && logHead.Load() != logTail.Load() {
+		notifyLogConsumer()
+	}
+}
+
+//export archivas_events_drain
+func archivas_events_drain(out *C.archivas_event, max C.int, dropped *C.uint64_t) C.int {
+	if dropped != nil {
+		*dropped = C.uint64_t(eventDropped.Swap(0))
+	}
+	if out == nil || max <= 0 {
+		return 0
+	}
+
+	// Clear the pending flag before reading so a push racing with this drain
+	// writes a fresh wakeup instead of being missed
+	eventNotifyPending.Store(false)
+
+	dst := unsafe.Slice(out, int(max))
+	n := 0
+	tail := eventTail.Load()
+	head := eventHead.Load()
+	for tail != head && n < len(dst) {
+		dst[n] = eventRing[tail%eventRingSize]
+		tail++
+		n++
+	}
+	eventTail.Store(tail)
+
+	if n < len(dst) && eventTipDirty.Swap(false) {
+		dst[n] = tipChangedEvent()
+		n++
+	}
+	return C.int(n)
+}
@@ -0,0 +1,61 @@
+#ifndef ARCHIVAS_EVENTS_BRIDGE_H
+#define ARCHIVAS_EVENTS_BRIDGE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Event types
+#define ARCHIVAS_EVENT_TIP_CHANGED       1  // arg0 = height, arg1 = difficulty, hash = tip hash
+#define ARCHIVAS_EVENT_PEER_CONNECTED    2  // arg0 = peer count, text = peer address
+#define ARCHIVAS_EVENT_PEER_DISCONNECTED 3  // arg0 = peer count, text = peer address
+#define ARCHIVAS_EVENT_SYNC_STAGE        4  // code = ARCHIVAS_SYNC_*, arg0 = height, arg1 = target height
+#define ARCHIVAS_EVENT_PROOF_FOUND       5  // arg0 = quality, arg1 = challenge height, hash = proof hash
+#define ARCHIVAS_EVENT_PLOT_LOADED       6  // arg0 = plots loaded so far, arg1 = k size, text = plot file name
+#define ARCHIVAS_EVENT_NODE_STATE        7  // code = ARCHIVAS_SERVICE_*
+#define ARCHIVAS_EVENT_FARMER_STATE      8  // code = ARCHIVAS_SERVICE_*
+
+// Node/farmer lifecycle states. Start moves STOPPED or FAILED to STARTING,
+// which becomes RUNNING once initialization succeeds or FAILED if it does not.
+// Stop moves STARTING or RUNNING to STOPPING, then STOPPED after teardown.
+#define ARCHIVAS_SERVICE_STOPPED  0
+#define ARCHIVAS_SERVICE_STARTING 1
+#define ARCHIVAS_SERVICE_RUNNING  2
+#define ARCHIVAS_SERVICE_STOPPING 3
+#define ARCHIVAS_SERVICE_FAILED   4
+
+// IBD stages (ARCHIVAS_EVENT_SYNC_STAGE code)
+#define ARCHIVAS_SYNC_IDLE     0
+#define ARCHIVAS_SYNC_RUNNING  1
+#define ARCHIVAS_SYNC_COMPLETE 2
+#define ARCHIVAS_SYNC_FAILED   3
+
+typedef struct archivas_event {
+    uint32_t type;          // ARCHIVAS_EVENT_*
+    int32_t  code;
+    uint64_t sequence;      // Increases by one per event
+    int64_t  timestamp_ns;  // Unix nanoseconds
+    uint64_t arg0;
+    uint64_t arg1;
+    uint8_t  hash[32];
+    char     text[64];      // NUL-terminated, truncated if longer
+} archivas_event;
+
+// Register the write end of a non-blocking pipe; one byte is written to it
+// when events (or log records, see logs.h) become available after the last
+// drain. Pass -1 to disable. Once the call returns no write to the previous
+// fd is in progress or will start, so the caller may close it.
+void archivas_events_set_notify_fd(int fd);
+
+// Copies up to max pending events into out and returns how many were copied.
+// Call again while the return value equals max. If dropped is not NULL it
+// receives the number of events lost to a full ring since the last drain.
+int archivas_events_drain(archivas_event* out, int max, uint64_t* dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARCHIVAS_EVENTS_BRIDGE_H
@@ -4,6 +4,8 @@ package main
 #cgo CFLAGS: -I${SRCDIR}
 #include <stdlib.h>
 #include "farmer.h"
+#include "logs.h"
+#include "events.h"
 
 // Helper function to call the callback (needed because cgo can't call function pointers directly)
 static void call_farmer_log_callback(farmer_log_callback_t cb, char* level, char* message) {
@@ -61,18 +63,28 @@ type ChallengeInfo struct {
 
 // Global state
 var (
-	farmerRunning     bool
+	farmerRunning     bool // True from start until teardown has finished
 	farmerMutex       sync.RWMutex
-	farmerContext     context.Context
 	farmerCancel      context.CancelFunc
+	farmerService     C.int         // ARCHIVAS_SERVICE_*, guarded by farmerMutex
+	farmerDone        chan struct{} // Closed when the farmer goroutine has finished
 	farmerState       *FarmerState
 	farmerStateMutex  sync.RWMutex
 	farmerLogCallback C.farmer_log_callback_t
 	farmerLogCallbackMutex sync.RWMutex
 )
 
-// callFarmerLogCallback safely calls the C callback function
+// callFarmerLogCallback drops levels below the farmer threshold, then writes to
+// the log arena when the GUI has enabled it, otherwise it safely calls the C
+// callback function
 func callFarmerLogCallback(level, message string) {
+	if !logEnabled(C.ARCHIVAS_LOG_SOURCE_FARMER, logLevelCode(level)) {
+		return
+	}
+	if appendLogRecord(C.ARCHIVAS_LOG_SOURCE_FARMER, level, message) {
+		return
+	}
+
 	farmerLogCallbackMutex.RLock()
 	cb := farmerLogCallback
 	farmerLogCallbackMutex.RUnlock()
@@ -162,6 +174,7 @@ func loadPlots(dir string) ([]*pospace.PlotFile, error) {
 		}
 
 		plots = append(plots, plot)
+		emitPlotLoaded(len(plots), uint64(plot.Header.KSize), f.Name())
 	}
 
 	return plots, nil
@@ -228,8 +241,9 @@ func submitBlock(nodeURL string, proof *pospace.Proof, farmerAddr string, farmer
 	return nil
 }
 
-// startArchivasFarmer starts the Archivas farmer
-func startArchivasFarmer(ctx context.Context, nodeURL, plotsPath, farmerPrivkeyPath string) error {
+// startArchivasFarmer starts the Archivas farmer, calls ready once its state
+// is set up, and runs the farming loop until ctx is cancelled
+func startArchivasFarmer(ctx context.Context, nodeURL, plotsPath, farmerPrivkeyPath string, ready func()) error {
 	callFarmerLogCallback("INFO", "Initializing Archivas farmer...")
 
 	// Ensure plots directory exists
@@ -274,6 +288,7 @@ func startArchivasFarmer(ctx context.Context, nodeURL, plotsPath, farmerPrivkeyP
 	farmerStateMutex.Unlock()
 
 	callFarmerLogCallback("INFO", "Starting farming loop...")
+	ready()
 
 	// Farming loop
 	ticker := time.NewTicker(2 * time.Second)
@@ -356,6 +371,7 @@ func startArchivasFarmer(ctx context.Context, nodeURL, plotsPath, farmerPrivkeyP
 				farmerState.LastProof = bestProof
 				farmerState.LastProofTime = time.Now()
 				farmerStateMutex.Unlock()
+				emitProofFound(bestProof.Quality, challengeInfo.Height, bestProof.Hash)
 
 				// Submit block
 				if err := submitBlock(nodeURL, bestProof, farmerAddr, farmerPubKey, privKey, challengeInfo); err != nil {
@@ -377,7 +393,7 @@ func startArchivasFarmer(ctx context.Context, nodeURL, plotsPath, farmerPrivkeyP
 				if bestProof != nil {
 					bestQ = bestProof.Quality
 				}
-				callFarmerLogCallback("DEBUG", fmt.Sprintf("Checking plots... best=%d, need=<%d", bestQ, challengeInfo.Difficulty))
+				farmerLogf("DEBUG", "Checking plots... best=%d, need=<%d", bestQ, challengeInfo.Difficulty)
 			}
 		}
 	}
@@ -389,7 +405,7 @@ func archivas_farmer_start(nodeURL, plotsPath, farmerPrivkey *C.char) C.int {
 	defer farmerMutex.Unlock()
 
 	if farmerRunning {
-		return 1 // Already running
+		return 1 // Already running (or still stopping)
 	}
 
 	// Parse C strings to Go strings
@@ -398,35 +414,52 @@ func archivas_farmer_start(nodeURL, plotsPath, farmerPrivkey *C.char) C.int {
 	farmerPrivkeyPathStr := C.GoString(farmerPrivkey)
 
 	// Create context for cancellation
-	farmerContext, farmerCancel = context.WithCancel(context.Background())
-
-	// Start farmer in goroutine (non-blocking)
+	ctx, cancel := context.WithCancel(context.Background())
+	farmerCancel = cancel
+	done := make(chan struct{})
+	farmerDone = done
+	farmerRunning = true
+	setFarmerService(C.ARCHIVAS_SERVICE_STARTING)
+
+	// Start farmer in goroutine (non-blocking); state changes go out as events
 	go func() {
-		farmerMutex.Lock()
-		farmerRunning = true
-		farmerMutex.Unlock()
+		defer close(done)
 
 		callFarmerLogCallback("INFO", fmt.Sprintf("Starting Archivas farmer: node_url=%s, plots_path=%s", nodeURLStr, plotsPathStr))
 
-		// Initialize farmer
-		err := startArchivasFarmer(farmerContext, nodeURLStr, plotsPathStr, farmerPrivkeyPathStr)
+		// Running once plots and keys are loaded; the call below then stays
+		// in the farming loop until ctx is cancelled
+		ready := func() {
+			farmerMutex.Lock()
+			if farmerService == C.ARCHIVAS_SERVICE_STARTING {
+				setFarmerService(C.ARCHIVAS_SERVICE_RUNNING)
+			}
+			farmerMutex.Unlock()
+		}
+
+		err := startArchivasFarmer(ctx, nodeURLStr, plotsPathStr, farmerPrivkeyPathStr, ready)
 		if err != nil {
 			callFarmerLogCallback("ERROR", fmt.Sprintf("Failed to start farmer: %v", err))
 			farmerMutex.Lock()
 			farmerRunning = false
+			if ctx.Err() != nil {
+				// Stopped while starting
+				setFarmerService(C.ARCHIVAS_SERVICE_STOPPED)
+			} else {
+				setFarmerService(C.ARCHIVAS_SERVICE_FAILED)
+			}
 			farmerMutex.Unlock()
+			cancel()
 			return
 		}
 
-		// Wait for cancellation
-		<-farmerContext.Done()
-
 		// Cleanup
 		stopArchivasFarmer()
+		callFarmerLogCallback("INFO", "Archivas farmer stopped")
 		farmerMutex.Lock()
 		farmerRunning = false
+		setFarmerService(C.ARCHIVAS_SERVICE_STOPPED)
 		farmerMutex.Unlock()
-		callFarmerLogCallback("INFO", "Archivas farmer stopped")
 	}()
 
 	return 0 // Success
@@ -454,22 +487,45 @@ func stopArchivasFarmer() {
 	callFarmerLogCallback("INFO", "Archivas farmer stopped and cleaned up")
 }
 
+// setFarmerService records and reports a farmer lifecycle change. Caller must hold farmerMutex.
+func setFarmerService(state C.int) {
+	if farmerService != state {
+		farmerService = state
+		emitFarmerState(state)
+	}
+}
+
 //export archivas_farmer_stop
 func archivas_farmer_stop() {
 	farmerMutex.Lock()
 	defer farmerMutex.Unlock()
 
-	if !farmerRunning {
+	if farmerService != C.ARCHIVAS_SERVICE_STARTING && farmerService != C.ARCHIVAS_SERVICE_RUNNING {
 		return
 	}
 
 	callFarmerLogCallback("INFO", "Stopping Archivas farmer...")
+	setFarmerService(C.ARCHIVAS_SERVICE_STOPPING)
 
+	// Teardown happens on the farmer goroutine, which reports STOPPED when done
 	if farmerCancel != nil {
 		farmerCancel()
 	}
+}
 
-	farmerRunning = false
+//export archivas_farmer_get_state
+func archivas_farmer_get_state() C.int {
+	farmerMutex.RLock()
+	defer farmerMutex.RUnlock()
+	return farmerService
+}
+
+//export archivas_farmer_wait_stopped
+func archivas_farmer_wait_stopped(timeoutMs C.int) C.int {
+	farmerMutex.RLock()
+	done := farmerDone
+	farmerMutex.RUnlock()
+	return waitDone(done, timeoutMs)
 }
 
 //export archivas_farmer_is_running
@@ -494,18 +550,55 @@ func archivas_farmer_get_plot_count() C.int {
 	return C.int(len(farmerState.Plots))
 }
 
-//export archivas_farmer_get_last_proof
-func archivas_farmer_get_last_proof() *C.char {
+// appendLastProof appends "Quality: <q>, Hash: <first 8 bytes hex>" for the last
+// proof to dst, or nothing if the farmer has not found one yet
+func appendLastProof(dst []byte) []byte {
 	farmerStateMutex.RLock()
 	defer farmerStateMutex.RUnlock()
 
 	if farmerState == nil || farmerState.LastProof == nil {
-		return C.CString("")
+		return dst
 	}
 
-	// Return proof quality as string
-	proofStr := fmt.Sprintf("Quality: %d, Hash: %x", farmerState.LastProof.Quality, farmerState.LastProof.Hash[:8])
-	return C.CString(proofStr)
+	dst = append(dst, "Quality: "...)
+	dst = strconv.AppendUint(dst, farmerState.LastProof.Quality, 10)
+	dst = append(dst, ", Hash: "...)
+	var hash [16]byte
+	hex.Encode(hash[:], farmerState.LastProof.Hash[:8])
+	return append(dst, hash[:]...)
+}
+
+//export archivas_farmer_get_last_proof
+func archivas_farmer_get_last_proof() *C.char {
+	var buf [64]byte
+	return C.CString(string(appendLastProof(buf[:0])))
+}
+
+//export archivas_farmer_get_last_proof_into
+func archivas_farmer_get_last_proof_into(buf *C.char, capacity C.size_t, written *C.size_t) C.int {
+	if written != nil {
+		*written = 0
+	}
+	if buf == nil || capacity == 0 {
+		return -1
+	}
+
+	var scratch [64]byte
+	text := appendLastProof(scratch[:0])
+	truncated := C.int(0)
+	if uint64(len(text)) > uint64(capacity)-1 {
+		text = text[:capacity-1]
+		truncated = 1
+	}
+
+	// Only the bytes written; capacity may be any size_t, SIZE_MAX included
+	out := unsafe.Slice((*byte)(unsafe.Pointer(buf)), len(text)+1)
+	n := copy(out, text)
+	out[n] = 0
+	if written != nil {
+		*written = C.size_t(n)
+	}
+	return truncated
 }
 
 //export archivas_farmer_set_log_callback
@@ -1,19 +1,36 @@
 #ifndef ARCHIVAS_FARMER_BRIDGE_H
 #define ARCHIVAS_FARMER_BRIDGE_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Farmer lifecycle
+// Farmer lifecycle. Start and stop return immediately; progress is reported as
+// ARCHIVAS_EVENT_FARMER_STATE events (see events.h).
+// Start returns 0 if startup began, 1 if the farmer is already running or still stopping.
 int archivas_farmer_start(char* node_url, char* plots_path, char* farmer_privkey);
 void archivas_farmer_stop();
 int archivas_farmer_is_running();
+int archivas_farmer_get_state();  // ARCHIVAS_SERVICE_*
+
+// Blocks until farmer teardown has finished or timeout_ms elapses (negative
+// waits forever). Returns 1 if stopped, 0 on timeout. Meant for process exit only.
+int archivas_farmer_wait_stopped(int timeout_ms);
 
 // Status queries
 int archivas_farmer_get_plot_count();
+
+// Returns a malloc'd "Quality: <q>, Hash: <hex>" string (empty if no proof yet)
+// the caller must free(); prefer the _into variant
 char* archivas_farmer_get_last_proof();
 
+// Writes the same text into buf (at most cap - 1 bytes plus a NUL) without
+// allocating, and its length to *written if not NULL. Returns 0 on success,
+// 1 if the text was truncated, -1 if buf is NULL or cap is 0
+int archivas_farmer_get_last_proof_into(char* buf, size_t cap, size_t* written);
+
 // Plot creation
 int archivas_farmer_create_plot(char* plot_path, unsigned int k_size, char* farmer_privkey_path);
 
@@ -0,0 +1,263 @@
+package main
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"io"
+	"log"
+	"math"
+	"math/rand"
+	"os"
+	"testing"
+
+	"github.com/ArchivasNetwork/archivas/consensus"
+	"github.com/ArchivasNetwork/archivas/pospace"
+)
+
+func TestMain(m *testing.M) {
+	// Without a registered callback the node logs through the log package
+	log.SetOutput(io.Discard)
+	os.Exit(m.Run())
+}
+
+// legacyHashBlock is the fmt-based hash that hashBlock replaced; the two
+// must agree on every block or the GUI would reject the network's chain
+func legacyHashBlock(b *Block) [32]byte {
+	h := sha256.New()
+	fmt.Fprintf(h, "%d", b.Height)
+	fmt.Fprintf(h, "%d", b.TimestampUnix)
+	h.Write(b.PrevHash[:])
+	fmt.Fprintf(h, "%d", b.Difficulty)
+	h.Write(b.Challenge[:])
+	if b.Proof != nil {
+		h.Write(b.Proof.Hash[:])
+	}
+	return sha256.Sum256(h.Sum(nil))
+}
+
+func randomBlock(rng *rand.Rand) Block {
+	b := Block{
+		Height:        rng.Uint64() >> uint(rng.Intn(64)),
+		TimestampUnix: rng.Int63() >> uint(rng.Intn(63)),
+		Difficulty:    rng.Uint64() >> uint(rng.Intn(64)),
+	}
+	if rng.Intn(2) == 0 {
+		b.TimestampUnix = -b.TimestampUnix
+	}
+	rng.Read(b.PrevHash[:])
+	rng.Read(b.Challenge[:])
+	if rng.Intn(8) != 0 {
+		b.Proof = &pospace.Proof{}
+		rng.Read(b.Proof.Hash[:])
+	}
+	return b
+}
+
+func TestHashBlockMatchesLegacyFormatter(t *testing.T) {
+	edges := []Block{
+		{},
+		{Height: math.MaxUint64, TimestampUnix: math.MaxInt64, Difficulty: math.MaxUint64},
+		{TimestampUnix: math.MinInt64},
+		{Height: 1, TimestampUnix: -1, Difficulty: 1, Proof: &pospace.Proof{}},
+	}
+	for i := range edges {
+		if got, want := hashBlock(&edges[i]), legacyHashBlock(&edges[i]); got != want {
+			t.Fatalf("edge case %d: hashBlock = %x, legacy = %x", i, got, want)
+		}
+	}
+
+	rng := rand.New(rand.NewSource(1))
+	for i := 0; i < 100000; i++ {
+		b := randomBlock(rng)
+		if got, want := hashBlock(&b), legacyHashBlock(&b); got != want {
+			t.Fatalf("block %d (height %d, timestamp %d, difficulty %d): hashBlock = %x, legacy = %x",
+				i, b.Height, b.TimestampUnix, b.Difficulty, got, want)
+		}
+	}
+}
+
+func BenchmarkHashBlock(b *testing.B) {
+	block := randomBlock(rand.New(rand.NewSource(1)))
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		hashBlock(&block)
+	}
+}
+
+func BenchmarkLegacyHashBlock(b *testing.B) {
+	block := randomBlock(rand.New(rand.NewSource(1)))
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		legacyHashBlock(&block)
+	}
+}
+
+// testBlock builds the block at height on top of prev, sealed the way
+// ApplyBlock seals blocks it receives
+func testBlock(prev *Block, height uint64, rng *rand.Rand) Block {
+	b := Block{
+		Height:        height,
+		TimestampUnix: 1700000000 + int64(height)*20,
+		Difficulty:    1000000,
+		Proof:         &pospace.Proof{Quality: rng.Uint64() >> 8, Index: uint64(rng.Intn(1 << 20))},
+		FarmerAddr:    "arcv1testfarmer",
+	}
+	if prev != nil {
+		b.PrevHash = prev.Hash()
+	}
+	rng.Read(b.Challenge[:])
+	rng.Read(b.Proof.Hash[:])
+	rng.Read(b.Proof.PlotID[:])
+	b.Proof.Challenge = b.Challenge
+	b.sealHash()
+	return b
+}
+
+// blockJSON encodes b the way /blocks/range serves it to ApplyBlock
+func blockJSON(b *Block) json.RawMessage {
+	hash := b.Hash()
+	data, err := json.Marshal(map[string]interface{}{
+		"height":     b.Height,
+		"hash":       hex.EncodeToString(hash[:]),
+		"prevHash":   hex.EncodeToString(b.PrevHash[:]),
+		"timestamp":  b.TimestampUnix,
+		"difficulty": b.Difficulty,
+		"challenge":  hex.EncodeToString(b.Challenge[:]),
+		"farmerAddr": b.FarmerAddr,
+		"txs":        []interface{}{},
+		"proof": map[string]interface{}{
+			"hash":    hex.EncodeToString(b.Proof.Hash[:]),
+			"quality": b.Proof.Quality,
+			"plotID":  hex.EncodeToString(b.Proof.PlotID[:]),
+			"index":   b.Proof.Index,
+		},
+	})
+	if err != nil {
+		panic(err)
+	}
+	return data
+}
+
+// testChainPayloads encodes a chain of count blocks from genesis up
+func testChainPayloads(count int) []json.RawMessage {
+	rng := rand.New(rand.NewSource(1))
+	payloads := make([]json.RawMessage, count)
+	var prev Block
+	for h := range payloads {
+		var parent *Block
+		if h > 0 {
+			parent = &prev
+		}
+		block := testBlock(parent, uint64(h), rng)
+		payloads[h] = blockJSON(&block)
+		prev = block
+	}
+	return payloads
+}
+
+// BenchmarkApplyBlockDecode measures decoding and hash verification of a
+// received block: the genesis block is re-sent, so ApplyBlock does all of
+// its parsing and then returns without changing the chain.
+func BenchmarkApplyBlockDecode(b *testing.B) {
+	rng := rand.New(rand.NewSource(1))
+	genesis := testBlock(nil, 0, rng)
+	ns := &NodeState{Chain: []Block{genesis}, Consensus: &consensus.Consensus{}}
+	data := blockJSON(&genesis)
+
+	b.ReportAllocs()
+	b.SetBytes(int64(len(data)))
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := ns.ApplyBlock(data); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+// BenchmarkApplyBlock appends new blocks to the chain, so each op runs the
+// prev-hash check against the tip and publishes a new tip snapshot
+func BenchmarkApplyBlock(b *testing.B) {
+	benchmarkApplyBlocks(b)
+}
+
+// benchmarkApplyBlocks applies b.N blocks on top of a genesis block
+func benchmarkApplyBlocks(b *testing.B) {
+	payloads := testChainPayloads(b.N + 1)
+	ns := &NodeState{Consensus: &consensus.Consensus{}}
+	publishedTip.Store(nil)
+	defer publishedTip.Store(nil)
+	if err := ns.ApplyBlock(payloads[0]); err != nil {
+		b.Fatal(err)
+	}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 1; i <= b.N; i++ {
+		if err := ns.ApplyBlock(payloads[i]); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+// BenchmarkGetStatus reads the status the GUI polls, from the published tip
+// and, before anything is published, built from the chain under the read lock
+func BenchmarkGetStatus(b *testing.B) {
+	rng := rand.New(rand.NewSource(1))
+	ns := &NodeState{Consensus: &consensus.Consensus{}}
+	for h := uint64(0); h < 1000; h++ {
+		var prev *Block
+		if h > 0 {
+			prev = &ns.Chain[h-1]
+		}
+		ns.Chain = append(ns.Chain, testBlock(prev, h, rng))
+	}
+	ns.CurrentHeight = 999
+	defer publishedTip.Store(nil)
+
+	b.Run("published", func(b *testing.B) {
+		ns.publishTip()
+		b.ReportAllocs()
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			if height, _, _ := ns.GetStatus(); height != 999 {
+				b.Fatalf("height = %d", height)
+			}
+		}
+	})
+	b.Run("unpublished", func(b *testing.B) {
+		publishedTip.Store(nil)
+		b.ReportAllocs()
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			if height, _, _ := ns.GetStatus(); height != 999 {
+				b.Fatalf("height = %d", height)
+			}
+		}
+	})
+}
+
+func BenchmarkBlocksRangeEncode(b *testing.B) {
+	rng := rand.New(rand.NewSource(1))
+	ns := &NodeState{Consensus: &consensus.Consensus{}}
+	for h := uint64(0); h <= 512; h++ {
+		var prev *Block
+		if h > 0 {
+			prev = &ns.Chain[h-1]
+		}
+		ns.Chain = append(ns.Chain, testBlock(prev, h, rng))
+	}
+	ns.CurrentHeight = 512
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		blocks, _, _, err := ns.OnBlocksRangeRequest(1, 512)
+		if err != nil || len(blocks) != 512 {
+			b.Fatalf("got %d blocks, err %v", len(blocks), err)
+		}
+	}
+}
@@ -0,0 +1,215 @@
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}
+#include <stdlib.h>
+#include "logs.h"
+*/
+import "C"
+import (
+	"fmt"
+	"sync"
+	"sync/atomic"
+	"time"
+	"unsafe"
+)
+
+// logArenaSize is the size of the log arena in bytes (multiple of 8)
+const logArenaSize = 1 << 20
+
+const logRecordHeaderSize = uint64(unsafe.Sizeof(C.archivas_log_record{}))
+
+// Log arena shared with the GUI. The arena lives in C memory so the consumer
+// can parse records in place; producers serialize through logProducerMutex.
+// logHead and logTail are byte offsets that only grow, taken modulo the size.
+var (
+	logArena         unsafe.Pointer
+	logArenaOnce     sync.Once
+	logHead          atomic.Uint64
+	logTail          atomic.Uint64
+	logProducerMutex sync.Mutex
+	logDropped       atomic.Uint64
+	logRingEnabled   atomic.Bool
+	logNotifyPending atomic.Bool
+
+	// Lowest level kept per source (indexed by ARCHIVAS_LOG_SOURCE_*)
+	logLevels [2]atomic.Int32
+)
+
+// notifyLogConsumer wakes the consumer unless a wakeup is already pending
+func notifyLogConsumer() {
+	writeNotifyByte(&logNotifyPending)
+}
+
+// logLevelCode maps the level names used throughout the bridge to ARCHIVAS_LOG_*
+func logLevelCode(level string) C.uint8_t {
+	switch level {
+	case "DEBUG":
+		return C.ARCHIVAS_LOG_DEBUG
+	case "WARN":
+		return C.ARCHIVAS_LOG_WARN
+	case "ERROR":
+		return C.ARCHIVAS_LOG_ERROR
+	default:
+		return C.ARCHIVAS_LOG_INFO
+	}
+}
+
+// logEnabled reports whether a record at level from source passes the
+// threshold set with archivas_set_log_level. It is a single atomic load, so hot
+// paths call it before doing any formatting.
+func logEnabled(source, level C.uint8_t) bool {
+	return int32(level) >= logLevels[source].Load()
+}
+
+// nodeDebugEnabled guards per-block debug logging in ApplyBlock. Building the
+// arguments for nodeLogf allocates even when the record is dropped, so the
+// block path checks the level first; everywhere else calls nodeLogf directly.
+func nodeDebugEnabled() bool {
+	return logEnabled(C.ARCHIVAS_LOG_SOURCE_NODE, C.ARCHIVAS_LOG_DEBUG)
+}
+
+// nodeLogf formats the message only when level is enabled for the node. Node
+// and farmer code log through it and farmerLogf instead of formatting first.
+func nodeLogf(level, format string, args ...interface{}) {
+	if logEnabled(C.ARCHIVAS_LOG_SOURCE_NODE, logLevelCode(level)) {
+		callLogCallback(level, fmt.Sprintf(format, args...))
+	}
+}
+
+// farmerLogf is nodeLogf for the farmer
+func farmerLogf(level, format string, args ...interface{}) {
+	if logEnabled(C.ARCHIVAS_LOG_SOURCE_FARMER, logLevelCode(level)) {
+		callFarmerLogCallback(level, fmt.Sprintf(format, args...))
+	}
+}
+
+// appendLogRecord copies one log line into the arena. It returns false when the
+// arena is disabled so the caller can fall back to the callback path.
+func appendLogRecord(source C.uint8_t, level, message string) bool {
+	if !logRingEnabled.Load() {
+		return false
+	}
+	if len(message) > 0xFFFF {
+		message = message[:0xFFFF]
+	}
+	size := (logRecordHeaderSize + uint64(len(message)) + 7) &^ 7
+	timestamp := time.Now().UnixNano()
+	arena := unsafe.Slice((*byte)(logArena), logArenaSize)
+
+	logProducerMutex.Lock()
+	head := logHead.Load()
+	pos := head % logArenaSize
+	pad := uint64(0)
+	if pos+size > logArenaSize {
+		pad = logArenaSize - pos
+	}
+	if head+pad+size-logTail.Load() > logArenaSize {
+		logProducerMutex.Unlock()
+		logDropped.Add(1)
+		notifyLogConsumer()
+		return true
+	}
+	if pad > 0 {
+		// Records never straddle the end: a zero size sends the consumer back to offset 0
+		*(*uint32)(unsafe.Pointer(&arena[pos])) = 0
+		head += pad
+		pos = 0
+	}
+	rec := (*C.archivas_log_record)(unsafe.Pointer(&arena[pos]))
+	rec.size = C.uint32_t(size)
+	rec.level = logLevelCode(level)
+	rec.source = source
+	rec.message_len = C.uint16_t(len(message))
+	rec.timestamp_ns = C.int64_t(timestamp)
+	copy(arena[pos+logRecordHeaderSize:pos+size], message)
+	logHead.Store(head + size)
+	logProducerMutex.Unlock()
+
+	notifyLogConsumer()
+	return true
+}
+
+//export archivas_set_log_level
+func archivas_set_log_level(subsystem C.int, level C.int) C.int {
+	if subsystem < 0 || int(subsystem) >= len(logLevels) ||
+		level < C.ARCHIVAS_LOG_DEBUG || level > C.ARCHIVAS_LOG_ERROR {
+		return -1
+	}
+	logLevels[subsystem].Store(int32(level))
+	return 0
+}
+
+//export archivas_logs_write
+func archivas_logs_write(subsystem C.int, level C.int, message *C.char) C.int {
+	if message == nil || level < C.ARCHIVAS_LOG_DEBUG || level > C.ARCHIVAS_LOG_ERROR {
+		return -1
+	}
+	name := [...]string{"DEBUG", "INFO", "WARN", "ERROR"}[level]
+	switch subsystem {
+	case C.ARCHIVAS_LOG_SOURCE_NODE:
+		if logEnabled(C.ARCHIVAS_LOG_SOURCE_NODE, C.uint8_t(level)) {
+			callLogCallback(name, C.GoString(message))
+		}
+	case C.ARCHIVAS_LOG_SOURCE_FARMER:
+		if logEnabled(C.ARCHIVAS_LOG_SOURCE_FARMER, C.uint8_t(level)) {
+			callFarmerLogCallback(name, C.GoString(message))
+		}
+	default:
+		return -1
+	}
+	return 0
+}
+
+//export archivas_logs_enable
+func archivas_logs_enable(enabled C.int) {
+	if enabled != 0 {
+		logArenaOnce.Do(func() {
+			logArena = C.malloc(logArenaSize)
+		})
+	}
+	logRingEnabled.Store(enabled != 0 && logArena != nil)
+}
+
+//export archivas_logs_peek
+func archivas_logs_peek(length *C.size_t, dropped *C.uint64_t) *C.uint8_t {
+	if dropped != nil {
+		*dropped = C.uint64_t(logDropped.Swap(0))
+	}
+	if length == nil || logArena == nil {
+		return nil
+	}
+	*length = 0
+
+	// Clear the pending flag before reading so an append racing with this
+	// peek writes a fresh wakeup instead of being missed
+	logNotifyPending.Store(false)
+
+	tail := logTail.Load()
+	head := logHead.Load()
+	if tail == head {
+		return nil
+	}
+	pos := tail % logArenaSize
+	if *(*uint32)(unsafe.Add(logArena, pos)) == 0 {
+		// Skip the wrap marker left by the producer
+		tail += logArenaSize - pos
+		logTail.Store(tail)
+		pos = 0
+		if tail == head {
+			return nil
+		}
+	}
+
+	avail := head - tail
+	if avail > logArenaSize-pos {
+		avail = logArenaSize - pos
+	}
+	*length = C.size_t(avail)
+	return (*C.uint8_t)(unsafe.Add(logArena, pos))
+}
+
+//export archivas_logs_consume
+func archivas_logs_consume(length C.size_t) {
+	logTail.Add(uint64(length))
+}
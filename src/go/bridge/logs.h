@@ -0,0 +1,56 @@
+#ifndef ARCHIVAS_LOGS_BRIDGE_H
+#define ARCHIVAS_LOGS_BRIDGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Log levels
+#define ARCHIVAS_LOG_DEBUG 0
+#define ARCHIVAS_LOG_INFO  1
+#define ARCHIVAS_LOG_WARN  2
+#define ARCHIVAS_LOG_ERROR 3
+
+// Log sources
+#define ARCHIVAS_LOG_SOURCE_NODE   0
+#define ARCHIVAS_LOG_SOURCE_FARMER 1
+
+// Record header in the log arena, followed by message_len bytes of UTF-8
+// (not NUL-terminated). Records start on 8-byte boundaries.
+typedef struct archivas_log_record {
+    uint32_t size;          // Whole record including header and padding; 0 marks a wrap
+    uint8_t  level;         // ARCHIVAS_LOG_*
+    uint8_t  source;        // ARCHIVAS_LOG_SOURCE_*
+    uint16_t message_len;
+    int64_t  timestamp_ns;  // Unix nanoseconds
+} archivas_log_record;
+
+// Drop records below level (ARCHIVAS_LOG_*) for subsystem (ARCHIVAS_LOG_SOURCE_*)
+// before they are formatted. Everything is kept until this is called.
+// Returns 0 on success, -1 for an unknown subsystem or level.
+int archivas_set_log_level(int subsystem, int level);
+
+// Log message as subsystem at level, through the same level gate and transport
+// (arena or callback) as the bridge's own lines. Used by the log benchmark.
+// Returns 0 on success, -1 for an unknown subsystem or level.
+int archivas_logs_write(int subsystem, int level, char* message);
+
+// Route node and farmer logs into the arena (non-zero) or back to the
+// registered callbacks / stderr (zero). The arena is allocated on first enable.
+void archivas_logs_enable(int enabled);
+
+// Returns a pointer to contiguous records and their total size in *len, or
+// NULL when empty. Parse records up to *len or a zero-size wrap marker, then
+// release exactly the bytes parsed with archivas_logs_consume. If dropped is
+// not NULL it receives the number of records lost to a full arena.
+uint8_t* archivas_logs_peek(size_t* len, uint64_t* dropped);
+void archivas_logs_consume(size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARCHIVAS_LOGS_BRIDGE_H
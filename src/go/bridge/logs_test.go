@@ -0,0 +1,28 @@
+package main
+
+import "testing"
+
+// ARCHIVAS_LOG_* values from logs.h; test files cannot import "C"
+const (
+	testLogSourceNode = 0
+	testLogDebug      = 0
+	testLogInfo       = 1
+)
+
+// BenchmarkApplyBlockLogLevel applies blocks with the node's debug lines
+// dropped (INFO) and kept (DEBUG). Kept records go through callLogCallback to
+// a discarded log, so the difference is the cost of building them.
+func BenchmarkApplyBlockLogLevel(b *testing.B) {
+	saved := logLevels[testLogSourceNode].Load()
+	defer logLevels[testLogSourceNode].Store(saved)
+
+	for _, level := range []struct {
+		name  string
+		value int32
+	}{{"INFO", testLogInfo}, {"DEBUG", testLogDebug}} {
+		b.Run(level.name, func(b *testing.B) {
+			logLevels[testLogSourceNode].Store(level.value)
+			benchmarkApplyBlocks(b)
+		})
+	}
+}
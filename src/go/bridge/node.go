@@ -4,6 +4,8 @@ package main
 #cgo CFLAGS: -I${SRCDIR}
 #include <stdlib.h>
 #include "node.h"
+#include "logs.h"
+#include "events.h"
 
 // Helper function to call the callback (needed because cgo can't call function pointers directly)
 static void call_log_callback(log_callback_t cb, char* level, char* message) {
@@ -27,6 +29,7 @@ import (
 	"strconv"
 	"strings"
 	"sync"
+	"sync/atomic"
 	"time"
 	"unsafe"
 
@@ -54,6 +57,10 @@ type Block struct {
 	Proof          *pospace.Proof
 	FarmerAddr     string
 	CumulativeWork uint64
+
+	// Memoized block hash (see sealHash). Unexported so it is never serialized.
+	hash   [32]byte
+	sealed bool
 }
 
 // NodeState holds the entire node state (copied from archivas-node/main.go)
@@ -81,12 +88,30 @@ type NodeState struct {
 	DataDir          string // Store dataDir for fork recovery
 }
 
+// tipSnapshot is an immutable view of the chain tip. A fresh one is published
+// after every block that changes the tip, so status readers (GUI getters, RPC
+// and P2P status) never wait on the NodeState lock during block application.
+type tipSnapshot struct {
+	Height              uint64
+	Hash                [32]byte
+	TipDifficulty       uint64 // Difficulty recorded in the tip block
+	ConsensusDifficulty uint64 // Consensus target at publish time
+	HasChain            bool
+
+	// The rest of the tip block's record (archivas_node_get_tip)
+	TimestampUnix int64
+	PrevHash      [32]byte
+	TxCount       int
+	FarmerAddr    string
+}
+
 // Global state
 var (
-	nodeRunning      bool
+	nodeRunning      bool // True from start until teardown has finished
 	nodeMutex        sync.RWMutex
-	nodeContext      context.Context
 	nodeCancel       context.CancelFunc
+	nodeService      C.int         // ARCHIVAS_SERVICE_*, guarded by nodeMutex
+	nodeDone         chan struct{} // Closed when the node goroutine has finished
 	nodeState        *NodeState
 	nodeStateMutex   sync.RWMutex
 	logCallback      C.log_callback_t
@@ -106,7 +131,8 @@ var (
 	ibdLastAppliedTime   time.Time
 	ibdAppliedBlocks     uint64 // Count of blocks applied in current session
 	ibdProgressMutex     sync.RWMutex
-	ibdRunning           bool // Track if IBD is currently running
+	ibdTargetHeight      uint64 // Remote tip height the current IBD is syncing towards
+	ibdRunning           bool   // Track if IBD is currently running
 	ibdRunningMutex      sync.RWMutex
 
 	// Network difficulty cache (from seed.archivas.ai)
@@ -121,20 +147,67 @@ var (
 	// Network hash cache (for blocks without proof - stores network's hash)
 	networkBlockHashes map[uint64][32]byte // height -> network hash
 	networkHashMutex   sync.RWMutex
+
+	// Status snapshot sequence tracking (see archivas_get_status_snapshot)
+	lastStatusSnapshot  C.archivas_status_snapshot
+	statusSequence      uint64
+	statusSnapshotMutex sync.Mutex
+
+	// Published chain tip (nil while the node is stopped)
+	publishedTip atomic.Pointer[tipSnapshot]
 )
 
-// hashBlock calculates the hash of a block (copied from archivas-node/main.go)
+// blockPreimageSize bounds the hashed block header: three decimal integers of at
+// most 20 bytes each plus three 32-byte hashes
+const blockPreimageSize = 3*20 + 3*32
+
+// hashBlock calculates the hash of a block (copied from archivas-node/main.go).
+// Integers are hashed as their decimal text, byte-identical to the original
+// fmt.Fprintf("%d") encoding; the preimage is built on the stack so hashing
+// does not allocate.
 func hashBlock(b *Block) [32]byte {
-	h := sha256.New()
-	fmt.Fprintf(h, "%d", b.Height)
-	fmt.Fprintf(h, "%d", b.TimestampUnix)
-	h.Write(b.PrevHash[:])
-	fmt.Fprintf(h, "%d", b.Difficulty)
-	h.Write(b.Challenge[:])
+	var buf [blockPreimageSize]byte
+	p := strconv.AppendUint(buf[:0], b.Height, 10)
+	p = strconv.AppendInt(p, b.TimestampUnix, 10)
+	p = append(p, b.PrevHash[:]...)
+	p = strconv.AppendUint(p, b.Difficulty, 10)
+	p = append(p, b.Challenge[:]...)
 	if b.Proof != nil {
-		h.Write(b.Proof.Hash[:])
+		p = append(p, b.Proof.Hash[:]...)
+	}
+	inner := sha256.Sum256(p)
+	return sha256.Sum256(inner[:])
+}
+
+// computeHash returns the network's recorded hash for b's height if there is one
+// (for blocks received without proof), otherwise the calculated hash
+func (b *Block) computeHash() [32]byte {
+	networkHashMutex.RLock()
+	if networkBlockHashes != nil {
+		if cachedHash, ok := networkBlockHashes[b.Height]; ok {
+			networkHashMutex.RUnlock()
+			return cachedHash
+		}
 	}
-	return sha256.Sum256(h.Sum(nil))
+	networkHashMutex.RUnlock()
+	return hashBlock(b)
+}
+
+// sealHash computes and caches b's hash. Call it once the block's fields are
+// final and before the block is shared; sealed blocks are never modified.
+func (b *Block) sealHash() [32]byte {
+	b.hash = b.computeHash()
+	b.sealed = true
+	return b.hash
+}
+
+// Hash returns the cached hash, computing it without caching for blocks that
+// were never sealed (so concurrent readers never write to a shared block)
+func (b *Block) Hash() [32]byte {
+	if b.sealed {
+		return b.hash
+	}
+	return b.computeHash()
 }
 
 // recoverFromFork clears the database and reinitializes from genesis without stopping the node
@@ -214,7 +287,7 @@ func recoverFromFork(dataDirPath string, genesisPath string, networkID string, r
 		CumulativeWork: consensus.CalculateWork(genesisBlockDifficulty),
 	}
 
-	calculatedGenesisHash := hashBlock(&genesisBlock)
+	calculatedGenesisHash := genesisBlock.sealHash()
 
 	// Step 7: Initialize chain state
 	worldState := ledger.NewWorldState(genesisAllocs)
@@ -274,6 +347,7 @@ func recoverFromFork(dataDirPath string, genesisPath string, networkID string, r
 		if nodeState.ReorgDetector == nil {
 			nodeState.ReorgDetector = consensus.NewReorgDetector()
 		}
+		nodeState.publishTip()
 		nodeState.Unlock()
 	} else {
 		// Create new nodeState (shouldn't happen, but handle it)
@@ -294,6 +368,7 @@ func recoverFromFork(dataDirPath string, genesisPath string, networkID string, r
 			NetworkID:        networkID,
 			DataDir:          dataDirPath,
 		}
+		nodeState.publishTip()
 	}
 	nodeStateMutex.Unlock()
 
@@ -301,6 +376,7 @@ func recoverFromFork(dataDirPath string, genesisPath string, networkID string, r
 	ibdRunningMutex.Lock()
 	ibdRunning = false
 	ibdRunningMutex.Unlock()
+	emitSyncStage(C.ARCHIVAS_SYNC_IDLE, 0, 0)
 
 	ibdProgressMutex.Lock()
 	ibdLastAppliedHeight = 0
@@ -314,8 +390,16 @@ func recoverFromFork(dataDirPath string, genesisPath string, networkID string, r
 	return nil
 }
 
-// callLogCallback safely calls the C callback function
+// callLogCallback drops levels below the node threshold, then writes to the log
+// arena when the GUI has enabled it, otherwise it safely calls the C callback function
 func callLogCallback(level, message string) {
+	if !logEnabled(C.ARCHIVAS_LOG_SOURCE_NODE, logLevelCode(level)) {
+		return
+	}
+	if appendLogRecord(C.ARCHIVAS_LOG_SOURCE_NODE, level, message) {
+		return
+	}
+
 	logCallbackMutex.RLock()
 	cb := logCallback
 	logCallbackMutex.RUnlock()
@@ -347,7 +431,7 @@ func archivas_node_start(networkID, rpcBind, dataDir, bootnodes, genesisPath *C.
 	defer nodeMutex.Unlock()
 
 	if nodeRunning {
-		return 1 // Already running
+		return 1 // Already running (or still stopping)
 	}
 
 	// Banned peers are loaded in startArchivasNode from disk
@@ -367,36 +451,54 @@ func archivas_node_start(networkID, rpcBind, dataDir, bootnodes, genesisPath *C.
 	genesisPathStr := C.GoString(genesisPath)
 
 	// Create context for cancellation
-	nodeContext, nodeCancel = context.WithCancel(context.Background())
-
-	// Start node in goroutine (non-blocking)
+	ctx, cancel := context.WithCancel(context.Background())
+	nodeCancel = cancel
+	done := make(chan struct{})
+	nodeDone = done
+	nodeRunning = true
+	setNodeService(C.ARCHIVAS_SERVICE_STARTING)
+
+	// Start node in goroutine (non-blocking); every state change is reported
+	// through the event ring so callers never have to wait here
 	go func() {
-		nodeMutex.Lock()
-		nodeRunning = true
-		nodeMutex.Unlock()
+		defer close(done)
 
 		callLogCallback("INFO", fmt.Sprintf("Starting Archivas node: network=%s, rpc_bind=%s, data_dir=%s",
 			networkIDStr, rpcBindStr, dataDirStr))
 
-		// Initialize node
-		err := startArchivasNode(nodeContext, networkIDStr, rpcBindStr, dataDirStr, bootnodesStr, genesisPathStr)
+		// Running once the RPC server and chain state are up; the call below
+		// then stays in the heartbeat loop until ctx is cancelled
+		ready := func() {
+			nodeMutex.Lock()
+			if nodeService == C.ARCHIVAS_SERVICE_STARTING {
+				setNodeService(C.ARCHIVAS_SERVICE_RUNNING)
+			}
+			nodeMutex.Unlock()
+		}
+
+		err := startArchivasNode(ctx, networkIDStr, rpcBindStr, dataDirStr, bootnodesStr, genesisPathStr, ready)
 		if err != nil {
 			callLogCallback("ERROR", fmt.Sprintf("Failed to start node: %v", err))
 			nodeMutex.Lock()
 			nodeRunning = false
+			if ctx.Err() != nil {
+				// Stopped while starting
+				setNodeService(C.ARCHIVAS_SERVICE_STOPPED)
+			} else {
+				setNodeService(C.ARCHIVAS_SERVICE_FAILED)
+			}
 			nodeMutex.Unlock()
+			cancel()
 			return
 		}
 
-		// Wait for cancellation
-		<-nodeContext.Done()
-
 		// Cleanup
 		stopArchivasNode()
+		callLogCallback("INFO", "Archivas node stopped")
 		nodeMutex.Lock()
 		nodeRunning = false
+		setNodeService(C.ARCHIVAS_SERVICE_STOPPED)
 		nodeMutex.Unlock()
-		callLogCallback("INFO", "Archivas node stopped")
 	}()
 
 	return 0 // Success
@@ -492,8 +594,9 @@ func isBanned(peerAddr string) bool {
 	return false
 }
 
-// startArchivasNode initializes and starts the Archivas node
-func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnodes, genesisPath string) error {
+// startArchivasNode initializes and starts the Archivas node, calls ready
+// once it serves requests, and runs until ctx is cancelled
+func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnodes, genesisPath string, ready func()) error {
 	callLogCallback("INFO", "Initializing Archivas node...")
 
 	// Ensure RPC binds to 0.0.0.0 if no host specified
@@ -627,7 +730,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 	}
 
 	// Calculate genesis block hash (should match network's genesis hash)
-	calculatedGenesisHash := hashBlock(&genesisBlock)
+	calculatedGenesisHash := genesisBlock.sealHash()
 	callLogCallback("INFO", fmt.Sprintf("Calculated genesis block hash: %x", calculatedGenesisHash[:8]))
 
 	// Expected network genesis hash (verified to match when using difficulty 2^50)
@@ -755,6 +858,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			if err := blockStore.LoadBlock(h, &blk); err != nil {
 				return fmt.Errorf("failed to load block %d: %w", h, err)
 			}
+			blk.sealHash()
 			chain = append(chain, blk)
 		}
 
@@ -915,9 +1019,8 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			currentHeight = tipHeight
 			// Get current challenge from tip block
 			if len(chain) > 0 {
-				tipBlock := chain[len(chain)-1]
 				// Generate challenge for next block based on tip
-				newBlockHash := hashBlock(&tipBlock)
+				newBlockHash := chain[len(chain)-1].Hash()
 				genesisChallenge = consensus.GenerateChallenge(newBlockHash, currentHeight+1)
 			} else {
 				genesisChallenge = consensus.GenerateGenesisChallenge()
@@ -944,6 +1047,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 		NetworkID:        networkID,
 		DataDir:          dataDir, // Store dataDir for fork recovery
 	}
+	nodeState.publishTip()
 	nodeStateMutex.Unlock()
 
 	callLogCallback("INFO", "Node state initialized")
@@ -1189,6 +1293,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 													oldDiff := currentNodeState.Consensus.DifficultyTarget
 													if oldDiff != networkDiff {
 														currentNodeState.Consensus.DifficultyTarget = networkDiff
+														currentNodeState.publishTip()
 														callLogCallback("INFO", fmt.Sprintf("Updated consensus difficulty from network: %d → %d", oldDiff, networkDiff))
 														// Save updated difficulty
 														if currentNodeState.MetaStore != nil {
@@ -1240,7 +1345,9 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 							ibdLastAppliedHeight = startHeight
 							ibdLastAppliedTime = time.Now()
 							ibdAppliedBlocks = 0
+							ibdTargetHeight = remoteTip
 							ibdProgressMutex.Unlock()
+							emitSyncStage(C.ARCHIVAS_SYNC_RUNNING, startHeight, remoteTip)
 
 							// Track progress for reporting
 							lastReportedHeight := startHeight
@@ -1424,6 +1531,11 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 							ibdRunningMutex.Lock()
 							ibdRunning = false
 							ibdRunningMutex.Unlock()
+							if ibdSuccess {
+								emitSyncStage(C.ARCHIVAS_SYNC_COMPLETE, ns.GetCurrentHeight(), remoteTip)
+							} else {
+								emitSyncStage(C.ARCHIVAS_SYNC_FAILED, ns.GetCurrentHeight(), remoteTip)
+							}
 
 							// Stop progress monitor
 							close(progressDone)
@@ -1469,14 +1581,18 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 		}
 	}()
 
+	// Push feed for GUI clients, on its own listener (see stream.go)
+	startStreamServer(ctx)
+
 	// Give RPC server a moment to start
 	time.Sleep(500 * time.Millisecond)
 	callLogCallback("INFO", "RPC server running")
 
-	// Start metrics updater
+	// Start metrics updater (also reports peer connects/disconnects to the GUI)
 	go func() {
 		ticker := time.NewTicker(2 * time.Second)
 		defer ticker.Stop()
+		knownPeers := make(map[string]bool)
 		for {
 			select {
 			case <-ctx.Done():
@@ -1484,12 +1600,27 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			case <-ticker.C:
 				nodeStateMutex.RLock()
 				if nodeState != nil {
-					metrics.UpdateTipHeight(nodeState.CurrentHeight)
+					if tip := publishedTip.Load(); tip != nil {
+						metrics.UpdateTipHeight(tip.Height)
+						metrics.UpdateDifficulty(tip.ConsensusDifficulty)
+					}
 					if nodeState.P2P != nil {
 						connected, _ := nodeState.P2P.GetPeerList()
 						metrics.UpdatePeerCount(len(connected))
+						current := make(map[string]bool, len(connected))
+						for _, addr := range connected {
+							current[addr] = true
+							if !knownPeers[addr] {
+								emitPeerEvent(true, addr, len(connected))
+							}
+						}
+						for addr := range knownPeers {
+							if !current[addr] {
+								emitPeerEvent(false, addr, len(connected))
+							}
+						}
+						knownPeers = current
 					}
-					metrics.UpdateDifficulty(nodeState.Consensus.DifficultyTarget)
 				}
 				nodeStateMutex.RUnlock()
 			}
@@ -1508,7 +1639,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 		
 		// Helper function to perform sync check
 		performSyncCheck := func() {
-			callLogCallback("DEBUG", "Background sync monitor: performing sync check...")
+			nodeLogf("DEBUG", "Background sync monitor: performing sync check...")
 			
 			// Skip if IBD is running
 			ibdRunningMutex.RLock()
@@ -1516,24 +1647,19 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			ibdRunningMutex.RUnlock()
 			
 			if ibdIsRunning {
-				callLogCallback("DEBUG", "Background sync monitor: IBD is running, skipping check")
+				nodeLogf("DEBUG", "Background sync monitor: IBD is running, skipping check")
 				return // Let IBD handle syncing
 			}
 			
 			// Get current height
-			nodeStateMutex.RLock()
-			currentHeight := uint64(0)
-			if nodeState != nil {
-				currentHeight = nodeState.CurrentHeight
-			}
-			nodeStateMutex.RUnlock()
+			currentHeight := publishedTipHeight()
 			
 			if currentHeight == 0 {
-				callLogCallback("DEBUG", "Background sync monitor: node not initialized yet (height=0), skipping")
+				nodeLogf("DEBUG", "Background sync monitor: node not initialized yet (height=0), skipping")
 				return // Not initialized yet
 			}
 			
-			callLogCallback("DEBUG", fmt.Sprintf("Background sync monitor: checking network tip (local height: %d)", currentHeight))
+			nodeLogf("DEBUG", "Background sync monitor: checking network tip (local height: %d)", currentHeight)
 			
 			// Check network tip height
 			seedURL := "https://seed.archivas.ai"
@@ -1549,7 +1675,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			for attempt := 0; attempt < maxRetries; attempt++ {
 				if attempt > 0 {
 					backoff := time.Duration(attempt) * 5 * time.Second
-					callLogCallback("DEBUG", fmt.Sprintf("Sync check: retrying chainTip fetch (attempt %d/%d) after %v", attempt+1, maxRetries, backoff))
+					nodeLogf("DEBUG", "Sync check: retrying chainTip fetch (attempt %d/%d) after %v", attempt+1, maxRetries, backoff)
 					time.Sleep(backoff)
 				}
 				
@@ -1563,17 +1689,17 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 				}
 				
 				if attempt < maxRetries-1 {
-					callLogCallback("DEBUG", fmt.Sprintf("Sync check: chainTip fetch failed (attempt %d/%d): %v", attempt+1, maxRetries, err))
+					nodeLogf("DEBUG", "Sync check: chainTip fetch failed (attempt %d/%d): %v", attempt+1, maxRetries, err)
 				}
 			}
 			
 			if err != nil {
-				callLogCallback("DEBUG", fmt.Sprintf("Sync check: failed to fetch chainTip after %d attempts: %v", maxRetries, err))
+				nodeLogf("DEBUG", "Sync check: failed to fetch chainTip after %d attempts: %v", maxRetries, err)
 				return
 			}
 			
 			if resp.StatusCode != 200 {
-				callLogCallback("DEBUG", fmt.Sprintf("Sync check: chainTip returned status %d", resp.StatusCode))
+				nodeLogf("DEBUG", "Sync check: chainTip returned status %d", resp.StatusCode)
 				resp.Body.Close()
 				return
 			}
@@ -1582,7 +1708,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			var tipRespRaw map[string]interface{}
 			if err := json.NewDecoder(resp.Body).Decode(&tipRespRaw); err != nil {
 				resp.Body.Close()
-				callLogCallback("DEBUG", fmt.Sprintf("Sync check: failed to decode chainTip response: %v", err))
+				nodeLogf("DEBUG", "Sync check: failed to decode chainTip response: %v", err)
 				return
 			}
 			resp.Body.Close()
@@ -1597,17 +1723,17 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 					if parsed, err := strconv.ParseUint(v, 10, 64); err == nil {
 						networkTip = parsed
 					} else {
-						callLogCallback("DEBUG", fmt.Sprintf("Sync check: failed to parse height as string: %v", err))
+						nodeLogf("DEBUG", "Sync check: failed to parse height as string: %v", err)
 						return
 					}
 				case uint64:
 					networkTip = v
 				default:
-					callLogCallback("DEBUG", fmt.Sprintf("Sync check: height has unexpected type: %T", v))
+					nodeLogf("DEBUG", "Sync check: height has unexpected type: %T", v)
 					return
 				}
 			} else {
-				callLogCallback("DEBUG", "Sync check: height field missing from chainTip response")
+				nodeLogf("DEBUG", "Sync check: height field missing from chainTip response")
 				return
 			}
 			
@@ -1616,9 +1742,9 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 				gap := networkTip - currentHeight
 				callLogCallback("INFO", fmt.Sprintf("Sync check: local=%d, network=%d (gap: %d blocks) - fetching", currentHeight, networkTip, gap))
 			} else if networkTip < currentHeight {
-				callLogCallback("DEBUG", fmt.Sprintf("Sync check: local=%d, network=%d (local ahead by %d blocks)", currentHeight, networkTip, currentHeight-networkTip))
+				nodeLogf("DEBUG", "Sync check: local=%d, network=%d (local ahead by %d blocks)", currentHeight, networkTip, currentHeight-networkTip)
 			} else {
-				callLogCallback("DEBUG", fmt.Sprintf("Sync check: local=%d, network=%d (synced)", currentHeight, networkTip))
+				nodeLogf("DEBUG", "Sync check: local=%d, network=%d (synced)", currentHeight, networkTip)
 			}
 			
 			// If we're behind by more than 0 blocks, fetch missing blocks
@@ -1674,12 +1800,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 					}
 					
 					if appliedCount > 0 {
-						nodeStateMutex.RLock()
-						newHeight := uint64(0)
-						if nodeState != nil {
-							newHeight = nodeState.CurrentHeight
-						}
-						nodeStateMutex.RUnlock()
+						newHeight := publishedTipHeight()
 						callLogCallback("INFO", fmt.Sprintf("Applied %d new blocks, height now: %d", appliedCount, newHeight))
 					}
 				}
@@ -1702,6 +1823,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 	}()
 
 	callLogCallback("INFO", "Archivas node started successfully")
+	ready()
 	callLogCallback("INFO", "Waiting for farmers to submit blocks...")
 
 	// Heartbeat loop with IBD health check
@@ -1719,13 +1841,9 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 		case <-ctx.Done():
 			return nil
 		case <-ticker.C:
-			nodeStateMutex.RLock()
-			if nodeState != nil {
-				height := nodeState.CurrentHeight
-				difficulty := nodeState.Consensus.DifficultyTarget
-				callLogCallback("DEBUG", fmt.Sprintf("Node running: height=%d difficulty=%d", height, difficulty))
+			if tip := publishedTip.Load(); tip != nil {
+				nodeLogf("DEBUG", "Node running: height=%d difficulty=%d", tip.Height, tip.ConsensusDifficulty)
 			}
-			nodeStateMutex.RUnlock()
 		case <-ibdHealthTicker.C:
 			// Check if IBD is stuck (no progress in last 5 minutes)
 			ibdRunningMutex.RLock()
@@ -1733,12 +1851,7 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 			ibdRunningMutex.RUnlock()
 
 			if isRunning {
-				nodeStateMutex.RLock()
-				currentHeight := uint64(0)
-				if nodeState != nil {
-					currentHeight = nodeState.CurrentHeight
-				}
-				nodeStateMutex.RUnlock()
+				currentHeight := publishedTipHeight()
 
 				// Check if height has changed
 				if currentHeight == lastIBDHeight {
@@ -1761,47 +1874,75 @@ func startArchivasNode(ctx context.Context, networkID, rpcBind, dataDir, bootnod
 	}
 }
 
-// stopArchivasNode stops the node and cleans up resources
+// stopArchivasNode stops the node and cleans up resources. The state is
+// detached under nodeStateMutex and torn down after releasing it: P2P.Stop and
+// DB.Close can take seconds, and the GUI's status poll takes the read lock.
 func stopArchivasNode() {
 	nodeStateMutex.Lock()
-	defer nodeStateMutex.Unlock()
+	ns := nodeState
+	nodeState = nil
+	nodeStateMutex.Unlock()
 
-	if nodeState == nil {
+	if ns == nil {
 		return
 	}
 
 	callLogCallback("INFO", "Stopping Archivas node...")
+	publishedTip.Store(nil)
+	markTipChanged()
 
 	// Stop P2P network
-	if nodeState.P2P != nil {
-		nodeState.P2P.Stop()
+	if ns.P2P != nil {
+		ns.P2P.Stop()
 	}
 
 	// Close database
-	if nodeState.DB != nil {
-		nodeState.DB.Close()
+	if ns.DB != nil {
+		ns.DB.Close()
 	}
 
-	nodeState = nil
 	callLogCallback("INFO", "Archivas node stopped and cleaned up")
 }
 
+// setNodeService records and reports a node lifecycle change. Caller must hold nodeMutex.
+func setNodeService(state C.int) {
+	if nodeService != state {
+		nodeService = state
+		emitNodeState(state)
+	}
+}
+
 //export archivas_node_stop
 func archivas_node_stop() {
 	nodeMutex.Lock()
 	defer nodeMutex.Unlock()
 
-	if !nodeRunning {
+	if nodeService != C.ARCHIVAS_SERVICE_STARTING && nodeService != C.ARCHIVAS_SERVICE_RUNNING {
 		return
 	}
 
 	callLogCallback("INFO", "Stopping Archivas node...")
+	setNodeService(C.ARCHIVAS_SERVICE_STOPPING)
 
+	// Teardown happens on the node goroutine, which reports STOPPED when done
 	if nodeCancel != nil {
 		nodeCancel()
 	}
+}
 
-	nodeRunning = false
+//export archivas_node_get_state
+func archivas_node_get_state() C.int {
+	nodeMutex.RLock()
+	defer nodeMutex.RUnlock()
+	return nodeService
+}
+
+//export archivas_node_wait_stopped
+func archivas_node_wait_stopped(timeoutMs C.int) C.int {
+	nodeMutex.RLock()
+	done := nodeDone
+	nodeMutex.RUnlock()
+	return waitDone(done, timeoutMs)
 }
 
 //export archivas_node_is_running
@@ -1817,40 +1958,48 @@ func archivas_node_is_running() C.int {
 
 //export archivas_node_get_height
 func archivas_node_get_height() C.int {
-	nodeStateMutex.RLock()
-	defer nodeStateMutex.RUnlock()
+	return C.int(publishedTipHeight())
+}
 
-	if nodeState == nil {
+//export archivas_node_get_height_into
+func archivas_node_get_height_into(out *C.uint64_t) C.int {
+	if out == nil {
+		return -1
+	}
+	tip := publishedTip.Load()
+	if tip == nil {
+		*out = 0
 		return 0
 	}
-	return C.int(nodeState.CurrentHeight)
+	*out = C.uint64_t(tip.Height)
+	return 1
 }
 
 //export archivas_node_get_tip_hash
 func archivas_node_get_tip_hash() *C.char {
-	nodeStateMutex.RLock()
-	defer nodeStateMutex.RUnlock()
-
-	if nodeState == nil || len(nodeState.Chain) == 0 {
+	tip := publishedTip.Load()
+	if tip == nil || !tip.HasChain {
 		hash := "0000000000000000000000000000000000000000000000000000000000000000"
 		return C.CString(hash)
 	}
 
-	// Get tip block
-	tipBlock := nodeState.Chain[len(nodeState.Chain)-1]
-	hash := hashBlock(&tipBlock)
+	hashStr := hex.EncodeToString(tip.Hash[:])
+	return C.CString(hashStr)
+}
 
-	// Use cached network hash if available (for blocks without proof)
-	networkHashMutex.RLock()
-	if networkBlockHashes != nil {
-		if cachedHash, ok := networkBlockHashes[tipBlock.Height]; ok {
-			hash = cachedHash
-		}
+//export archivas_node_get_tip_hash_into
+func archivas_node_get_tip_hash_into(out *C.uint8_t) C.int {
+	if out == nil {
+		return -1
 	}
-	networkHashMutex.RUnlock()
-
-	hashStr := hex.EncodeToString(hash[:])
-	return C.CString(hashStr)
+	dst := unsafe.Slice((*byte)(unsafe.Pointer(out)), 32)
+	tip := publishedTip.Load()
+	if tip == nil || !tip.HasChain {
+		clear(dst)
+		return 0
+	}
+	copy(dst, tip.Hash[:])
+	return 1
 }
 
 //export archivas_node_get_peer_count
@@ -1864,6 +2013,93 @@ func archivas_node_get_peer_count() C.int {
 	return C.int(nodeState.P2P.GetPeerCount())
 }
 
+// Go names for the snapshot type and version, for code that cannot import "C" (tests)
+type statusSnapshot = C.archivas_status_snapshot
+
+const statusSnapshotVersion = C.ARCHIVAS_STATUS_SNAPSHOT_VERSION
+
+// archivas_get_status_snapshot fills out from the published tip and the
+// per-subsystem state. Each group is read under its own lock (or atomically,
+// for the tip) rather than all locks at once: holding every lock together
+// would make the GUI poll wait on block application again. The header spells
+// out which fields can be one update apart.
+//
+//export archivas_get_status_snapshot
+func archivas_get_status_snapshot(out *C.archivas_status_snapshot) C.int {
+	if out == nil || out.version != C.ARCHIVAS_STATUS_SNAPSHOT_VERSION {
+		return -1
+	}
+
+	var snap C.archivas_status_snapshot
+	snap.version = C.ARCHIVAS_STATUS_SNAPSHOT_VERSION
+
+	nodeMutex.RLock()
+	if nodeRunning {
+		snap.flags |= C.ARCHIVAS_STATUS_NODE_RUNNING
+	}
+	nodeMutex.RUnlock()
+
+	if tip := publishedTip.Load(); tip != nil {
+		height, difficulty, tipHash := tip.status()
+		snap.height = C.uint64_t(height)
+		snap.difficulty = C.uint64_t(difficulty)
+		for i, b := range tipHash {
+			snap.tip_hash[i] = C.uint8_t(b)
+		}
+	}
+
+	nodeStateMutex.RLock()
+	if nodeState != nil {
+		if nodeState.P2P != nil {
+			snap.peer_count = C.int32_t(nodeState.P2P.GetPeerCount())
+		}
+	}
+	nodeStateMutex.RUnlock()
+
+	ibdRunningMutex.RLock()
+	if ibdRunning {
+		snap.flags |= C.ARCHIVAS_STATUS_IBD_RUNNING
+	}
+	ibdRunningMutex.RUnlock()
+
+	ibdProgressMutex.RLock()
+	snap.ibd_target_height = C.uint64_t(ibdTargetHeight)
+	ibdProgressMutex.RUnlock()
+
+	farmerMutex.RLock()
+	if farmerRunning {
+		snap.flags |= C.ARCHIVAS_STATUS_FARMER_RUNNING
+	}
+	farmerMutex.RUnlock()
+
+	farmerStateMutex.RLock()
+	if farmerState != nil {
+		snap.plot_count = C.int32_t(len(farmerState.Plots))
+		if farmerState.LastProof != nil {
+			snap.flags |= C.ARCHIVAS_STATUS_HAS_PROOF
+			snap.last_proof_quality = C.uint64_t(farmerState.LastProof.Quality)
+			for i, b := range farmerState.LastProof.Hash {
+				snap.last_proof_hash[i] = C.uint8_t(b)
+			}
+			snap.last_proof_time = C.int64_t(farmerState.LastProofTime.Unix())
+		}
+	}
+	farmerStateMutex.RUnlock()
+
+	// Bump the sequence number only when the content actually changed, so callers
+	// can skip redrawing when nothing happened since their last snapshot
+	statusSnapshotMutex.Lock()
+	if snap != lastStatusSnapshot {
+		statusSequence++
+		lastStatusSnapshot = snap
+	}
+	snap.sequence = C.uint64_t(statusSequence)
+	statusSnapshotMutex.Unlock()
+
+	*out = snap
+	return 0
+}
+
 //export archivas_node_set_log_callback
 func archivas_node_set_log_callback(callback C.log_callback_t) {
 	logCallbackMutex.Lock()
@@ -1875,58 +2111,87 @@ func archivas_node_set_log_callback(callback C.log_callback_t) {
 
 // GetStatus returns current height, difficulty, and tip hash (for p2p.NodeHandler)
 func (ns *NodeState) GetStatus() (uint64, uint64, [32]byte) {
-	ns.RLock()
-	defer ns.RUnlock()
+	return ns.loadTip().status()
+}
 
+// buildTip captures the current chain tip. Caller must hold ns's lock.
+func (ns *NodeState) buildTip() *tipSnapshot {
+	tip := &tipSnapshot{Height: ns.CurrentHeight}
+	if ns.Consensus != nil {
+		tip.ConsensusDifficulty = ns.Consensus.DifficultyTarget
+	}
 	if len(ns.Chain) == 0 {
-		// If no chain, try to get network difficulty from cache
-		networkDifficultyMutex.RLock()
-		networkDiff := networkDifficulty
-		networkDifficultyMutex.RUnlock()
-		if networkDiff > 0 {
-			return 0, networkDiff, [32]byte{}
-		}
-		return 0, ns.Consensus.DifficultyTarget, [32]byte{}
+		return tip
 	}
 
-	tipBlock := ns.Chain[len(ns.Chain)-1]
-	tipHash := hashBlock(&tipBlock)
+	tipBlock := &ns.Chain[len(ns.Chain)-1]
+	tip.HasChain = true
+	tip.TipDifficulty = tipBlock.Difficulty
+	tip.Hash = tipBlock.Hash()
+	tip.TimestampUnix = tipBlock.TimestampUnix
+	tip.PrevHash = tipBlock.PrevHash
+	tip.TxCount = len(tipBlock.Txs)
+	tip.FarmerAddr = tipBlock.FarmerAddr
 
-	// Use cached network hash if available (for blocks without proof)
-	networkHashMutex.RLock()
-	if networkBlockHashes != nil {
-		if cachedHash, ok := networkBlockHashes[tipBlock.Height]; ok {
-			tipHash = cachedHash
-		}
+	return tip
+}
+
+// publishTip swaps in a new tip snapshot for lock-free readers. Caller must
+// hold ns's write lock (or own ns exclusively) so the snapshot matches the chain.
+func (ns *NodeState) publishTip() {
+	tip := ns.buildTip()
+	prev := publishedTip.Swap(tip)
+	if prev == nil || prev.Height != tip.Height || prev.Hash != tip.Hash ||
+		prev.TipDifficulty != tip.TipDifficulty || prev.ConsensusDifficulty != tip.ConsensusDifficulty {
+		markTipChanged()
 	}
-	networkHashMutex.RUnlock()
+}
 
-	// Use difficulty from tip block if available (most accurate)
-	// Otherwise fall back to consensus difficulty or network difficulty
-	tipDifficulty := ns.Consensus.DifficultyTarget
+// loadTip returns the published tip, building one under the read lock if
+// nothing has been published for ns yet
+func (ns *NodeState) loadTip() *tipSnapshot {
+	if tip := publishedTip.Load(); tip != nil {
+		return tip
+	}
+	ns.RLock()
+	defer ns.RUnlock()
+	return ns.buildTip()
+}
 
-	// If we have a tip block, use its difficulty (this is the actual network difficulty at that height)
-	if len(ns.Chain) > 0 {
-		tipDifficulty = tipBlock.Difficulty
+// publishedTipHeight returns the published tip height, or 0 if the node is stopped
+func publishedTipHeight() uint64 {
+	if tip := publishedTip.Load(); tip != nil {
+		return tip.Height
+	}
+	return 0
+}
+
+// status returns height, difficulty, and tip hash as reported by GetStatus
+func (tip *tipSnapshot) status() (uint64, uint64, [32]byte) {
+	networkDifficultyMutex.RLock()
+	networkDiff := networkDifficulty
+	networkDiffTime := networkDifficultyTime
+	networkDifficultyMutex.RUnlock()
+
+	if !tip.HasChain {
+		// If no chain, try to get network difficulty from cache
+		if networkDiff > 0 {
+			return 0, networkDiff, [32]byte{}
+		}
+		return 0, tip.ConsensusDifficulty, [32]byte{}
 	}
 
-	// If significantly behind network and no blocks yet, use network difficulty from cache
-	if tipDifficulty == 0 || (len(ns.Chain) == 0 || ns.CurrentHeight < 100) {
-		networkDifficultyMutex.RLock()
-		networkDiff := networkDifficulty
-		networkDiffTime := networkDifficultyTime
-		networkDifficultyMutex.RUnlock()
+	// Use difficulty from tip block (this is the actual network difficulty at that height)
+	tipDifficulty := tip.TipDifficulty
 
-		// Use network difficulty if:
-		// 1. We have cached network difficulty
-		// 2. Cache is recent (less than 5 minutes old)
-		// 3. Local chain is empty or very early in sync
+	// If very early in sync, prefer a recent (less than 5 minutes old) network difficulty
+	if tipDifficulty == 0 || tip.Height < 100 {
 		if networkDiff > 0 && time.Since(networkDiffTime) < 5*time.Minute {
-			return ns.CurrentHeight, networkDiff, tipHash
+			return tip.Height, networkDiff, tip.Hash
 		}
 	}
 
-	return ns.CurrentHeight, tipDifficulty, tipHash
+	return tip.Height, tipDifficulty, tip.Hash
 }
 
 // OnNewBlock is called when a peer announces a new block (for p2p.NodeHandler)
@@ -1988,6 +2253,7 @@ func (ns *NodeState) OnNewBlock(height uint64, hash [32]byte, fromPeer string) {
 					ibdRunningMutex.Lock()
 					ibdRunning = true
 					ibdRunningMutex.Unlock()
+					emitSyncStage(C.ARCHIVAS_SYNC_RUNNING, currentHeight, height)
 					callLogCallback("INFO", fmt.Sprintf("Starting IBD from seed.archivas.ai (we're %d blocks behind)", gap))
 					// Don't call P2P.StartIBD - we use HTTP-based IBD via RunIBDWithRetry instead
 					// P2P.StartIBD uses batch requests which are getting empty responses
@@ -2021,6 +2287,7 @@ func (ns *NodeState) OnBlockRequest(height uint64) (interface{}, error) {
 	if ns.BlockStore != nil {
 		var block Block
 		if err := ns.BlockStore.LoadBlock(height, &block); err == nil {
+			block.sealHash()
 			return block, nil
 		}
 	}
@@ -2108,16 +2375,12 @@ func (ns *NodeState) UpdateVDFState(seed []byte, iterations uint64, output []byt
 
 // LocalHeight returns current chain height (for p2p.NodeHandler)
 func (ns *NodeState) LocalHeight() uint64 {
-	ns.RLock()
-	defer ns.RUnlock()
-	return ns.CurrentHeight
+	return ns.loadTip().Height
 }
 
 // GetCurrentHeight returns the current chain height (for node.NodeIBDInterface)
 func (ns *NodeState) GetCurrentHeight() uint64 {
-	ns.RLock()
-	defer ns.RUnlock()
-	return ns.CurrentHeight
+	return ns.loadTip().Height
 }
 
 // GetCurrentChallenge returns the current challenge, difficulty, and next height (for rpc.NodeState)
@@ -2170,8 +2433,8 @@ func (ns *NodeState) GetRecentBlocks(count int) interface{} {
 	recentBlocks := make([]map[string]interface{}, 0, count)
 
 	for i := start; i < chainLen; i++ {
-		block := ns.Chain[i]
-		blockHash := hashBlock(&block)
+		block := &ns.Chain[i]
+		blockHash := block.Hash()
 
 		formattedTxs := make([]map[string]interface{}, len(block.Txs))
 		for j, tx := range block.Txs {
@@ -2242,6 +2505,7 @@ func (ns *NodeState) VerifyAndApplyBlock(blockJSON json.RawMessage) error {
 	if err := json.Unmarshal(blockJSON, &block); err != nil {
 		return fmt.Errorf("failed to unmarshal block: %w", err)
 	}
+	block.sealHash()
 
 	ns.Lock()
 	defer ns.Unlock()
@@ -2251,18 +2515,8 @@ func (ns *NodeState) VerifyAndApplyBlock(blockJSON json.RawMessage) error {
 	}
 
 	if len(ns.Chain) > 0 {
-		prevBlock := ns.Chain[len(ns.Chain)-1]
-		prevHash := hashBlock(&prevBlock)
-
-		// If we have a cached network hash for the previous block (because proof was missing),
-		// use that instead of the calculated hash
-		networkHashMutex.RLock()
-		if networkBlockHashes != nil {
-			if cachedHash, ok := networkBlockHashes[prevBlock.Height]; ok {
-				prevHash = cachedHash
-			}
-		}
-		networkHashMutex.RUnlock()
+		// Cached hash, including any network hash override for the previous block
+		prevHash := ns.Chain[len(ns.Chain)-1].Hash()
 
 		if block.PrevHash != prevHash {
 			// Prev hash mismatch indicates wrong chain - this block should be rejected
@@ -2272,8 +2526,7 @@ func (ns *NodeState) VerifyAndApplyBlock(blockJSON json.RawMessage) error {
 	} else {
 		// Check genesis hash for first block
 		if block.Height == 0 {
-			genesisHash := hashBlock(&block)
-			if genesisHash != ns.GenesisHash {
+			if block.Hash() != ns.GenesisHash {
 				return fmt.Errorf("genesis hash mismatch (wrong chain)")
 			}
 		}
@@ -2297,6 +2550,7 @@ func (ns *NodeState) VerifyAndApplyBlock(blockJSON json.RawMessage) error {
 
 	ns.Chain = append(ns.Chain, block)
 	ns.CurrentHeight = block.Height
+	ns.publishTip()
 
 	if ns.BlockStore != nil {
 		if err := ns.BlockStore.SaveBlock(block.Height, block); err != nil {
@@ -2330,8 +2584,8 @@ func (ns *NodeState) GetBlockByHeight(height uint64) (interface{}, error) {
 		return nil, fmt.Errorf("block %d not found (tip: %d)", height, len(ns.Chain)-1)
 	}
 
-	block := ns.Chain[height]
-	blockHash := hashBlock(&block)
+	block := &ns.Chain[height]
+	blockHash := block.Hash()
 
 	formattedTxs := make([]map[string]interface{}, len(block.Txs))
 	for i, tx := range block.Txs {
@@ -2378,24 +2632,6 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 		return fmt.Errorf("failed to unmarshal block map: %w", err)
 	}
 
-	// Log received block info for debugging
-	if height, ok := blockMap["height"].(float64); ok {
-		hashFromNetwork, _ := blockMap["hash"].(string)
-		prevHashFromNetwork, _ := blockMap["prevHash"].(string)
-		difficultyFromNetwork, _ := blockMap["difficulty"].(float64)
-		timestampFromNetwork, _ := blockMap["timestamp"].(float64)
-		hashShort := hashFromNetwork
-		if len(hashShort) > 16 {
-			hashShort = hashShort[:16]
-		}
-		prevHashShort := prevHashFromNetwork
-		if len(prevHashShort) > 16 {
-			prevHashShort = prevHashShort[:16]
-		}
-		callLogCallback("DEBUG", fmt.Sprintf("IBD: Received block height %d from network: hash=%s, prevHash=%s, difficulty=%.0f, timestamp=%.0f",
-			uint64(height), hashShort, prevHashShort, difficultyFromNetwork, timestampFromNetwork))
-	}
-
 	// Verify this block is from IBD (seed.archivas.ai) - reject if from other sources
 	// During IBD, all blocks come from seed.archivas.ai, so we can trust them
 	// But we still verify prev hash to detect forks
@@ -2408,9 +2644,17 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 	difficulty, _ := blockMap["difficulty"].(float64)
 	timestamp, _ := blockMap["timestamp"].(float64)
 	farmerAddr, _ := blockMap["farmerAddr"].(string)
+	hashFromNetwork, _ := blockMap["hash"].(string)
+	prevHashStr, hasPrevHash := blockMap["prevHash"].(string)
+
+	// Log received block info for debugging
+	if nodeDebugEnabled() {
+		nodeLogf("DEBUG", "IBD: Received block height %d from network: hash=%.16s, prevHash=%.16s, difficulty=%.0f, timestamp=%.0f",
+			uint64(height), hashFromNetwork, prevHashStr, difficulty, timestamp)
+	}
 
 	var prevHash, challenge [32]byte
-	if prevHashStr, ok := blockMap["prevHash"].(string); ok {
+	if hasPrevHash {
 		prevHashBytes, _ := hex.DecodeString(prevHashStr)
 		copy(prevHash[:], prevHashBytes)
 	}
@@ -2493,8 +2737,10 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 			// Use the block's challenge for the proof
 			proof.Challenge = challenge
 
-			callLogCallback("DEBUG", fmt.Sprintf("Block %d: parsed proof (hash=%x, quality=%d, plotID=%x)",
-				uint64(height), proof.Hash[:8], proof.Quality, proof.PlotID[:8]))
+			if nodeDebugEnabled() {
+				nodeLogf("DEBUG", "Block %d: parsed proof (hash=%x, quality=%d, plotID=%x)",
+					uint64(height), proof.Hash[:8], proof.Quality, proof.PlotID[:8])
+			}
 		} else {
 			callLogCallback("ERROR", fmt.Sprintf("Block %d: proof field is not a map (type: %T)", uint64(height), proofRaw))
 			return fmt.Errorf("block %d: proof field has invalid type", uint64(height))
@@ -2534,8 +2780,8 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 		if hashBytes, err := hex.DecodeString(expectedHashStr); err == nil && len(hashBytes) == 32 {
 			copy(expectedHash[:], hashBytes)
 
-			// Calculate hash with all fields including proof
-			calculatedHash := hashBlock(&block)
+			// Calculate hash with all fields including proof (cached on the block from here on)
+			calculatedHash := block.sealHash()
 
 			if calculatedHash != expectedHash {
 				// Hash mismatch - log detailed error information
@@ -2552,13 +2798,18 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 				return fmt.Errorf("block %d hash mismatch: expected %x, got %x (block data may be corrupted or incomplete)",
 					block.Height, expectedHash[:8], calculatedHash[:8])
 			}
-			callLogCallback("DEBUG", fmt.Sprintf("Block %d hash verified: %x", block.Height, calculatedHash[:8]))
+			if nodeDebugEnabled() {
+				nodeLogf("DEBUG", "Block %d hash verified: %x", block.Height, calculatedHash[:8])
+			}
 		} else {
 			callLogCallback("WARN", fmt.Sprintf("Block %d: invalid hash format in response", block.Height))
 		}
 	} else {
 		callLogCallback("WARN", fmt.Sprintf("Block %d: hash field missing from /blocks/range response", block.Height))
 	}
+	if !block.sealed {
+		block.sealHash()
+	}
 
 	ns.Lock()
 	unlockNeeded := true
@@ -2572,9 +2823,8 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 	if block.Height == 0 {
 		// If we already have a genesis block, verify it matches
 		if len(ns.Chain) > 0 && ns.Chain[0].Height == 0 {
-			existingGenesis := ns.Chain[0]
-			existingGenesisHash := hashBlock(&existingGenesis)
-			newBlockHash := hashBlock(&block)
+			existingGenesisHash := ns.Chain[0].Hash()
+			newBlockHash := block.Hash()
 			if existingGenesisHash != newBlockHash {
 				callLogCallback("WARN", fmt.Sprintf("Genesis block mismatch - existing: %x, received: %x",
 					existingGenesisHash[:8], newBlockHash[:8]))
@@ -2584,7 +2834,7 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 			return nil
 		}
 		// No genesis block yet - accept this one
-		genesisBlockHash := hashBlock(&block)
+		genesisBlockHash := block.Hash()
 		callLogCallback("INFO", fmt.Sprintf("Applying genesis block (height 0, hash: %x)", genesisBlockHash[:8]))
 	} else {
 		// Non-genesis block - check if we have genesis first
@@ -2601,19 +2851,8 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 		}
 
 		// Verify prev hash matches (prevents accepting blocks from forked chain)
-		prevBlock := ns.Chain[len(ns.Chain)-1]
-		prevHash := hashBlock(&prevBlock)
-
-		// If we have a cached network hash for the previous block (because proof was missing),
-		// use that instead of the calculated hash
-		networkHashMutex.RLock()
-		if networkBlockHashes != nil {
-			if cachedHash, ok := networkBlockHashes[prevBlock.Height]; ok {
-				prevHash = cachedHash
-				callLogCallback("DEBUG", fmt.Sprintf("Using cached network hash for block %d: %x (prevHash check)", prevBlock.Height, prevHash[:8]))
-			}
-		}
-		networkHashMutex.RUnlock()
+		// Cached hash, including any network hash override for the previous block
+		prevHash := ns.Chain[len(ns.Chain)-1].Hash()
 
 		if block.PrevHash != prevHash {
 			callLogCallback("ERROR", fmt.Sprintf("FORK DETECTED at height %d: prev hash mismatch", block.Height))
@@ -2672,16 +2911,17 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 
 	// CRITICAL: Check if we already have a block at this height (prevent duplicates)
 	if int(block.Height) < len(ns.Chain) {
-		existingBlock := ns.Chain[block.Height]
-		existingHash := hashBlock(&existingBlock)
-		newHash := hashBlock(&block)
+		existingHash := ns.Chain[block.Height].Hash()
+		newHash := block.Hash()
 		if existingHash != newHash {
 			callLogCallback("ERROR", fmt.Sprintf("Block %d already exists with different hash! Existing: %x, New: %x",
 				block.Height, existingHash[:8], newHash[:8]))
 			return fmt.Errorf("block %d already exists with different hash (duplicate block creation detected)", block.Height)
 		}
 		// Same block, skip
-		callLogCallback("DEBUG", fmt.Sprintf("Block %d already exists (hash: %x), skipping duplicate", block.Height, existingHash[:8]))
+		if nodeDebugEnabled() {
+			nodeLogf("DEBUG", "Block %d already exists (hash: %x), skipping duplicate", block.Height, existingHash[:8])
+		}
 		return nil
 	}
 
@@ -2692,20 +2932,10 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 	}
 
 	// Apply block to chain
-	// Use network hash if available (for blocks without proof), otherwise calculate
-	blockHash := hashBlock(&block)
-	networkHashMutex.RLock()
-	if networkBlockHashes != nil {
-		if cachedHash, ok := networkBlockHashes[block.Height]; ok {
-			blockHash = cachedHash
-			callLogCallback("DEBUG", fmt.Sprintf("Applying block %d (using network hash: %x, prevHash: %x)", block.Height, blockHash[:8], block.PrevHash[:8]))
-		} else {
-			callLogCallback("DEBUG", fmt.Sprintf("Applying block %d (calculated hash: %x, prevHash: %x)", block.Height, blockHash[:8], block.PrevHash[:8]))
-		}
-	} else {
-		callLogCallback("DEBUG", fmt.Sprintf("Applying block %d (calculated hash: %x, prevHash: %x)", block.Height, blockHash[:8], block.PrevHash[:8]))
+	if nodeDebugEnabled() {
+		blockHash := block.Hash()
+		nodeLogf("DEBUG", "Applying block %d (hash: %x, prevHash: %x)", block.Height, blockHash[:8], block.PrevHash[:8])
 	}
-	networkHashMutex.RUnlock()
 	ns.Chain = append(ns.Chain, block)
 	ns.CurrentHeight = block.Height
 
@@ -2714,8 +2944,8 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 	if block.Difficulty > 0 {
 		oldDiff := ns.Consensus.DifficultyTarget
 		ns.Consensus.DifficultyTarget = block.Difficulty
-		if oldDiff != block.Difficulty && block.Height > 0 {
-			callLogCallback("DEBUG", fmt.Sprintf("Updated difficulty from block %d: %d → %d", block.Height, oldDiff, block.Difficulty))
+		if oldDiff != block.Difficulty && block.Height > 0 && nodeDebugEnabled() {
+			nodeLogf("DEBUG", "Updated difficulty from block %d: %d → %d", block.Height, oldDiff, block.Difficulty)
 		}
 		// Save updated difficulty to disk
 		if ns.MetaStore != nil {
@@ -2724,6 +2954,7 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 			}
 		}
 	}
+	ns.publishTip()
 
 	// Update IBD progress tracking
 	ibdProgressMutex.Lock()
@@ -2735,7 +2966,7 @@ func (ns *NodeState) ApplyBlock(blockData json.RawMessage) error {
 
 	// Update genesis hash if this is the genesis block
 	if block.Height == 0 {
-		genesisHash := hashBlock(&block)
+		genesisHash := block.Hash()
 		ns.GenesisHash = genesisHash
 		if ns.MetaStore != nil {
 			if err := ns.MetaStore.SaveGenesisHash(genesisHash); err != nil {
@@ -2825,8 +3056,7 @@ func (ns *NodeState) AcceptBlock(proof *pospace.Proof, farmerAddr string, farmer
 
 	var prevHash [32]byte
 	if nextHeight > 0 {
-		prevBlock := ns.Chain[len(ns.Chain)-1]
-		prevHash = hashBlock(&prevBlock)
+		prevHash = ns.Chain[len(ns.Chain)-1].Hash()
 	}
 
 	newBlock := Block{
@@ -2839,12 +3069,12 @@ func (ns *NodeState) AcceptBlock(proof *pospace.Proof, farmerAddr string, farmer
 		Proof:         proof,
 		FarmerAddr:    farmerAddr,
 	}
+	newBlockHash := newBlock.sealHash()
 
 	ns.Chain = append(ns.Chain, newBlock)
 	ns.CurrentHeight = nextHeight
 	ns.Mempool.Clear()
 
-	newBlockHash := hashBlock(&newBlock)
 	ns.CurrentChallenge = consensus.GenerateChallenge(newBlockHash, nextHeight+1)
 
 	if ns.Consensus.DifficultyTarget > 1_000_000 {
@@ -2855,6 +3085,7 @@ func (ns *NodeState) AcceptBlock(proof *pospace.Proof, farmerAddr string, farmer
 		}
 		callLogCallback("INFO", fmt.Sprintf("Difficulty dropped: %d → %d", oldDiff, ns.Consensus.DifficultyTarget))
 	}
+	ns.publishTip()
 
 	if ns.BlockStore != nil {
 		if err := ns.BlockStore.SaveBlock(nextHeight, newBlock); err != nil {
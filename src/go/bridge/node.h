@@ -1,20 +1,78 @@
 #ifndef ARCHIVAS_NODE_BRIDGE_H
 #define ARCHIVAS_NODE_BRIDGE_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Node lifecycle
+// Node lifecycle. Start and stop return immediately; progress is reported as
+// ARCHIVAS_EVENT_NODE_STATE events (see events.h).
+// Start returns 0 if startup began, 1 if the node is already running or still stopping.
 int archivas_node_start(char* network_id, char* rpc_bind, char* data_dir, char* bootnodes, char* genesis_path);
 void archivas_node_stop();
 int archivas_node_is_running();
+int archivas_node_get_state();  // ARCHIVAS_SERVICE_*
+
+// Address ("host:port") for the node's Server-Sent Events feed of new blocks,
+// tips and mempool transactions (GET /events). Takes effect on the next start;
+// empty disables the feed.
+void archivas_node_set_stream_bind(char* bind);
+
+// Blocks until node teardown has finished or timeout_ms elapses (negative waits
+// forever). Returns 1 if stopped, 0 on timeout. Meant for process exit only.
+int archivas_node_wait_stopped(int timeout_ms);
 
 // Status queries
+// Truncated to int; prefer the _into variant
 int archivas_node_get_height();
-char* archivas_node_get_tip_hash();
+
+// Writes the full 64-bit tip height to out. Returns 1 on success, 0 if out was
+// set to 0 because the node has no published tip (stopped or still loading),
+// -1 if out is NULL
+int archivas_node_get_height_into(uint64_t* out);
 int archivas_node_get_peer_count();
 
+// Returns a malloc'd hex string the caller must free(); prefer the _into variant
+char* archivas_node_get_tip_hash();
+
+// Copies the raw 32-byte tip hash into out without allocating. Returns 1 if the
+// node has a chain, 0 if out was zero-filled because it has none, -1 if out is NULL
+int archivas_node_get_tip_hash_into(uint8_t* out);
+
+// Status snapshot (node and farmer state filled by a single call)
+#define ARCHIVAS_STATUS_SNAPSHOT_VERSION 1
+
+#define ARCHIVAS_STATUS_NODE_RUNNING   0x1
+#define ARCHIVAS_STATUS_FARMER_RUNNING 0x2
+#define ARCHIVAS_STATUS_IBD_RUNNING    0x4
+#define ARCHIVAS_STATUS_HAS_PROOF      0x8
+
+typedef struct archivas_status_snapshot {
+    uint32_t version;            // Set by caller to ARCHIVAS_STATUS_SNAPSHOT_VERSION
+    uint32_t flags;              // ARCHIVAS_STATUS_* bits
+    uint64_t sequence;           // Increases every time any other field changes
+    uint64_t height;
+    uint8_t  tip_hash[32];
+    uint64_t difficulty;
+    int32_t  peer_count;
+    int32_t  plot_count;
+    uint64_t ibd_target_height;  // Remote tip height while syncing (0 if unknown)
+    uint64_t last_proof_quality;
+    uint8_t  last_proof_hash[32];
+    int64_t  last_proof_time;    // Unix seconds (0 if no proof yet)
+} archivas_status_snapshot;
+
+// Returns 0 on success, -1 if out is NULL or out->version is not supported.
+// Fields are consistent within their group, not across groups: height,
+// tip_hash and difficulty come from one published tip, and the last_proof_*
+// fields from one farmer update. Flags, peer_count, plot_count and
+// ibd_target_height are each read on their own, so a field may be one update
+// ahead of another (e.g. a new height with IBD_RUNNING from just before). The
+// next snapshot catches up, and sequence changes when it does.
+int archivas_get_status_snapshot(archivas_status_snapshot* out);
+
 // Logging callback
 typedef void (*log_callback_t)(char* level, char* message);
 void archivas_node_set_log_callback(log_callback_t callback);
@@ -24,4 +82,3 @@ void archivas_node_set_log_callback(log_callback_t callback);
 #endif
 
 #endif // ARCHIVAS_NODE_BRIDGE_H
-
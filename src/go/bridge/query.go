@@ -0,0 +1,168 @@
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}
+#include "query.h"
+*/
+import "C"
+import (
+	"unsafe"
+)
+
+// setCString copies s into dst, truncating and NUL-terminating it
+func setCString(dst []C.char, s string) {
+	n := len(s)
+	if n > len(dst)-1 {
+		n = len(dst) - 1
+	}
+	for i := 0; i < n; i++ {
+		dst[i] = C.char(s[i])
+	}
+	dst[n] = 0
+}
+
+// Go names for the record types, for code that cannot import "C" (tests)
+type blockRecord = C.archivas_block_record
+type txRecord = C.archivas_tx_record
+
+// runningNodeState returns the node state, or nil while the node is stopped
+func runningNodeState() *NodeState {
+	nodeStateMutex.RLock()
+	defer nodeStateMutex.RUnlock()
+	return nodeState
+}
+
+func fillBlockRecord(rec *C.archivas_block_record, b *Block) {
+	rec.height = C.uint64_t(b.Height)
+	rec.timestamp = C.int64_t(b.TimestampUnix)
+	rec.difficulty = C.uint64_t(b.Difficulty)
+	hash := b.Hash()
+	for i, v := range hash {
+		rec.hash[i] = C.uint8_t(v)
+	}
+	for i, v := range b.PrevHash {
+		rec.prev_hash[i] = C.uint8_t(v)
+	}
+	rec.tx_count = C.uint32_t(len(b.Txs))
+	rec.reserved = 0
+	setCString(rec.farmer_addr[:], b.FarmerAddr)
+}
+
+//export archivas_node_get_blocks
+func archivas_node_get_blocks(from C.uint64_t, count C.int, out *C.archivas_block_record) C.int {
+	ns := runningNodeState()
+	if ns == nil {
+		return -1
+	}
+	if out == nil || count <= 0 {
+		return 0
+	}
+	dst := unsafe.Slice(out, int(count))
+
+	ns.RLock()
+	defer ns.RUnlock()
+
+	n := 0
+	for h := uint64(from); n < len(dst) && h < uint64(len(ns.Chain)); h++ {
+		fillBlockRecord(&dst[n], &ns.Chain[h])
+		n++
+	}
+	return C.int(n)
+}
+
+//export archivas_node_get_recent_txs
+func archivas_node_get_recent_txs(limit C.int, out *C.archivas_tx_record) C.int {
+	ns := runningNodeState()
+	if ns == nil {
+		return -1
+	}
+	if out == nil || limit <= 0 {
+		return 0
+	}
+	dst := unsafe.Slice(out, int(limit))
+
+	ns.RLock()
+	defer ns.RUnlock()
+
+	n := 0
+	for i := len(ns.Chain) - 1; i >= 0 && n < len(dst); i-- {
+		b := &ns.Chain[i]
+		for j := len(b.Txs) - 1; j >= 0 && n < len(dst); j-- {
+			fillTxRecord(&dst[n], b, j)
+			n++
+		}
+	}
+	return C.int(n)
+}
+
+//export archivas_node_get_block_txs
+func archivas_node_get_block_txs(from C.uint64_t, count C.int, out *C.archivas_tx_record, limit C.int) C.int {
+	ns := runningNodeState()
+	if ns == nil {
+		return -1
+	}
+	if out == nil || count <= 0 || limit <= 0 {
+		return 0
+	}
+	dst := unsafe.Slice(out, int(limit))
+
+	ns.RLock()
+	defer ns.RUnlock()
+
+	n := 0
+	end := uint64(from) + uint64(count)
+	for h := uint64(from); h < end && h < uint64(len(ns.Chain)); h++ {
+		b := &ns.Chain[h]
+		if n+len(b.Txs) > len(dst) {
+			break // Whole blocks only
+		}
+		for j := range b.Txs {
+			fillTxRecord(&dst[n], b, j)
+			n++
+		}
+	}
+	return C.int(n)
+}
+
+//export archivas_node_get_tip
+func archivas_node_get_tip(out *C.archivas_block_record) C.int {
+	if out == nil {
+		return -1
+	}
+	tip := publishedTip.Load()
+	if tip == nil {
+		return -1
+	}
+	if !tip.HasChain {
+		return 0
+	}
+	out.height = C.uint64_t(tip.Height)
+	out.timestamp = C.int64_t(tip.TimestampUnix)
+	out.difficulty = C.uint64_t(tip.TipDifficulty)
+	for i, v := range tip.Hash {
+		out.hash[i] = C.uint8_t(v)
+	}
+	for i, v := range tip.PrevHash {
+		out.prev_hash[i] = C.uint8_t(v)
+	}
+	out.tx_count = C.uint32_t(tip.TxCount)
+	out.reserved = 0
+	setCString(out.farmer_addr[:], tip.FarmerAddr)
+	return 1
+}
+
+func fillTxRecord(rec *C.archivas_tx_record, b *Block, j int) {
+	tx := &b.Txs[j]
+	rec.height = C.uint64_t(b.Height)
+	rec.timestamp = C.int64_t(b.TimestampUnix)
+	rec.amount = C.int64_t(tx.Amount)
+	rec.fee = C.int64_t(tx.Fee)
+	rec.nonce = C.uint64_t(tx.Nonce)
+	rec.index = C.uint32_t(j)
+	rec.coinbase = 0
+	if tx.From == "coinbase" {
+		rec.coinbase = 1
+	}
+	setCString(rec.from[:], tx.From)
+	setCString(rec.to[:], tx.To)
+}
@@ -0,0 +1,64 @@
+#ifndef ARCHIVAS_QUERY_BRIDGE_H
+#define ARCHIVAS_QUERY_BRIDGE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// In-process chain queries against the embedded node. These serve the same
+// data as the RPC /blocks/recent and /tx/recent endpoints without going
+// through HTTP and JSON. Strings are NUL-terminated and truncated if longer.
+
+typedef struct archivas_block_record {
+    uint64_t height;
+    int64_t  timestamp;         // Unix seconds
+    uint64_t difficulty;
+    uint8_t  hash[32];
+    uint8_t  prev_hash[32];
+    uint32_t tx_count;
+    uint32_t reserved;
+    char     farmer_addr[64];
+} archivas_block_record;
+
+typedef struct archivas_tx_record {
+    uint64_t height;            // Height of the containing block
+    int64_t  timestamp;         // Block timestamp, Unix seconds
+    int64_t  amount;
+    int64_t  fee;
+    uint64_t nonce;
+    uint32_t index;             // Position within the block
+    uint32_t coinbase;          // 1 for the block reward transaction
+    char     from[64];
+    char     to[64];
+} archivas_tx_record;
+
+// Copies up to count blocks starting at height from, in ascending height
+// order. Returns the number copied (0 if from is above the tip), or -1 if the
+// node is not running.
+//
+// This and the other range copies below take the chain's read lock, so they
+// wait while a block is being applied (disk writes included). Call them off
+// the GUI thread.
+int archivas_node_get_blocks(uint64_t from, int count, archivas_block_record* out);
+
+// Copies the tip block from the published tip, without the chain lock.
+// Returns 1, 0 if the node has no chain yet, or -1 if it is not running.
+int archivas_node_get_tip(archivas_block_record* out);
+
+// Copies up to limit transactions from the newest blocks, newest first.
+// Returns the number copied, or -1 if the node is not running.
+int archivas_node_get_recent_txs(int limit, archivas_tx_record* out);
+
+// Copies the transactions of up to count blocks starting at height from, in
+// chain order. Only whole blocks are copied: the first block whose
+// transactions do not fit in limit ends the copy. Returns the number copied,
+// or -1 if the node is not running.
+int archivas_node_get_block_txs(uint64_t from, int count, archivas_tx_record* out, int limit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARCHIVAS_QUERY_BRIDGE_H
@@ -0,0 +1,118 @@
+package main
+
+import (
+	"bytes"
+	"encoding/json"
+	"math/rand"
+	"net/http"
+	"net/http/httptest"
+	"syscall"
+	"testing"
+
+	"github.com/ArchivasNetwork/archivas/consensus"
+	"github.com/ArchivasNetwork/archivas/ledger"
+)
+
+// One refresh as the Overview, Blocks and Transactions pages ask for it
+const (
+	refreshBlocks = 20
+	refreshTxs    = 50
+)
+
+// installTestNode makes a chain of blockCount blocks with txsPerBlock
+// transactions each the running node, until the test ends
+func installTestNode(tb testing.TB, blockCount, txsPerBlock int) *NodeState {
+	rng := rand.New(rand.NewSource(1))
+	ns := &NodeState{Consensus: &consensus.Consensus{}}
+	for h := 0; h < blockCount; h++ {
+		var prev *Block
+		if h > 0 {
+			prev = &ns.Chain[h-1]
+		}
+		block := testBlock(prev, uint64(h), rng)
+		for i := 0; i < txsPerBlock; i++ {
+			block.Txs = append(block.Txs, ledger.Transaction{
+				From: "arcv1testsender", To: "arcv1testrecipient", Amount: int64(1000 + i), Fee: 10, Nonce: uint64(i),
+			})
+		}
+		ns.Chain = append(ns.Chain, block)
+	}
+	ns.CurrentHeight = uint64(blockCount - 1)
+
+	nodeStateMutex.Lock()
+	nodeState = ns
+	nodeStateMutex.Unlock()
+	ns.publishTip()
+	tb.Cleanup(func() {
+		nodeStateMutex.Lock()
+		nodeState = nil
+		nodeStateMutex.Unlock()
+		publishedTip.Store(nil)
+	})
+	return ns
+}
+
+// processCPU returns the CPU time of the whole process, so the HTTP figure
+// includes the server goroutines as well as the client
+func processCPU() int64 {
+	var usage syscall.Rusage
+	syscall.Getrusage(syscall.RUSAGE_SELF, &usage)
+	return usage.Utime.Nano() + usage.Stime.Nano()
+}
+
+func reportCPU(b *testing.B, start int64) {
+	b.ReportMetric(float64(processCPU()-start)/float64(b.N), "cpu-ns/op")
+}
+
+// BenchmarkRefreshEmbedded is what the client's queryEmbedded* calls copy
+// for one refresh: the tip, the newest blocks and the newest transactions
+func BenchmarkRefreshEmbedded(b *testing.B) {
+	installTestNode(b, 1000, 10)
+	var tip blockRecord
+	blocks := make([]blockRecord, refreshBlocks)
+	txs := make([]txRecord, refreshTxs)
+
+	b.ReportAllocs()
+	cpu := processCPU()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if archivas_node_get_tip(&tip) != 1 {
+			b.Fatal("no tip")
+		}
+		if n := archivas_node_get_blocks(tip.height+1-refreshBlocks, refreshBlocks, &blocks[0]); n != refreshBlocks {
+			b.Fatalf("copied %d blocks", n)
+		}
+		if n := archivas_node_get_recent_txs(refreshTxs, &txs[0]); n != refreshTxs {
+			b.Fatalf("copied %d transactions", n)
+		}
+	}
+	b.StopTimer()
+	reportCPU(b, cpu)
+}
+
+// BenchmarkRefreshHTTP fetches the same data over loopback HTTP from POST
+// /batch, encoding and decoding the JSON as the two ends do
+func BenchmarkRefreshHTTP(b *testing.B) {
+	installTestNode(b, 1000, 10)
+	server := httptest.NewServer(http.HandlerFunc(serveBatch))
+	defer server.Close()
+	body, _ := json.Marshal(batchRequest{ChainTip: true, RecentBlocks: refreshBlocks, RecentTxs: refreshTxs})
+
+	b.ReportAllocs()
+	cpu := processCPU()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		resp, err := http.Post(server.URL, "application/json", bytes.NewReader(body))
+		if err != nil {
+			b.Fatal(err)
+		}
+		var reply batchResponse
+		err = json.NewDecoder(resp.Body).Decode(&reply)
+		resp.Body.Close()
+		if err != nil || reply.ChainTip == nil || len(reply.RecentBlocks) != refreshBlocks || len(reply.RecentTxs) != refreshTxs {
+			b.Fatalf("bad reply: %v", err)
+		}
+	}
+	b.StopTimer()
+	reportCPU(b, cpu)
+}
@@ -0,0 +1,93 @@
+//go:build asan
+
+package main
+
+import (
+	"os"
+	"runtime"
+	"strconv"
+	"strings"
+	"testing"
+	"time"
+
+	"github.com/ArchivasNetwork/archivas/pospace"
+)
+
+// Built only with go test -asan (ctest: ARCHIVAS_SANITIZER_TESTS)
+const (
+	soakPolls   = 1000000
+	soakWarmup  = 100000
+	soakRSSRoom = 4 << 20 // Growth allowed over the run, for the Go heap and ASan's bookkeeping
+)
+
+// residentBytes reads the process's resident set size
+func residentBytes(t *testing.T) int64 {
+	data, err := os.ReadFile("/proc/self/statm")
+	if err != nil {
+		t.Skipf("no /proc/self/statm: %v", err)
+	}
+	fields := strings.Fields(string(data))
+	pages, err := strconv.ParseInt(fields[1], 10, 64)
+	if err != nil {
+		t.Fatal(err)
+	}
+	return pages * int64(os.Getpagesize())
+}
+
+// TestSoakStatusPolls makes the calls the GUI polls with, 1M times, against
+// a running node and farmer. Anything they allocate on the C heap without
+// freeing grows RSS here and is reported by LeakSanitizer at exit.
+func TestSoakStatusPolls(t *testing.T) {
+	installTestNode(t, 100, 10)
+	farmerStateMutex.Lock()
+	farmerState = &FarmerState{
+		LastProof:     &pospace.Proof{Quality: 123456789, Hash: [32]byte{1, 2, 3}},
+		LastProofTime: time.Now(),
+	}
+	farmerStateMutex.Unlock()
+	defer func() {
+		farmerStateMutex.Lock()
+		farmerState = nil
+		farmerStateMutex.Unlock()
+	}()
+
+	// Test files cannot import "C", so the C-typed buffers are borrowed from a
+	// block record's fields
+	var snap statusSnapshot
+	var tip blockRecord
+	height := tip.height
+	hash := tip.hash
+	proof := tip.farmer_addr // 64 bytes
+	poll := func() {
+		snap.version = statusSnapshotVersion
+		if archivas_get_status_snapshot(&snap) != 0 {
+			t.Fatal("status snapshot failed")
+		}
+		if archivas_node_get_height_into(&height) != 1 || archivas_node_get_tip_hash_into(&hash[0]) != 1 ||
+			archivas_node_get_tip(&tip) != 1 {
+			t.Fatal("no tip")
+		}
+		proof[0] = 0
+		if archivas_farmer_get_last_proof_into(&proof[0], 64, nil) != 0 || proof[0] == 0 {
+			t.Fatal("no proof text")
+		}
+	}
+
+	for i := 0; i < soakWarmup; i++ {
+		poll()
+	}
+	runtime.GC()
+	before := residentBytes(t)
+
+	start := time.Now()
+	for i := 0; i < soakPolls; i++ {
+		poll()
+	}
+	runtime.GC()
+	after := residentBytes(t)
+
+	t.Logf("%d polls in %v; RSS %d KiB -> %d KiB", soakPolls, time.Since(start), before>>10, after>>10)
+	if after-before > soakRSSRoom {
+		t.Fatalf("RSS grew by %d KiB over %d polls", (after-before)>>10, soakPolls)
+	}
+}
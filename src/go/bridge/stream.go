@@ -0,0 +1,320 @@
+package main
+
+/*
+#cgo CFLAGS: -I${SRCDIR}
+#include "node.h"
+*/
+import "C"
+import (
+	"context"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"net/http"
+	"strconv"
+	"sync"
+	"time"
+
+	"github.com/ArchivasNetwork/archivas/ledger"
+)
+
+// GUI service listener, next to the RPC server: a Server-Sent Events feed of
+// chain activity on GET /events, and batched queries on POST /batch (batch.go).
+//
+// Events:
+//
+//	event: block  id: <height>  data: {height, hash, prevHash, farmer, txCount, timestamp, difficulty}
+//	event: tip    id: <height>  data: {height, hash, difficulty, timestamp}
+//	event: tx                   data: {hash, from, to, amount, fee, nonce, height, timestamp}   (mempool)
+//
+// A mempool hash is a pending id (mempoolTxID), height is the block the
+// transaction is expected in and timestamp is when the stream first saw it.
+//
+// A client that reconnects with Last-Event-ID (or ?from=<height>) is sent the
+// blocks it missed, up to streamMaxBackfill; without one it starts at the tip.
+const (
+	streamMaxBackfill       = 100
+	streamKeepAliveInterval = 15 * time.Second
+	streamMempoolInterval   = time.Second
+)
+
+var (
+	streamBindMutex sync.Mutex
+	streamBind      string
+
+	// Wake channels of connected clients, signalled when the tip changes
+	streamClientsMutex sync.Mutex
+	streamClients      = make(map[chan struct{}]struct{})
+)
+
+//export archivas_node_set_stream_bind
+func archivas_node_set_stream_bind(bind *C.char) {
+	streamBindMutex.Lock()
+	streamBind = C.GoString(bind)
+	streamBindMutex.Unlock()
+}
+
+// notifyStreamClients wakes every connected client; a wakeup already pending
+// covers this one too
+func notifyStreamClients() {
+	streamClientsMutex.Lock()
+	for wake := range streamClients {
+		select {
+		case wake <- struct{}{}:
+		default:
+		}
+	}
+	streamClientsMutex.Unlock()
+}
+
+// startStreamServer serves /events and /batch on the configured stream bind
+// until ctx is cancelled. Does nothing when no bind is set.
+func startStreamServer(ctx context.Context) {
+	streamBindMutex.Lock()
+	bind := streamBind
+	streamBindMutex.Unlock()
+	if bind == "" {
+		return
+	}
+
+	mux := http.NewServeMux()
+	mux.HandleFunc("/events", serveStream)
+	mux.HandleFunc("/batch", serveBatch)
+	server := &http.Server{Addr: bind, Handler: mux}
+	go func() {
+		callLogCallback("INFO", fmt.Sprintf("Starting event stream on %s", bind))
+		if err := server.ListenAndServe(); err != nil && err != http.ErrServerClosed {
+			callLogCallback("ERROR", fmt.Sprintf("Event stream error: %v", err))
+		}
+	}()
+	go func() {
+		<-ctx.Done()
+		server.Close()
+	}()
+}
+
+func serveStream(w http.ResponseWriter, r *http.Request) {
+	flusher, ok := w.(http.Flusher)
+	if !ok {
+		http.Error(w, "streaming unsupported", http.StatusInternalServerError)
+		return
+	}
+
+	// Resume after the last block the client saw, or start at the tip
+	next := publishedTipHeight() + 1
+	resume := r.Header.Get("Last-Event-ID")
+	if resume == "" {
+		resume = r.URL.Query().Get("from")
+		if from, err := strconv.ParseUint(resume, 10, 64); err == nil && from > 0 {
+			resume = strconv.FormatUint(from-1, 10)
+		}
+	}
+	if last, err := strconv.ParseUint(resume, 10, 64); err == nil {
+		next = last + 1
+	}
+
+	w.Header().Set("Content-Type", "text/event-stream")
+	w.Header().Set("Cache-Control", "no-cache")
+	w.Header().Set("X-Accel-Buffering", "no")
+	w.WriteHeader(http.StatusOK)
+
+	wake := make(chan struct{}, 1)
+	wake <- struct{}{} // Send the backlog and current tip straight away
+	streamClientsMutex.Lock()
+	streamClients[wake] = struct{}{}
+	streamClientsMutex.Unlock()
+	defer func() {
+		streamClientsMutex.Lock()
+		delete(streamClients, wake)
+		streamClientsMutex.Unlock()
+	}()
+
+	keepAlive := time.NewTicker(streamKeepAliveInterval)
+	defer keepAlive.Stop()
+	mempoolTicker := time.NewTicker(streamMempoolInterval)
+	defer mempoolTicker.Stop()
+	seenTxs := make(map[string]bool)
+
+	for {
+		select {
+		case <-r.Context().Done():
+			return
+		case <-wake:
+			var more bool
+			next, more = writeStreamBlocks(w, next)
+			if more {
+				// Still behind: continue after this flush instead of blocking others
+				select {
+				case wake <- struct{}{}:
+				default:
+				}
+			}
+		case <-mempoolTicker.C:
+			writeStreamMempool(w, seenTxs)
+		case <-keepAlive.C:
+			fmt.Fprint(w, ": keep-alive\n\n")
+		}
+		flusher.Flush()
+	}
+}
+
+// JSON shapes shared by the event stream and /batch; field names match what
+// ArchivasRpcClient parses for /blocks/recent, /chainTip and /tx/recent
+type blockSummary struct {
+	Height     uint64 `json:"height"`
+	Hash       string `json:"hash"`
+	PrevHash   string `json:"prevHash"`
+	Farmer     string `json:"farmer"`
+	TxCount    int    `json:"txCount"`
+	Timestamp  int64  `json:"timestamp"`
+	Difficulty uint64 `json:"difficulty"`
+}
+
+type tipSummary struct {
+	Height     uint64 `json:"height"`
+	Hash       string `json:"hash"`
+	Difficulty uint64 `json:"difficulty"`
+	Timestamp  int64  `json:"timestamp,omitempty"`
+}
+
+func summarizeBlock(b *Block) blockSummary {
+	hash := b.Hash()
+	return blockSummary{
+		Height:     b.Height,
+		Hash:       hex.EncodeToString(hash[:]),
+		PrevHash:   hex.EncodeToString(b.PrevHash[:]),
+		Farmer:     b.FarmerAddr,
+		TxCount:    len(b.Txs),
+		Timestamp:  b.TimestampUnix,
+		Difficulty: b.Difficulty,
+	}
+}
+
+// summarizeTipLocked reports the chain's current tip. Caller must hold ns's lock.
+func summarizeTipLocked(ns *NodeState) tipSummary {
+	height, difficulty, hash := ns.buildTip().status()
+	tip := tipSummary{Height: height, Hash: hex.EncodeToString(hash[:]), Difficulty: difficulty}
+	if height < uint64(len(ns.Chain)) {
+		tip.Timestamp = ns.Chain[height].TimestampUnix
+	}
+	return tip
+}
+
+// summarizeTip reports the published tip with the timestamp of its block.
+// Caller must not hold ns's lock.
+func summarizeTip(ns *NodeState) tipSummary {
+	height, difficulty, hash := ns.GetStatus()
+	tip := tipSummary{Height: height, Hash: hex.EncodeToString(hash[:]), Difficulty: difficulty}
+	ns.RLock()
+	if height < uint64(len(ns.Chain)) {
+		tip.Timestamp = ns.Chain[height].TimestampUnix
+	}
+	ns.RUnlock()
+	return tip
+}
+
+func writeStreamEvent(w http.ResponseWriter, event string, id string, payload interface{}) {
+	data, err := json.Marshal(payload)
+	if err != nil {
+		return
+	}
+	if id != "" {
+		fmt.Fprintf(w, "id: %s\n", id)
+	}
+	fmt.Fprintf(w, "event: %s\ndata: %s\n\n", event, data)
+}
+
+// writeStreamBlocks sends blocks from next up to the tip, at most
+// streamMaxBackfill of them, followed by the tip. Returns the next height to
+// send and whether blocks remain.
+func writeStreamBlocks(w http.ResponseWriter, next uint64) (uint64, bool) {
+	ns := runningNodeState()
+	if ns == nil {
+		return next, false
+	}
+
+	ns.RLock()
+	length := uint64(len(ns.Chain))
+	if next > length {
+		// The chain got shorter; the tip event below tells the client
+		next = length
+	}
+	end := length
+	if end-next > streamMaxBackfill {
+		end = next + streamMaxBackfill
+	}
+	blocks := make([]blockSummary, 0, end-next)
+	for h := next; h < end; h++ {
+		blocks = append(blocks, summarizeBlock(&ns.Chain[h]))
+	}
+	ns.RUnlock()
+
+	for _, block := range blocks {
+		writeStreamEvent(w, "block", strconv.FormatUint(block.Height, 10), block)
+	}
+	if end < length {
+		return end, true
+	}
+
+	tip := summarizeTip(ns)
+	writeStreamEvent(w, "tip", strconv.FormatUint(tip.Height, 10), tip)
+	return end, false
+}
+
+// mempoolTxID identifies a pending transaction while it waits to be mined.
+// Sender and nonce make it unique; the other fields pin the exact transfer.
+func mempoolTxID(tx *ledger.Transaction) [32]byte {
+	buf := make([]byte, 0, len(tx.From)+len(tx.To)+64)
+	buf = append(buf, tx.From...)
+	buf = append(buf, 0)
+	buf = append(buf, tx.To...)
+	buf = append(buf, 0)
+	buf = strconv.AppendInt(buf, tx.Amount, 10)
+	buf = append(buf, 0)
+	buf = strconv.AppendInt(buf, tx.Fee, 10)
+	buf = append(buf, 0)
+	buf = strconv.AppendUint(buf, tx.Nonce, 10)
+	return sha256.Sum256(buf)
+}
+
+// writeStreamMempool sends pending transactions the client has not seen yet.
+// seen is trimmed to what is still pending so it cannot grow without bound.
+func writeStreamMempool(w http.ResponseWriter, seen map[string]bool) {
+	ns := runningNodeState()
+	if ns == nil || ns.Mempool == nil {
+		return
+	}
+	pending := ns.Mempool.Pending()
+	// Pending transactions are reported at the height they are expected in
+	// and the time this stream first saw them
+	nextHeight := publishedTipHeight() + 1
+	now := time.Now().Unix()
+
+	current := make(map[string]bool, len(pending))
+	for i := range pending {
+		tx := &pending[i]
+		key := tx.From + ":" + strconv.FormatUint(tx.Nonce, 10)
+		current[key] = true
+		if seen[key] {
+			continue
+		}
+		id := mempoolTxID(tx)
+		writeStreamEvent(w, "tx", "", struct {
+			Hash      string `json:"hash"`
+			From      string `json:"from"`
+			To        string `json:"to"`
+			Amount    int64  `json:"amount"`
+			Fee       int64  `json:"fee"`
+			Nonce     uint64 `json:"nonce"`
+			Height    uint64 `json:"height"`
+			Timestamp int64  `json:"timestamp"`
+		}{hex.EncodeToString(id[:]), tx.From, tx.To, tx.Amount, tx.Fee, tx.Nonce, nextHeight, now})
+	}
+	for key := range seen {
+		delete(seen, key)
+	}
+	for key := range current {
+		seen[key] = true
+	}
+}
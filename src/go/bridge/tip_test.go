@@ -0,0 +1,119 @@
+package main
+
+import (
+	"math/rand"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	"github.com/ArchivasNetwork/archivas/consensus"
+)
+
+// TestPublishedTipUnderLoad applies blocks while readers hammer the tip
+// getters. Run with -race: every snapshot a reader sees must describe one
+// real block (height and hash agree), heights never go backwards, and no
+// getter waits on the lock ApplyBlock holds.
+func TestPublishedTipUnderLoad(t *testing.T) {
+	const blockCount = 2000
+
+	rng := rand.New(rand.NewSource(1))
+	blocks := make([]Block, blockCount)
+	for h := range blocks {
+		var prev *Block
+		if h > 0 {
+			prev = &blocks[h-1]
+		}
+		blocks[h] = testBlock(prev, uint64(h), rng)
+	}
+	payloads := make([][]byte, blockCount)
+	for h := range blocks {
+		payloads[h] = blockJSON(&blocks[h])
+	}
+
+	ns := &NodeState{Consensus: &consensus.Consensus{}}
+	publishedTip.Store(nil)
+	defer publishedTip.Store(nil)
+
+	var done atomic.Bool
+	var maxLatency atomic.Int64
+	var reads atomic.Int64
+	readers := runtime.GOMAXPROCS(0)
+	if readers < 4 {
+		readers = 4
+	}
+
+	var wg sync.WaitGroup
+	errs := make(chan string, readers)
+	for r := 0; r < readers; r++ {
+		wg.Add(1)
+		go func(r int) {
+			defer wg.Done()
+			var last uint64
+			var worst time.Duration
+			var n int64
+			defer func() {
+				reads.Add(n)
+				for {
+					cur := maxLatency.Load()
+					if int64(worst) <= cur || maxLatency.CompareAndSwap(cur, int64(worst)) {
+						return
+					}
+				}
+			}()
+			for !done.Load() {
+				start := time.Now()
+				var height uint64
+				var hash [32]byte
+				var hasChain bool
+				switch r % 3 {
+				case 0:
+					height = publishedTipHeight()
+				case 1:
+					tip := ns.loadTip()
+					height, hash, hasChain = tip.Height, tip.Hash, tip.HasChain
+				default:
+					height, _, hash = ns.GetStatus()
+					hasChain = publishedTip.Load() != nil
+				}
+				if d := time.Since(start); d > worst {
+					worst = d
+				}
+				n++
+
+				if height < last {
+					errs <- "tip height went backwards"
+					return
+				}
+				last = height
+				if hasChain && hash != blocks[height].Hash() {
+					errs <- "tip hash does not belong to the tip height"
+					return
+				}
+			}
+		}(r)
+	}
+
+	start := time.Now()
+	for h := range payloads {
+		if err := ns.ApplyBlock(payloads[h]); err != nil {
+			done.Store(true)
+			wg.Wait()
+			t.Fatalf("ApplyBlock(%d): %v", h, err)
+		}
+	}
+	applyTime := time.Since(start)
+	done.Store(true)
+	wg.Wait()
+	close(errs)
+	for err := range errs {
+		t.Error(err)
+	}
+
+	if got := publishedTipHeight(); got != blockCount-1 {
+		t.Fatalf("published height = %d, want %d", got, blockCount-1)
+	}
+	t.Logf("%d blocks applied in %v with %d readers; %d reads, max getter latency %v",
+		blockCount, applyTime, readers, reads.Load(), time.Duration(maxLatency.Load()))
+}
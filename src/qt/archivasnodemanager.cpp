@@ -1,33 +1,156 @@
 #include "archivasnodemanager.h"
 #include <QDebug>
 #include <QByteArray>
+#include <QDateTime>
 #include <QMetaObject>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Logs reach the UI at most once per frame, capped so a flood cannot stall it
+static const int kLogFlushIntervalMs = 16;
+static const int kMaxLogRecordsPerFlush = 5000;
+
+// Upper bound on waiting for node/farmer teardown when the process exits
+static const int kExitTeardownTimeoutMs = 10000;
 
 ArchivasNodeManager* ArchivasNodeManager::s_instance = nullptr;
 
+static QFuture<bool> finishedFuture(bool result)
+{
+    QFutureInterface<bool> promise;
+    promise.reportStarted();
+    promise.reportResult(result);
+    promise.reportFinished();
+    return promise.future();
+}
+
+static void resolveAll(QList<QFutureInterface<bool>> &waiters, bool result)
+{
+    QList<QFutureInterface<bool>> pending;
+    pending.swap(waiters);
+    for (QFutureInterface<bool> &promise : pending) {
+        promise.reportResult(result);
+        promise.reportFinished();
+    }
+}
+
+static QString bytesToHex(const uint8_t *bytes, int size)
+{
+    return QString::fromLatin1(QByteArray(reinterpret_cast<const char*>(bytes), size).toHex());
+}
+
+static QString logLevelName(uint8_t level)
+{
+    static const QString names[] = {
+        QStringLiteral("DEBUG"),
+        QStringLiteral("INFO"),
+        QStringLiteral("WARN"),
+        QStringLiteral("ERROR")
+    };
+    return level <= ARCHIVAS_LOG_ERROR ? names[level] : names[ARCHIVAS_LOG_INFO];
+}
+
+QString formatLogRecords(const QVector<LogRecord> &records, LogRecord::Source source)
+{
+    QString text;
+    qint64 cachedSecond = -1;
+    QString cachedTimestamp;
+    for (const LogRecord &record : records) {
+        if (record.source != source || record.message.isEmpty()) {
+            continue;
+        }
+        // Formatting a QDateTime per line dominates large batches; reuse it per second
+        qint64 second = record.timestampNs / 1000000000;
+        if (second != cachedSecond) {
+            cachedSecond = second;
+            cachedTimestamp = QDateTime::fromSecsSinceEpoch(second).toString("yyyy-MM-dd hh:mm:ss");
+        }
+        if (!text.isEmpty()) {
+            text += QLatin1Char('\n');
+        }
+        text += QString("[%1] [%2] %3").arg(cachedTimestamp, record.level, record.message);
+    }
+    return text;
+}
+
 ArchivasNodeManager::ArchivasNodeManager(QObject *parent)
     : QObject(parent)
+    , m_eventNotifier(nullptr)
+    , m_logFlushTimer(nullptr)
 {
-    s_instance = this;
-    
-    // Set up log callbacks
-    archivas_node_set_log_callback(logCallback);
-    archivas_farmer_set_log_callback(farmerLogCallback);
+    // The bridge keeps every level until told otherwise
+    m_logLevels[LogRecord::Node] = logLevelName(ARCHIVAS_LOG_DEBUG);
+    m_logLevels[LogRecord::Farmer] = logLevelName(ARCHIVAS_LOG_DEBUG);
+    m_eventPipe[0] = -1;
+    m_eventPipe[1] = -1;
+    memset(&m_snapshot, 0, sizeof(m_snapshot));
+    m_snapshot.version = ARCHIVAS_STATUS_SNAPSHOT_VERSION;
+
+    m_node.bridgeState = archivas_node_get_state;
+    m_node.bridgeStop = archivas_node_stop;
+    m_node.state = static_cast<ServiceState>(archivas_node_get_state());
+    m_farmer.bridgeState = archivas_farmer_get_state;
+    m_farmer.bridgeStop = archivas_farmer_stop;
+    m_farmer.state = static_cast<ServiceState>(archivas_farmer_get_state());
+
+    // Node and farmer logs go through the shared log arena instead of
+    // per-line callbacks; flushLogs drains it
+    m_logFlushTimer = new QTimer(this);
+    m_logFlushTimer->setSingleShot(true);
+    connect(m_logFlushTimer, &QTimer::timeout, this, &ArchivasNodeManager::flushLogs);
+    archivas_logs_enable(1);
     
-    // Status update timer
-    m_statusTimer = new QTimer(this);
-    connect(m_statusTimer, &QTimer::timeout, this, &ArchivasNodeManager::updateStatus);
-    m_statusTimer->start(5000); // Update every 5 seconds
+    // Bridge events wake us through a self-pipe: Go writes one byte whenever
+    // its event ring goes from drained to non-empty
+    if (::pipe(m_eventPipe) == 0) {
+        for (int fd : m_eventPipe) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        m_eventNotifier = new QSocketNotifier(m_eventPipe[0], QSocketNotifier::Read, this);
+        connect(m_eventNotifier, &QSocketNotifier::activated, this, &ArchivasNodeManager::onEventsReady);
+        archivas_events_set_notify_fd(m_eventPipe[1]);
+    } else {
+        m_eventPipe[0] = -1;
+        m_eventPipe[1] = -1;
+        // Nothing would wake flushLogs, so deliver each line through the callbacks
+        archivas_logs_enable(0);
+        s_instance = this;
+        archivas_node_set_log_callback(logCallback);
+        archivas_farmer_set_log_callback(farmerLogCallback);
+        qWarning() << "Failed to create bridge event pipe; status will only refresh on start/stop";
+    }
+
+    refreshSnapshot();
 }
 
 ArchivasNodeManager::~ArchivasNodeManager()
 {
-    stopNode();
-    stopFarmer();
+    // MainWindow normally calls shutdown() and waits for it before exiting; this
+    // covers any other exit path, bounded so a stuck teardown cannot hang it
+    archivas_farmer_stop();
+    archivas_node_stop();
+    archivas_farmer_wait_stopped(kExitTeardownTimeoutMs);
+    archivas_node_wait_stopped(kExitTeardownTimeoutMs);
+
+    archivas_logs_enable(0);
+    if (s_instance == this) {
+        archivas_node_set_log_callback(nullptr);
+        archivas_farmer_set_log_callback(nullptr);
+        s_instance = nullptr;
+    }
+    // Returns only after any write to the pipe in progress has finished
+    archivas_events_set_notify_fd(-1);
+    for (int fd : m_eventPipe) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
 }
 
-bool ArchivasNodeManager::startNode(const QString &networkId, const QString &rpcBind, 
-                                     const QString &dataDir, const QString &bootnodes, const QString &genesisPath)
+QFuture<bool> ArchivasNodeManager::startNode(const QString &networkId, const QString &rpcBind, 
+                                              const QString &dataDir, const QString &bootnodes, const QString &genesisPath)
 {
     QByteArray networkIdBytes = networkId.toUtf8();
     QByteArray rpcBindBytes = rpcBind.toUtf8();
@@ -35,36 +158,46 @@ bool ArchivasNodeManager::startNode(const QString &networkId, const QString &rpc
     QByteArray bootnodesBytes = bootnodes.toUtf8();
     QByteArray genesisPathBytes = genesisPath.toUtf8();
     
+    // The launch may be deferred until a previous instance has stopped, so it
+    // owns copies of the arguments.
     // Note: Go bridge expects char* not const char*, but we're passing const data
     // This is safe because the Go code only reads the strings
-    int result = archivas_node_start(
-        const_cast<char*>(networkIdBytes.constData()),
-        const_cast<char*>(rpcBindBytes.constData()),
-        const_cast<char*>(dataDirBytes.constData()),
-        const_cast<char*>(bootnodesBytes.constData()),
-        const_cast<char*>(genesisPathBytes.constData())
-    );
-    
-    if (result == 0) {
-        emit nodeStarted();
-        return true;
-    }
-    return false;
+    return requestStart(m_node, [=]() {
+        return archivas_node_start(
+            const_cast<char*>(networkIdBytes.constData()),
+            const_cast<char*>(rpcBindBytes.constData()),
+            const_cast<char*>(dataDirBytes.constData()),
+            const_cast<char*>(bootnodesBytes.constData()),
+            const_cast<char*>(genesisPathBytes.constData())
+        );
+    });
 }
 
-void ArchivasNodeManager::stopNode()
+QFuture<bool> ArchivasNodeManager::stopNode()
 {
-    archivas_node_stop();
-    emit nodeStopped();
+    return requestStop(m_node);
+}
+
+QFuture<bool> ArchivasNodeManager::restartNode(const QString &networkId, const QString &rpcBind,
+                                                const QString &dataDir, const QString &bootnodes, const QString &genesisPath)
+{
+    // The start is deferred until the stop has actually finished
+    requestStop(m_node);
+    return startNode(networkId, rpcBind, dataDir, bootnodes, genesisPath);
+}
+
+ArchivasNodeManager::ServiceState ArchivasNodeManager::nodeState() const
+{
+    return m_node.state;
 }
 
 bool ArchivasNodeManager::isNodeRunning() const
 {
-    return archivas_node_is_running() != 0;
+    return m_node.state == Starting || m_node.state == Running || m_node.state == Stopping;
 }
 
-bool ArchivasNodeManager::startFarmer(const QString &nodeUrl, const QString &plotsPath, 
-                                       const QString &farmerPrivkey)
+QFuture<bool> ArchivasNodeManager::startFarmer(const QString &nodeUrl, const QString &plotsPath, 
+                                                const QString &farmerPrivkey)
 {
     QByteArray nodeUrlBytes = nodeUrl.toUtf8();
     QByteArray plotsPathBytes = plotsPath.toUtf8();
@@ -72,66 +205,265 @@ bool ArchivasNodeManager::startFarmer(const QString &nodeUrl, const QString &plo
     
     // Note: Go bridge expects char* not const char*, but we're passing const data
     // This is safe because the Go code only reads the strings
-    int result = archivas_farmer_start(
-        const_cast<char*>(nodeUrlBytes.constData()),
-        const_cast<char*>(plotsPathBytes.constData()),
-        const_cast<char*>(farmerPrivkeyBytes.constData())
-    );
-    
-    if (result == 0) {
-        emit farmerStarted();
-        return true;
-    }
-    return false;
+    return requestStart(m_farmer, [=]() {
+        return archivas_farmer_start(
+            const_cast<char*>(nodeUrlBytes.constData()),
+            const_cast<char*>(plotsPathBytes.constData()),
+            const_cast<char*>(farmerPrivkeyBytes.constData())
+        );
+    });
 }
 
-void ArchivasNodeManager::stopFarmer()
+QFuture<bool> ArchivasNodeManager::stopFarmer()
 {
-    archivas_farmer_stop();
-    emit farmerStopped();
+    return requestStop(m_farmer);
+}
+
+QFuture<bool> ArchivasNodeManager::restartFarmer(const QString &nodeUrl, const QString &plotsPath,
+                                                  const QString &farmerPrivkey)
+{
+    requestStop(m_farmer);
+    return startFarmer(nodeUrl, plotsPath, farmerPrivkey);
+}
+
+ArchivasNodeManager::ServiceState ArchivasNodeManager::farmerState() const
+{
+    return m_farmer.state;
 }
 
 bool ArchivasNodeManager::isFarmerRunning() const
 {
-    return archivas_farmer_is_running() != 0;
+    return m_farmer.state == Starting || m_farmer.state == Running || m_farmer.state == Stopping;
+}
+
+QFuture<bool> ArchivasNodeManager::shutdown()
+{
+    requestStop(m_farmer);
+    requestStop(m_node);
+
+    QFutureInterface<bool> promise;
+    promise.reportStarted();
+    m_shutdownWaiters.append(promise);
+    checkShutdown();
+    return promise.future();
+}
+
+QString ArchivasNodeManager::serviceStateName(ServiceState state)
+{
+    switch (state) {
+    case Starting:
+        return "Starting...";
+    case Running:
+        return "Running";
+    case Stopping:
+        return "Stopping...";
+    case Failed:
+        return "Failed";
+    case Stopped:
+        break;
+    }
+    return "Stopped";
+}
+
+QString ArchivasNodeManager::serviceStateStyle(ServiceState state)
+{
+    switch (state) {
+    case Running:
+        return "color: green; font-weight: bold;";
+    case Starting:
+    case Stopping:
+        return "color: orange; font-weight: bold;";
+    case Stopped:
+    case Failed:
+        break;
+    }
+    return "color: red; font-weight: bold;";
+}
+
+QFuture<bool> ArchivasNodeManager::requestStart(ServiceControl &service, const std::function<int()> &launch)
+{
+    if (service.state == Running) {
+        return finishedFuture(true);
+    }
+
+    // Register before launching: the bridge may report the outcome right away
+    QFutureInterface<bool> promise;
+    promise.reportStarted();
+    service.startWaiters.append(promise);
+
+    if (service.state == Stopping) {
+        service.deferredStart = launch;
+    } else if (service.state == Stopped || service.state == Failed) {
+        if (launch() != 0) {
+            resolveAll(service.startWaiters, false);
+        } else {
+            syncServiceState(service);
+        }
+    }
+    // Starting: join the start already in progress
+    return promise.future();
+}
+
+QFuture<bool> ArchivasNodeManager::requestStop(ServiceControl &service)
+{
+    // A stop also cancels a start that was waiting for the previous stop
+    if (service.deferredStart) {
+        service.deferredStart = nullptr;
+        resolveAll(service.startWaiters, false);
+    }
+
+    if (service.state == Stopped || service.state == Failed) {
+        return finishedFuture(true);
+    }
+
+    QFutureInterface<bool> promise;
+    promise.reportStarted();
+    service.stopWaiters.append(promise);
+
+    if (service.state == Starting || service.state == Running) {
+        service.bridgeStop();
+        syncServiceState(service);
+    }
+    return promise.future();
+}
+
+void ArchivasNodeManager::syncServiceState(ServiceControl &service)
+{
+    // Always take the bridge's current state rather than the one carried by an
+    // event, so events still queued from before a request cannot roll it back
+    setServiceState(service, static_cast<ServiceState>(service.bridgeState()));
+}
+
+void ArchivasNodeManager::setServiceState(ServiceControl &service, ServiceState state)
+{
+    if (service.state == state) {
+        return;
+    }
+    service.state = state;
+    refreshSnapshot();
+
+    const bool isNode = &service == &m_node;
+    if (isNode) {
+        emit nodeStateChanged(state);
+    } else {
+        emit farmerStateChanged(state);
+    }
+
+    if (state == Running) {
+        resolveAll(service.startWaiters, true);
+        if (isNode) {
+            emit nodeStarted();
+        } else {
+            emit farmerStarted();
+        }
+    } else if (state == Stopped || state == Failed) {
+        resolveAll(service.stopWaiters, true);
+        if (isNode) {
+            emit nodeStopped();
+        } else {
+            emit farmerStopped();
+        }
+
+        std::function<int()> launch;
+        launch.swap(service.deferredStart);
+        if (launch && launch() == 0) {
+            syncServiceState(service);
+        } else {
+            resolveAll(service.startWaiters, false);
+        }
+        checkShutdown();
+    }
+}
+
+void ArchivasNodeManager::checkShutdown()
+{
+    if (!m_shutdownWaiters.isEmpty() && !isNodeRunning() && !isFarmerRunning()) {
+        resolveAll(m_shutdownWaiters, true);
+    }
 }
 
 int ArchivasNodeManager::getCurrentHeight() const
 {
-    return archivas_node_get_height();
+    return static_cast<int>(m_snapshot.height);
 }
 
 QString ArchivasNodeManager::getTipHash() const
 {
-    char* hash = archivas_node_get_tip_hash();
-    if (hash) {
-        QString result = QString::fromUtf8(hash);
-        // Note: We don't free the C string here because it's managed by Go
-        // In a production implementation, we'd need to coordinate memory management
-        return result;
-    }
-    return QString();
+    return bytesToHex(m_snapshot.tip_hash, sizeof(m_snapshot.tip_hash));
+}
+
+quint64 ArchivasNodeManager::getDifficulty() const
+{
+    return m_snapshot.difficulty;
 }
 
 int ArchivasNodeManager::getPeerCount() const
 {
-    return archivas_node_get_peer_count();
+    return m_snapshot.peer_count;
 }
 
 int ArchivasNodeManager::getPlotCount() const
 {
-    return archivas_farmer_get_plot_count();
+    return m_snapshot.plot_count;
 }
 
 QString ArchivasNodeManager::getLastProof() const
 {
-    char* proof = archivas_farmer_get_last_proof();
-    if (proof) {
-        QString result = QString::fromUtf8(proof);
-        // Note: We don't free the C string here because it's managed by Go
-        return result;
+    if (!(m_snapshot.flags & ARCHIVAS_STATUS_HAS_PROOF)) {
+        return QString();
     }
-    return QString();
+    // Same format as archivas_farmer_get_last_proof
+    return QString("Quality: %1, Hash: %2")
+        .arg(m_snapshot.last_proof_quality)
+        .arg(bytesToHex(m_snapshot.last_proof_hash, 8));
+}
+
+bool ArchivasNodeManager::isIbdRunning() const
+{
+    return (m_snapshot.flags & ARCHIVAS_STATUS_IBD_RUNNING) != 0;
+}
+
+quint64 ArchivasNodeManager::getIbdTargetHeight() const
+{
+    return m_snapshot.ibd_target_height;
+}
+
+quint64 ArchivasNodeManager::getStatusSequence() const
+{
+    return m_snapshot.sequence;
+}
+
+QStringList ArchivasNodeManager::logLevelNames()
+{
+    return QStringList() << "DEBUG" << "INFO" << "WARN" << "ERROR";
+}
+
+void ArchivasNodeManager::setStreamBind(const QString &bind)
+{
+    QByteArray bindBytes = bind.trimmed().toUtf8();
+    archivas_node_set_stream_bind(bindBytes.data());
+}
+
+void ArchivasNodeManager::setLogLevel(LogRecord::Source source, const QString &level)
+{
+    int code = logLevelNames().indexOf(level.toUpper());
+    if (code < 0) {
+        qWarning() << "Unknown log level" << level;
+        return;
+    }
+    if (archivas_set_log_level(source, code) != 0) {
+        return;
+    }
+    QString name = logLevelName(static_cast<uint8_t>(code));
+    if (m_logLevels[source] != name) {
+        m_logLevels[source] = name;
+        emit logLevelChanged(source, name);
+    }
+}
+
+QString ArchivasNodeManager::logLevel(LogRecord::Source source) const
+{
+    return m_logLevels[source];
 }
 
 bool ArchivasNodeManager::createPlot(const QString &plotPath, unsigned int kSize, const QString &farmerPrivkeyPath)
@@ -148,42 +480,183 @@ bool ArchivasNodeManager::createPlot(const QString &plotPath, unsigned int kSize
     return result == 0;
 }
 
-void ArchivasNodeManager::logCallback(char* level, char* message)
+void ArchivasNodeManager::refreshSnapshot()
 {
-    if (s_instance) {
-        // Thread-safe signal emission: Go callback might be called from any goroutine
-        QString levelStr = QString::fromUtf8(level);
-        QString messageStr = QString::fromUtf8(message);
-        QMetaObject::invokeMethod(s_instance, "emitNodeLog", Qt::QueuedConnection,
-                                  Q_ARG(QString, levelStr),
-                                  Q_ARG(QString, messageStr));
+    // One bridge call per event batch; every page reads from this cache
+    archivas_status_snapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.version = ARCHIVAS_STATUS_SNAPSHOT_VERSION;
+    if (archivas_get_status_snapshot(&snapshot) == 0) {
+        m_snapshot = snapshot;
     }
 }
 
-void ArchivasNodeManager::farmerLogCallback(char* level, char* message)
+void ArchivasNodeManager::onEventsReady()
 {
-    if (s_instance) {
-        // Thread-safe signal emission: Go callback might be called from any goroutine
-        QString levelStr = QString::fromUtf8(level);
-        QString messageStr = QString::fromUtf8(message);
-        QMetaObject::invokeMethod(s_instance, "emitFarmerLog", Qt::QueuedConnection,
-                                  Q_ARG(QString, levelStr),
-                                  Q_ARG(QString, messageStr));
+    // Empty the wakeup pipe, then drain everything queued in the ring
+    char wakeup[64];
+    while (::read(m_eventPipe[0], wakeup, sizeof(wakeup)) > 0) {
     }
+    scheduleLogFlush();
+
+    const int chunkSize = 64;
+    archivas_event chunk[chunkSize];
+    QVector<archivas_event> events;
+    quint64 dropped = 0;
+    int count = 0;
+    do {
+        uint64_t lost = 0;
+        count = archivas_events_drain(chunk, chunkSize, &lost);
+        dropped += lost;
+        for (int i = 0; i < count; ++i) {
+            events.append(chunk[i]);
+        }
+    } while (count == chunkSize);
+
+    if (events.isEmpty() && dropped == 0) {
+        return;
+    }
+
+    // Refresh once per batch so getters agree with the signals below
+    refreshSnapshot();
+    if (dropped > 0) {
+        qWarning() << "Bridge event ring overflowed, dropped" << dropped << "events";
+    }
+
+    for (const archivas_event &event : events) {
+        dispatchEvent(event);
+    }
+    emit statusUpdated();
 }
 
-void ArchivasNodeManager::emitNodeLog(const QString &level, const QString &message)
+void ArchivasNodeManager::dispatchEvent(const archivas_event &event)
 {
-    emit nodeLog(level, message);
+    switch (event.type) {
+    case ARCHIVAS_EVENT_TIP_CHANGED:
+        emit tipChanged(event.arg0, bytesToHex(event.hash, sizeof(event.hash)), event.arg1);
+        if (isIbdRunning()) {
+            emit syncProgress(event.arg0, getIbdTargetHeight());
+        }
+        break;
+    case ARCHIVAS_EVENT_PEER_CONNECTED:
+        emit peerConnected(QString::fromUtf8(event.text));
+        emit peerCountChanged(static_cast<int>(event.arg0));
+        break;
+    case ARCHIVAS_EVENT_PEER_DISCONNECTED:
+        emit peerDisconnected(QString::fromUtf8(event.text));
+        emit peerCountChanged(static_cast<int>(event.arg0));
+        break;
+    case ARCHIVAS_EVENT_SYNC_STAGE:
+        emit syncStageChanged(static_cast<SyncStage>(event.code));
+        emit syncProgress(event.arg0, event.arg1);
+        break;
+    case ARCHIVAS_EVENT_PROOF_FOUND:
+        emit farmerProofFound(event.arg0, event.arg1, bytesToHex(event.hash, sizeof(event.hash)));
+        break;
+    case ARCHIVAS_EVENT_PLOT_LOADED:
+        emit plotLoaded(QString::fromUtf8(event.text), static_cast<int>(event.arg0));
+        break;
+    case ARCHIVAS_EVENT_NODE_STATE:
+        syncServiceState(m_node);
+        break;
+    case ARCHIVAS_EVENT_FARMER_STATE:
+        syncServiceState(m_farmer);
+        break;
+    default:
+        break;
+    }
 }
 
-void ArchivasNodeManager::emitFarmerLog(const QString &level, const QString &message)
+
+void ArchivasNodeManager::scheduleLogFlush()
 {
-    emit farmerLog(level, message);
+    if (m_logFlushTimer->isActive()) {
+        return;
+    }
+    // The first batch after a quiet period goes out right away, later ones
+    // wait for the rest of the current frame
+    qint64 wait = 0;
+    if (m_lastLogFlush.isValid()) {
+        wait = qMax<qint64>(0, kLogFlushIntervalMs - m_lastLogFlush.elapsed());
+    }
+    m_logFlushTimer->start(static_cast<int>(wait));
 }
 
-void ArchivasNodeManager::updateStatus()
+void ArchivasNodeManager::postLogRecord(LogRecord::Source source, const char* level, const char* message)
 {
-    emit statusUpdated();
+    ArchivasNodeManager *manager = s_instance;
+    if (!manager) {
+        return;
+    }
+    LogRecord record;
+    record.source = source;
+    record.level = QString::fromUtf8(level);
+    record.message = QString::fromUtf8(message);
+    record.timestampNs = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    // Go callbacks run on arbitrary threads; hop to the manager's thread
+    QMetaObject::invokeMethod(manager, [manager, record]() {
+        emit manager->logBatch(QVector<LogRecord>{record});
+    }, Qt::QueuedConnection);
+}
+
+void ArchivasNodeManager::logCallback(char* level, char* message)
+{
+    postLogRecord(LogRecord::Node, level, message);
 }
 
+void ArchivasNodeManager::farmerLogCallback(char* level, char* message)
+{
+    postLogRecord(LogRecord::Farmer, level, message);
+}
+
+void ArchivasNodeManager::flushLogs()
+{
+    m_lastLogFlush.restart();
+
+    QVector<LogRecord> records;
+    quint64 dropped = 0;
+    while (records.size() < kMaxLogRecordsPerFlush) {
+        size_t length = 0;
+        uint64_t lost = 0;
+        const uint8_t *data = archivas_logs_peek(&length, &lost);
+        dropped += lost;
+        if (!data || length == 0) {
+            break;
+        }
+
+        // Parse in place; only the QString conversion copies the message
+        size_t offset = 0;
+        while (offset + sizeof(archivas_log_record) <= length && records.size() < kMaxLogRecordsPerFlush) {
+            const archivas_log_record *header = reinterpret_cast<const archivas_log_record*>(data + offset);
+            if (header->size == 0) {
+                break; // Wrap marker, skipped by the next peek
+            }
+            LogRecord record;
+            record.source = header->source == ARCHIVAS_LOG_SOURCE_FARMER ? LogRecord::Farmer : LogRecord::Node;
+            record.level = logLevelName(header->level);
+            record.message = QString::fromUtf8(reinterpret_cast<const char*>(data + offset + sizeof(archivas_log_record)),
+                                               header->message_len);
+            record.timestampNs = header->timestamp_ns;
+            records.append(record);
+            offset += header->size;
+        }
+        archivas_logs_consume(offset);
+    }
+
+    if (dropped > 0) {
+        LogRecord record;
+        record.source = LogRecord::Node;
+        record.level = logLevelName(ARCHIVAS_LOG_WARN);
+        record.message = QString("%1 log lines dropped (log buffer full)").arg(dropped);
+        record.timestampNs = QDateTime::currentMSecsSinceEpoch() * 1000000;
+        records.append(record);
+    }
+
+    if (records.size() >= kMaxLogRecordsPerFlush) {
+        // More is waiting; pick it up next frame
+        m_logFlushTimer->start(kLogFlushIntervalMs);
+    }
+    if (!records.isEmpty()) {
+        emit logBatch(records);
+    }
+}
@@ -1,194 +1,1313 @@
 #include "archivasrpcclient.h"
 #include <QNetworkRequest>
 #include <QUrl>
+#include <QUrlQuery>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QDebug>
+#include <QDateTime>
+#include <QMetaObject>
+#include <QVector>
+#include <QThreadPool>
+#include <QTimer>
+#include <algorithm>
+#include <memory>
+#include "node.h"
+#include "query.h"
+
+// Tracked hashes beyond the display window, so short reorgs find their fork
+static const int kMinTrackedBlocks = 64;
+// Most blocks fetched per /blocks/range request while catching up
+static const int kMaxBlockRange = 100;
+static const QLatin1String kBlockRangeEndpoint("blocks/range");
+// Single-flight keys of history pages: "blockPage/<from>/<limit>". Kept apart
+// from kBlockRangeEndpoint so a page never touches the block cursor.
+static const QLatin1String kBlockPageKey("blockPage/");
+// The stream sends a keep-alive every 15 s; silence for longer means it is dead
+static const int kStreamIdleTimeoutMs = 45000;
+static const int kStreamRetryMinMs = 1000;
+static const int kStreamRetryMaxMs = 30000;
+
+static BlockInfo blockFromRecord(const archivas_block_record& record)
+{
+    BlockInfo block;
+    block.height = record.height;
+    block.hash = Hash32::fromBytes(record.hash);
+    block.prevHash = Hash32::fromBytes(record.prev_hash);
+    block.farmer = Address::intern(QString::fromUtf8(record.farmer_addr));
+    block.txCount = record.tx_count;
+    block.timestamp = record.timestamp;
+    block.difficulty = record.difficulty;
+    return block;
+}
+
+static TransactionInfo txFromRecord(const archivas_tx_record& record)
+{
+    TransactionInfo tx;
+    // The bridge has no transaction hash; the position in the chain identifies it
+    tx.index = record.index;
+    tx.from = Address::intern(QString::fromUtf8(record.from));
+    tx.to = Address::intern(QString::fromUtf8(record.to));
+    tx.amount = record.amount;
+    tx.fee = record.fee;
+    tx.height = record.height;
+    tx.timestamp = record.timestamp;
+    return tx;
+}
+
+// Numeric fields arrive as JSON numbers from /blocks/range and as strings elsewhere
+static quint64 jsonUInt(const QJsonValue& value)
+{
+    if (value.isString()) {
+        return value.toString().toULongLong();
+    }
+    return static_cast<quint64>(value.toDouble());
+}
+
+static qint64 jsonInt(const QJsonValue& value)
+{
+    if (value.isString()) {
+        return value.toString().toLongLong();
+    }
+    return static_cast<qint64>(value.toDouble());
+}
+
+// Unix seconds, either numeric or as an ISO 8601 / "yyyy-MM-dd hh:mm:ss" string
+static qint64 jsonTimestamp(const QJsonValue& value)
+{
+    if (!value.isString()) {
+        return static_cast<qint64>(value.toDouble());
+    }
+    QString text = value.toString();
+    bool ok = false;
+    qint64 seconds = text.toLongLong(&ok);
+    if (ok) {
+        return seconds;
+    }
+    QDateTime time = QDateTime::fromString(text, Qt::ISODate);
+    if (!time.isValid()) {
+        time = QDateTime::fromString(text, "yyyy-MM-dd hh:mm:ss");
+    }
+    return time.isValid() ? time.toSecsSinceEpoch() : 0;
+}
 
 ArchivasRpcClient::ArchivasRpcClient(QObject *parent)
     : QObject(parent)
     , m_networkManager(nullptr)
-    , m_baseUrl("http://127.0.0.1:8080")
-    , m_fallbackUrl("https://seed.archivas.ai")
+    , m_directManager(nullptr)
+    , m_endpointPool(nullptr)
     , m_connected(false)
-    , m_usingFallback(false)
+    , m_hedging(false)
+    , m_nextRequestId(1)
+    , m_requestTimeoutMs(10000)
+    , m_cacheTtlMs(1000)
+    , m_blockWindow(0)
+    , m_blockRangePending(false)
+    , m_streamReply(nullptr)
+    , m_streamRetryMs(kStreamRetryMinMs)
+    , m_streamLive(false)
+    , m_parsePool(nullptr)
 {
+    m_parsePool = new QThreadPool(this);
+    m_parsePool->setMaxThreadCount(2);
+
+    m_clock.start();
+    m_endpointPool = new RpcEndpointPool(this);
+    m_endpointPool->setUrls({"http://127.0.0.1:8080", "https://seed.archivas.ai"});
+
     m_networkManager = new QNetworkAccessManager(this);
     connect(m_networkManager, &QNetworkAccessManager::finished,
             this, &ArchivasRpcClient::onReplyFinished);
+
+    // Separate manager so the stream never reaches onReplyFinished
+    m_directManager = new QNetworkAccessManager(this);
 }
 
 ArchivasRpcClient::~ArchivasRpcClient()
 {
+    // Parse jobs capture this; their queued results are dropped with the object
+    m_parsePool->waitForDone();
 }
 
-void ArchivasRpcClient::setBaseUrl(const QString& url)
+void ArchivasRpcClient::setEndpoints(const QStringList& urls)
 {
-    m_baseUrl = url.trimmed();
-    // Remove trailing slash
-    while (m_baseUrl.endsWith('/')) {
-        m_baseUrl.chop(1);
+    QStringList previous = m_endpointPool->urls();
+    m_endpointPool->setUrls(urls);
+    if (m_endpointPool->urls() == previous) {
+        return;
+    }
+    // Cached results and replies still pending came from the previous servers
+    m_cache.clear();
+    const QList<quint64> pending = m_requests.keys();
+    for (quint64 id : pending) {
+        cancelRequest(id);
     }
-    m_usingFallback = false;
+    // Following restarts from the new servers' tip
+    m_deliveredBlocks.clear();
+    emit sourceChanged();
     // Don't check connection immediately - let the caller do it when ready
 }
 
-void ArchivasRpcClient::setFallbackUrl(const QString& url)
+void ArchivasRpcClient::setEmbeddedRpcBind(const QString& bind)
 {
-    m_fallbackUrl = url.trimmed();
-    // Remove trailing slash
-    while (m_fallbackUrl.endsWith('/')) {
-        m_fallbackUrl.chop(1);
+    m_embeddedRpcBind = bind.trimmed();
+}
+
+void ArchivasRpcClient::setCacheTtl(int ttlMs)
+{
+    m_cacheTtlMs = qMax(0, ttlMs);
+    if (m_cacheTtlMs == 0) {
+        m_cache.clear();
     }
 }
 
-QNetworkReply* ArchivasRpcClient::makeGetRequest(const QString& endpoint)
+void ArchivasRpcClient::setRequestTimeout(int timeoutMs)
 {
-    QString endpointClean = endpoint.trimmed();
-    // Remove leading slash if present
-    if (endpointClean.startsWith('/')) {
-        endpointClean = endpointClean.mid(1);
+    m_requestTimeoutMs = qMax(1000, timeoutMs);
+}
+
+QString ArchivasRpcClient::normalizeEndpoint(const QString& endpoint)
+{
+    QString path = endpoint.trimmed();
+    while (path.startsWith('/')) {
+        path = path.mid(1);
     }
-    QString url = m_baseUrl + "/" + endpointClean;
-    QUrl requestUrl(url);
-    QNetworkRequest request(requestUrl);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    int separator = path.indexOf('?');
+    if (separator < 0) {
+        return path;
+    }
+
+    // Order query parameters so "a=1&b=2" and "b=2&a=1" share a request
+    QList<QPair<QString, QString>> items = QUrlQuery(path.mid(separator + 1)).queryItems(QUrl::FullyDecoded);
+    std::sort(items.begin(), items.end());
+    QUrlQuery query;
+    query.setQueryItems(items);
+    return path.left(separator) + "?" + query.query(QUrl::FullyEncoded);
+}
+
+bool ArchivasRpcClient::beginRequest(const QString& key)
+{
+    if (m_inFlight.contains(key)) {
+        // The pending reply is broadcast to every listener
+        ++m_stats.coalesced;
+        return false;
+    }
+
+    auto cached = m_cache.constFind(key);
+    if (cached != m_cache.constEnd() && m_cacheTtlMs > 0 &&
+        QDateTime::currentMSecsSinceEpoch() - cached->fetchedAtMs < m_cacheTtlMs) {
+        ++m_stats.cached;
+        // Delivered from the event loop, like a reply
+        QMetaObject::invokeMethod(this, cached->replay, Qt::QueuedConnection);
+        return false;
+    }
+
+    m_inFlight.insert(key);
+    return true;
+}
+
+void ArchivasRpcClient::finishRequest(const QString& key, const std::function<void()>& replay)
+{
+    m_inFlight.remove(key);
+    if (m_cacheTtlMs > 0) {
+        m_cache.insert(key, CachedResult{QDateTime::currentMSecsSinceEpoch(), replay});
+    }
+    replay();
+}
+
+void ArchivasRpcClient::abandonRequest(const QString& key)
+{
+    m_inFlight.remove(key);
+    if (key.startsWith(kBlockRangeEndpoint)) {
+        // Retried from the cursor on the next chain tip
+        m_blockRangePending = false;
+    }
+}
+
+void ArchivasRpcClient::followBlocks(int window)
+{
+    if (m_blockWindow == 0) {
+        connect(this, &ArchivasRpcClient::chainTipUpdated, this, &ArchivasRpcClient::onFollowedChainTip);
+    }
+    m_blockWindow = qMax(1, window);
+}
+
+void ArchivasRpcClient::onFollowedChainTip(const ChainTip& tip)
+{
+    // A tip with neither height nor hash did not parse
+    if (m_blockRangePending || (tip.height == 0 && tip.hash.isNull())) {
+        return;
+    }
+    quint64 height = tip.height;
+
+    quint64 window = static_cast<quint64>(m_blockWindow);
+    quint64 windowStart = height + 1 > window ? height + 1 - window : 0;
+    quint64 from = windowStart;
+    if (!m_deliveredBlocks.isEmpty() && height < m_deliveredBlocks.lastKey()) {
+        // The chain got shorter
+        rewindBlocks(height + 1);
+    }
+    if (!m_deliveredBlocks.isEmpty()) {
+        quint64 cursor = m_deliveredBlocks.lastKey();
+        if (height > cursor) {
+            from = cursor + 1;
+        } else {
+            Hash32 known = m_deliveredBlocks.value(height);
+            if (tip.hash.isNull() || known.isNull() || tip.hash == known) {
+                // Tip unchanged: no range request and nothing for the views to redo
+                return;
+            }
+            // Same height, different block: refetch the window so the fork point shows up
+        }
+    }
+    requestBlockRange(from, static_cast<int>(qMin<quint64>(height - from + 1, kMaxBlockRange)));
+}
+
+void ArchivasRpcClient::subscribe(const QString& url)
+{
+    QString clean = url.trimmed();
+    if (clean == m_streamUrl) {
+        return;
+    }
+    closeStream();
+    m_streamUrl = clean;
+    m_streamRetryMs = kStreamRetryMinMs;
+    openStream();
+}
+
+void ArchivasRpcClient::openStream()
+{
+    if (m_streamUrl.isEmpty() || m_streamReply) {
+        return;
+    }
+
+    QNetworkRequest request{QUrl(m_streamUrl)};
+    request.setRawHeader("Accept", "text/event-stream");
     request.setRawHeader("User-Agent", "Archivas-Core-GUI/1.0");
+    request.setTransferTimeout(kStreamIdleTimeoutMs);
+    // Resume after the newest block the views have, so nothing in between is lost
+    if (!m_deliveredBlocks.isEmpty()) {
+        request.setRawHeader("Last-Event-ID", QByteArray::number(m_deliveredBlocks.lastKey()));
+    } else if (!m_streamLastId.isEmpty()) {
+        request.setRawHeader("Last-Event-ID", m_streamLastId);
+    }
 
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, QOverload<QNetworkReply::NetworkError>::of(&QNetworkReply::errorOccurred),
-            this, &ArchivasRpcClient::onNetworkError);
+    m_streamReply = m_directManager->get(request);
+    connect(m_streamReply, &QNetworkReply::readyRead, this, &ArchivasRpcClient::onStreamReadyRead);
+    connect(m_streamReply, &QNetworkReply::finished, this, &ArchivasRpcClient::onStreamFinished);
+}
+
+void ArchivasRpcClient::closeStream()
+{
+    if (m_streamReply) {
+        // Disconnected first so the abort does not schedule a reconnect
+        m_streamReply->disconnect(this);
+        m_streamReply->abort();
+        m_streamReply->deleteLater();
+        m_streamReply = nullptr;
+    }
+    m_streamBuffer.clear();
+    m_streamEvent.clear();
+    m_streamData.clear();
+    if (m_streamLive) {
+        m_streamLive = false;
+        emit subscriptionChanged(false);
+    }
+}
+
+void ArchivasRpcClient::onStreamReadyRead()
+{
+    if (m_streamReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) {
+        // Likely a node without the stream; finished() retries with backoff
+        m_streamReply->readAll();
+        return;
+    }
+    if (!m_streamLive) {
+        m_streamLive = true;
+        m_streamRetryMs = kStreamRetryMinMs;
+        emit subscriptionChanged(true);
+    }
+
+    m_streamBuffer.append(m_streamReply->readAll());
+    int end;
+    while ((end = m_streamBuffer.indexOf('\n')) >= 0) {
+        QByteArray line = m_streamBuffer.left(end);
+        m_streamBuffer.remove(0, end + 1);
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+
+        if (line.isEmpty()) {
+            // A blank line ends the event
+            if (!m_streamData.isEmpty()) {
+                dispatchStreamEvent(m_streamEvent, m_streamData);
+            }
+            m_streamEvent.clear();
+            m_streamData.clear();
+            continue;
+        }
+        if (line.startsWith(':')) {
+            continue; // Comment, used for keep-alives
+        }
+
+        int colon = line.indexOf(':');
+        QByteArray field = colon < 0 ? line : line.left(colon);
+        QByteArray value = colon < 0 ? QByteArray() : line.mid(colon + 1);
+        if (value.startsWith(' ')) {
+            value.remove(0, 1);
+        }
+        if (field == "event") {
+            m_streamEvent = QString::fromUtf8(value);
+        } else if (field == "data") {
+            if (!m_streamData.isEmpty()) {
+                m_streamData.append('\n');
+            }
+            m_streamData.append(value);
+        } else if (field == "id") {
+            m_streamLastId = value;
+        }
+    }
+}
+
+void ArchivasRpcClient::onStreamFinished()
+{
+    m_streamReply->deleteLater();
+    m_streamReply = nullptr;
+    closeStream();
+
+    // Reconnect unless unsubscribed meanwhile
+    QTimer::singleShot(m_streamRetryMs, this, [this]() { openStream(); });
+    m_streamRetryMs = qMin(m_streamRetryMs * 2, kStreamRetryMaxMs);
+}
+
+void ArchivasRpcClient::dispatchStreamEvent(const QString& event, const QByteArray& data)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject()) {
+        return;
+    }
+    QJsonObject obj = doc.object();
+
+    if (event == "block") {
+        QList<BlockInfo> blocks = parseBlocks(QJsonArray{obj});
+        // Only a block directly above the cursor can be applied on its own.
+        // Anything else waits for the tip event, which fetches the range.
+        if (blocks.isEmpty() || m_blockWindow == 0 || m_blockRangePending || m_deliveredBlocks.isEmpty() ||
+            blocks.first().height != m_deliveredBlocks.lastKey() + 1) {
+            return;
+        }
+        applyBlockRange(blocks);
+    } else if (event == "tip") {
+        // Sequenced like a reply, so a poll still in flight cannot overwrite it
+        if (!acceptResult(resourceOf(normalizeEndpoint("chainTip")), m_nextRequestId++)) {
+            return;
+        }
+        ChainTip tip = parseChainTip(obj);
+        std::function<void()> replay = [this, tip]() { emit chainTipUpdated(tip); };
+        if (m_cacheTtlMs > 0) {
+            m_cache.insert(normalizeEndpoint("chainTip"), CachedResult{QDateTime::currentMSecsSinceEpoch(), replay});
+        }
+        replay();
+    } else if (event == "tx") {
+        QList<TransactionInfo> txs = parseTransactions(QJsonArray{obj});
+        if (!txs.isEmpty()) {
+            emit mempoolTransactionAdded(txs.first());
+        }
+    }
+}
 
-    return reply;
+void ArchivasRpcClient::requestBlockRange(quint64 from, int limit)
+{
+    m_blockRangePending = true;
+    if (useEmbeddedNode()) {
+        queryEmbeddedBlockRange(from, limit);
+        return;
+    }
+    makeGetRequest(QString("%1?from=%2&limit=%3").arg(kBlockRangeEndpoint).arg(from).arg(limit),
+                   &ArchivasRpcClient::parseBlockRangeReply);
 }
 
-QNetworkReply* ArchivasRpcClient::makePostRequest(const QString& endpoint, const QByteArray& data)
+void ArchivasRpcClient::applyBlockRange(const QList<BlockInfo>& blocks)
 {
-    QString endpointClean = endpoint.trimmed();
-    // Remove leading slash if present
-    if (endpointClean.startsWith('/')) {
-        endpointClean = endpointClean.mid(1);
+    m_blockRangePending = false;
+
+    QList<BlockInfo> appended;
+    bool forked = false;
+    for (const BlockInfo& block : blocks) {
+        quint64 height = block.height;
+        if (!forked) {
+            auto known = m_deliveredBlocks.constFind(height);
+            if (known != m_deliveredBlocks.constEnd()) {
+                if (*known == block.hash) {
+                    continue; // Delivered already
+                }
+                forked = true;
+                rewindBlocks(height);
+            } else if (height > 0 && !block.prevHash.isNull()) {
+                auto parent = m_deliveredBlocks.constFind(height - 1);
+                if (parent != m_deliveredBlocks.constEnd() && *parent != block.prevHash) {
+                    // The fork is below this range: drop a window and refetch on the next tip
+                    quint64 window = static_cast<quint64>(m_blockWindow);
+                    rewindBlocks(qMax(m_deliveredBlocks.firstKey(), height > window ? height - window : 0));
+                    return;
+                }
+            }
+        }
+        appended.append(block);
     }
-    QString url = m_baseUrl + "/" + endpointClean;
-    QUrl requestUrl(url);
+
+    if (appended.isEmpty()) {
+        return;
+    }
+    for (const BlockInfo& block : appended) {
+        m_deliveredBlocks.insert(block.height, block.hash);
+    }
+    int tracked = qMax(m_blockWindow, kMinTrackedBlocks);
+    while (m_deliveredBlocks.size() > tracked) {
+        m_deliveredBlocks.erase(m_deliveredBlocks.begin());
+    }
+    emit blocksAppended(appended);
+}
+
+void ArchivasRpcClient::rewindBlocks(quint64 fromHeight)
+{
+    m_deliveredBlocks.erase(m_deliveredBlocks.lowerBound(fromHeight), m_deliveredBlocks.end());
+    emit reorgDetected(fromHeight);
+}
+
+void ArchivasRpcClient::makeGetRequest(const QString& endpoint, ReplyParser parse)
+{
+    PendingRequest request;
+    request.endpoint = normalizeEndpoint(endpoint);
+    request.key = request.endpoint;
+    request.parse = parse;
+    startRequest(request);
+}
+
+void ArchivasRpcClient::makePostRequest(const QString& endpoint, const QByteArray& data)
+{
+    PendingRequest request;
+    request.endpoint = normalizeEndpoint(endpoint);
+    request.body = data;
+    request.post = true;
+    startRequest(request);
+}
+
+void ArchivasRpcClient::startRequest(PendingRequest request)
+{
+    QString baseUrl = m_endpointPool->pick();
+    if (baseUrl.isEmpty()) {
+        abandonRequest(request.key);
+        emit error("No RPC endpoint configured");
+        return;
+    }
+    if (request.resource.isEmpty()) {
+        request.resource = resourceOf(request.endpoint);
+    }
+    request.deadlineMs = m_clock.elapsed() + m_requestTimeoutMs;
+    quint64 id = m_nextRequestId++;
+
+    if (!request.post) {
+        // Identical GETs coalesce before getting here, so an older request for
+        // the same resource asks for something else (another limit or range).
+        // Its result would be replaced by this one; stop waiting for it.
+        auto latest = m_latestRequest.constFind(request.resource);
+        if (latest != m_latestRequest.constEnd() && m_requests.contains(*latest)) {
+            ++m_stats.superseded;
+            cancelRequest(*latest);
+        }
+        m_latestRequest.insert(request.resource, id);
+    }
+
+    m_requests.insert(id, request);
+    QTimer::singleShot(m_requestTimeoutMs, this, [this, id]() { expireRequest(id); });
+    sendRequest(id, baseUrl);
+}
+
+void ArchivasRpcClient::cancelRequest(quint64 id)
+{
+    // Taken out first: aborted replies finish synchronously and must not be
+    // mistaken for failures of a live request
+    PendingRequest request = m_requests.take(id);
+    for (QNetworkReply* reply : request.replies) {
+        reply->abort();
+    }
+    abandonRequest(request.key);
+}
+
+void ArchivasRpcClient::expireRequest(quint64 id)
+{
+    auto it = m_requests.constFind(id);
+    if (it == m_requests.constEnd()) {
+        return;
+    }
+    // The endpoints still holding the request are the ones that hung
+    for (QNetworkReply* reply : it->replies) {
+        m_endpointPool->recordFailure(reply->property("rpcEndpoint").toString());
+    }
+    QString endpoint = it->endpoint;
+    ++m_stats.timedOut;
+    cancelRequest(id);
+    emit error(QString("Request timed out: /%1").arg(endpoint));
+}
+
+bool ArchivasRpcClient::acceptResult(const QString& resource, quint64 sequence)
+{
+    quint64& delivered = m_deliveredSequence[resource];
+    if (sequence < delivered) {
+        // A request issued later has already been answered
+        ++m_stats.stale;
+        return false;
+    }
+    delivered = sequence;
+    return true;
+}
+
+QString ArchivasRpcClient::resourceOf(const QString& endpoint)
+{
+    int separator = endpoint.indexOf('?');
+    return separator < 0 ? endpoint : endpoint.left(separator);
+}
+
+void ArchivasRpcClient::sendRequest(quint64 id, const QString& baseUrl)
+{
+    PendingRequest& pending = m_requests[id];
+
+    QUrl requestUrl(baseUrl + "/" + pending.endpoint);
     QNetworkRequest request(requestUrl);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     request.setRawHeader("User-Agent", "Archivas-Core-GUI/1.0");
+    // A stalled endpoint fails early enough to leave time for the next one
+    qint64 remainingMs = pending.deadlineMs - m_clock.elapsed();
+    request.setTransferTimeout(static_cast<int>(qBound<qint64>(1, remainingMs, m_requestTimeoutMs / 2)));
 
-    QNetworkReply* reply = m_networkManager->post(request, data);
+    QNetworkReply* reply = pending.post
+        ? m_networkManager->post(request, pending.body)
+        : m_networkManager->get(request);
+    reply->setProperty("rpcRequest", id);
+    reply->setProperty("rpcEndpoint", baseUrl);
+    reply->setProperty("rpcStartedMs", m_clock.elapsed());
+    pending.tried.append(baseUrl);
+    pending.replies.append(reply);
+    ++m_stats.issued;
     connect(reply, QOverload<QNetworkReply::NetworkError>::of(&QNetworkReply::errorOccurred),
             this, &ArchivasRpcClient::onNetworkError);
 
-    return reply;
+    if (!m_hedging || pending.post) {
+        return;
+    }
+    // Hedge: if this endpoint is slower than it usually is, ask the next one too
+    int attempt = pending.tried.size();
+    QTimer::singleShot(m_endpointPool->p95LatencyMs(baseUrl), this, [this, id, attempt]() {
+        auto it = m_requests.find(id);
+        if (it == m_requests.end() || it->tried.size() != attempt || it->replies.isEmpty()) {
+            return;
+        }
+        QString next = m_endpointPool->pick(it->tried);
+        if (next.isEmpty()) {
+            return;
+        }
+        ++m_stats.hedged;
+        sendRequest(id, next);
+    });
 }
 
 void ArchivasRpcClient::getChainTip()
 {
-    makeGetRequest("chainTip");
+    QString key = normalizeEndpoint("chainTip");
+    if (!beginRequest(key)) {
+        return;
+    }
+    if (useEmbeddedNode()) {
+        queryEmbeddedChainTip(key);
+        return;
+    }
+    makeGetRequest(key, &ArchivasRpcClient::parseTipReply);
 }
 
 void ArchivasRpcClient::getRecentBlocks(int limit)
 {
-    makeGetRequest(QString("blocks/recent?limit=%1").arg(limit));
+    QString key = normalizeEndpoint(QString("blocks/recent?limit=%1").arg(limit));
+    if (!beginRequest(key)) {
+        return;
+    }
+    if (useEmbeddedNode()) {
+        queryEmbeddedBlocks(key, limit);
+        return;
+    }
+    makeGetRequest(key, &ArchivasRpcClient::parseBlocksReply);
 }
 
 void ArchivasRpcClient::getRecentTransactions(int limit)
 {
-    makeGetRequest(QString("tx/recent?limit=%1").arg(limit));
+    QString key = normalizeEndpoint(QString("tx/recent?limit=%1").arg(limit));
+    if (!beginRequest(key)) {
+        return;
+    }
+    if (useEmbeddedNode()) {
+        queryEmbeddedTransactions(key, limit);
+        return;
+    }
+    makeGetRequest(key, &ArchivasRpcClient::parseTransactionsReply);
 }
 
 void ArchivasRpcClient::getAccount(const QString& address)
 {
-    makeGetRequest(QString("account/%1").arg(address));
+    QString key = normalizeEndpoint(QString("account/%1").arg(address));
+    if (!beginRequest(key)) {
+        return;
+    }
+    makeGetRequest(key, &ArchivasRpcClient::parseAccountReply);
+}
+
+void ArchivasRpcClient::getBlockPage(quint64 from, int limit)
+{
+    QString key = QString("%1%2/%3").arg(kBlockPageKey).arg(from).arg(limit);
+    if (!beginRequest(key)) {
+        return;
+    }
+    if (useEmbeddedNode()) {
+        queryEmbeddedBlockPage(key, from, limit);
+        return;
+    }
+
+    // Each page is a resource of its own, so pages requested while scrolling
+    // do not supersede one another or the cursor's range requests
+    PendingRequest request;
+    request.endpoint = normalizeEndpoint(QString("%1?from=%2&limit=%3").arg(kBlockRangeEndpoint).arg(from).arg(limit));
+    request.key = key;
+    request.resource = key;
+    request.parse = &ArchivasRpcClient::parseBlockPageReply;
+    startRequest(request);
 }
 
 void ArchivasRpcClient::submitTransaction(const QByteArray& txData)
 {
+    // Balances and recent transactions are about to change
+    m_cache.clear();
     makePostRequest("submit", txData);
 }
 
+RpcBatch& RpcBatch::accounts(const QStringList& addresses)
+{
+    for (const QString& address : addresses) {
+        if (!m_accounts.contains(address)) {
+            m_accounts.append(address);
+        }
+    }
+    return *this;
+}
+
+QFuture<RpcBatchResult> RpcBatch::send()
+{
+    return m_client->sendBatch(*this);
+}
+
+QFuture<RpcBatchResult> ArchivasRpcClient::sendBatch(const RpcBatch& batch)
+{
+    QFutureInterface<RpcBatchResult> promise;
+    promise.reportStarted();
+
+    // /batch is served by the node's stream service (node.stream_bind, see
+    // stream.go) rather than its RPC server, so it sits next to /events
+    QString batchUrl;
+    if (!m_streamUrl.isEmpty()) {
+        batchUrl = QUrl(m_streamUrl).resolved(QUrl("batch")).toString();
+    }
+    if (batchUrl.isEmpty() || useEmbeddedNode() || m_noBatchEndpoints.contains(batchUrl)) {
+        // The embedded node answers in-process, which beats any round trip
+        sendBatchParallel(batch, promise);
+        return promise.future();
+    }
+
+    QJsonObject body;
+    if (batch.m_tip) {
+        body["chainTip"] = true;
+    }
+    if (batch.m_blocks > 0) {
+        body["recentBlocks"] = batch.m_blocks;
+    }
+    if (batch.m_txs > 0) {
+        body["recentTxs"] = batch.m_txs;
+    }
+    if (!batch.m_accounts.isEmpty()) {
+        body["accounts"] = QJsonArray::fromStringList(batch.m_accounts);
+    }
+
+    QNetworkRequest request{QUrl(batchUrl)};
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("User-Agent", "Archivas-Core-GUI/1.0");
+    request.setTransferTimeout(m_requestTimeoutMs);
+    QNetworkReply* reply = m_directManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    ++m_stats.issued;
+
+    quint64 sequence = m_nextRequestId++;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, batch, promise, batchUrl, sequence]() mutable {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            if (status == 404 || status == 405) {
+                // Reachable, just without /batch: stop asking it
+                m_noBatchEndpoints.insert(batchUrl);
+            }
+            // Individual requests bring failover and retries with them
+            sendBatchParallel(batch, promise);
+            return;
+        }
+
+        markConnected();
+        ++m_stats.batched;
+        QByteArray data = reply->readAll();
+        m_parsePool->start([this, batch, promise, sequence, data]() mutable {
+            RpcBatchResult result = parseBatchReply(data);
+            QMetaObject::invokeMethod(this, [this, batch, promise, sequence, result]() mutable {
+                deliverBatch(batch, sequence, result);
+                promise.reportResult(result);
+                promise.reportFinished();
+            }, Qt::QueuedConnection);
+        });
+    });
+    return promise.future();
+}
+
+void ArchivasRpcClient::sendBatchParallel(const RpcBatch& batch, QFutureInterface<RpcBatchResult> promise)
+{
+    // Gathers the broadcast results of the individual requests. An identical
+    // request from another caller may answer first; its result is as fresh.
+    struct Collector {
+        QFutureInterface<RpcBatchResult> promise;
+        RpcBatchResult result;
+        bool wantTip = false;
+        bool wantBlocks = false;
+        bool wantTxs = false;
+        QList<Address> wantAccounts;
+        QList<QMetaObject::Connection> connections;
+        bool finished = false;
+    };
+    auto collector = std::make_shared<Collector>();
+    collector->promise = promise;
+    collector->wantTip = batch.m_tip;
+    collector->wantBlocks = batch.m_blocks > 0;
+    collector->wantTxs = batch.m_txs > 0;
+    for (const QString& address : batch.m_accounts) {
+        collector->wantAccounts.append(Address::intern(address));
+    }
+
+    auto finish = [collector](bool ok) {
+        if (collector->finished) {
+            return;
+        }
+        collector->finished = true;
+        for (const QMetaObject::Connection& connection : collector->connections) {
+            QObject::disconnect(connection);
+        }
+        collector->result.ok = ok;
+        collector->promise.reportResult(collector->result);
+        collector->promise.reportFinished();
+    };
+    auto check = [collector, finish]() {
+        if (!collector->wantTip && !collector->wantBlocks && !collector->wantTxs &&
+            collector->wantAccounts.isEmpty()) {
+            finish(true);
+        }
+    };
+
+    if (collector->wantTip) {
+        collector->connections << connect(this, &ArchivasRpcClient::chainTipUpdated, this,
+                                          [collector, check](const ChainTip& tip) {
+            if (collector->wantTip) {
+                collector->wantTip = false;
+                collector->result.hasTip = true;
+                collector->result.tip = tip;
+                check();
+            }
+        });
+    }
+    if (collector->wantBlocks) {
+        collector->connections << connect(this, &ArchivasRpcClient::blocksUpdated, this,
+                                          [collector, check](const QList<BlockInfo>& blocks) {
+            if (collector->wantBlocks) {
+                collector->wantBlocks = false;
+                collector->result.blocks = blocks;
+                check();
+            }
+        });
+    }
+    if (collector->wantTxs) {
+        collector->connections << connect(this, &ArchivasRpcClient::transactionsUpdated, this,
+                                          [collector, check](const QList<TransactionInfo>& txs) {
+            if (collector->wantTxs) {
+                collector->wantTxs = false;
+                collector->result.txs = txs;
+                check();
+            }
+        });
+    }
+    if (!collector->wantAccounts.isEmpty()) {
+        collector->connections << connect(this, &ArchivasRpcClient::accountUpdated, this,
+                                          [collector, check](const AccountInfo& account) {
+            int index = collector->wantAccounts.indexOf(account.address);
+            if (index >= 0) {
+                collector->wantAccounts.removeAt(index);
+                collector->result.accounts.append(account);
+                check();
+            }
+        });
+    }
+    // Failures are not attributable to one caller; give up at the request deadline
+    QTimer::singleShot(m_requestTimeoutMs, this, [finish]() { finish(false); });
+
+    if (batch.m_tip) {
+        getChainTip();
+    }
+    if (batch.m_blocks > 0) {
+        getRecentBlocks(batch.m_blocks);
+    }
+    if (batch.m_txs > 0) {
+        getRecentTransactions(batch.m_txs);
+    }
+    for (const QString& address : batch.m_accounts) {
+        getAccount(address);
+    }
+    check(); // Nothing was asked for
+}
+
+void ArchivasRpcClient::deliverBatch(const RpcBatch& batch, quint64 sequence, const RpcBatchResult& result)
+{
+    if (!result.ok) {
+        emit error("Failed to parse JSON response");
+        return;
+    }
+    // Sequenced like the single requests they stand in for
+    if (result.hasTip && acceptResult("chainTip", sequence)) {
+        emit chainTipUpdated(result.tip);
+    }
+    if (batch.m_blocks > 0 && acceptResult("blocks/recent", sequence)) {
+        emit blocksUpdated(result.blocks);
+    }
+    if (batch.m_txs > 0 && acceptResult("tx/recent", sequence)) {
+        emit transactionsUpdated(result.txs);
+    }
+    for (const AccountInfo& account : result.accounts) {
+        if (acceptResult("account/" + account.address.toString(), sequence)) {
+            emit accountUpdated(account);
+        }
+    }
+}
+
+RpcBatchResult ArchivasRpcClient::parseBatchReply(const QByteArray& data)
+{
+    RpcBatchResult result;
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        result.ok = false;
+        return result;
+    }
+
+    // Each member is shaped like the reply of its single-resource endpoint
+    QJsonObject obj = doc.object();
+    if (obj.contains("chainTip")) {
+        result.hasTip = true;
+        result.tip = parseChainTip(obj["chainTip"].toObject());
+    }
+    result.blocks = parseBlocks(obj["recentBlocks"].toArray());
+    result.txs = parseTransactions(obj["recentTxs"].toArray());
+    for (const QJsonValue& value : obj["accounts"].toArray()) {
+        result.accounts.append(parseAccount(value.toObject()));
+    }
+    return result;
+}
+
 void ArchivasRpcClient::checkConnection()
 {
     // Try to ping the base URL
     getChainTip();
 }
 
-void ArchivasRpcClient::onReplyFinished(QNetworkReply* reply)
+void ArchivasRpcClient::markConnected()
+{
+    if (!m_connected) {
+        m_connected = true;
+        emit connected();
+    }
+}
+
+bool ArchivasRpcClient::useEmbeddedNode() const
+{
+    if (m_embeddedRpcBind.isEmpty() || !archivas_node_is_running()) {
+        return false;
+    }
+
+    // Only short-circuit requests that would have reached the embedded node anyway
+    int separator = m_embeddedRpcBind.lastIndexOf(':');
+    QUrl url(currentUrl());
+    if (separator < 0 || url.port(80) != m_embeddedRpcBind.mid(separator + 1).toInt()) {
+        return false;
+    }
+    QString host = url.host();
+    return host == "127.0.0.1" || host == "localhost" || host == m_embeddedRpcBind.left(separator);
+}
+
+void ArchivasRpcClient::queryEmbeddedChainTip(const QString& key)
+{
+    // Results are delivered from the event loop, like HTTP replies, and are
+    // sequenced with them so a slow HTTP reply cannot overwrite this one
+    quint64 sequence = m_nextRequestId++;
+    QMetaObject::invokeMethod(this, [this, key, sequence]() {
+        // Read from the published tip, so it never waits on block application
+        archivas_block_record record;
+        if (archivas_node_get_tip(&record) != 1) {
+            // Reported like a failed HTTP request, so the status bar shows the outage
+            abandonRequest(key);
+            emit error("Embedded node has no chain tip");
+            emit disconnected();
+            m_connected = false;
+            return;
+        }
+        ChainTip tip;
+        tip.height = record.height;
+        tip.hash = Hash32::fromBytes(record.hash);
+        tip.difficulty = record.difficulty;
+        tip.timestamp = record.timestamp;
+        markConnected();
+        if (!acceptResult(resourceOf(key), sequence)) {
+            abandonRequest(key);
+            return;
+        }
+        finishRequest(key, [this, tip]() { emit chainTipUpdated(tip); });
+    }, Qt::QueuedConnection);
+}
+
+// The range copies below wait on the chain's read lock, which block
+// application holds across its disk writes, so they run on the parse pool and
+// only the converted result comes back to this thread.
+
+void ArchivasRpcClient::queryEmbeddedBlocks(const QString& key, int limit)
+{
+    quint64 sequence = m_nextRequestId++;
+    if (limit <= 0) {
+        QMetaObject::invokeMethod(this, [this, key]() { abandonRequest(key); }, Qt::QueuedConnection);
+        return;
+    }
+    m_parsePool->start([this, key, limit, sequence]() {
+        uint64_t height = 0;
+        int count = -1;
+        QVector<archivas_block_record> records;
+        if (archivas_node_get_height_into(&height) == 1) {
+            uint64_t from = height + 1 > static_cast<uint64_t>(limit) ? height + 1 - limit : 0;
+            records.resize(limit);
+            count = archivas_node_get_blocks(from, limit, records.data());
+        }
+
+        QList<BlockInfo> blocks;
+        blocks.reserve(qMax(0, count));
+        for (int i = 0; i < count; ++i) {
+            blocks.append(blockFromRecord(records[i]));
+        }
+        QMetaObject::invokeMethod(this, [this, key, sequence, count, blocks]() {
+            if (count < 0) {
+                abandonRequest(key);
+                return;
+            }
+            markConnected();
+            if (!acceptResult(resourceOf(key), sequence)) {
+                abandonRequest(key);
+                return;
+            }
+            finishRequest(key, [this, blocks]() { emit blocksUpdated(blocks); });
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ArchivasRpcClient::queryEmbeddedBlockRange(quint64 from, int limit)
+{
+    m_parsePool->start([this, from, limit]() {
+        QVector<archivas_block_record> records(qMax(0, limit));
+        int count = archivas_node_get_blocks(from, limit, records.data());
+
+        QList<BlockInfo> blocks;
+        blocks.reserve(qMax(0, count));
+        for (int i = 0; i < count; ++i) {
+            blocks.append(blockFromRecord(records[i]));
+        }
+        QMetaObject::invokeMethod(this, [this, count, blocks]() {
+            if (count < 0) {
+                m_blockRangePending = false;
+                return;
+            }
+            markConnected();
+            applyBlockRange(blocks);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ArchivasRpcClient::queryEmbeddedBlockPage(const QString& key, quint64 from, int limit)
+{
+    if (limit <= 0) {
+        QMetaObject::invokeMethod(this, [this, key]() { abandonRequest(key); }, Qt::QueuedConnection);
+        return;
+    }
+    m_parsePool->start([this, key, from, limit]() {
+        QVector<archivas_block_record> records(limit);
+        int count = archivas_node_get_blocks(from, limit, records.data());
+
+        QList<BlockInfo> blocks;
+        QList<TransactionInfo> txs;
+        bool consistent = count >= 0;
+        if (consistent) {
+            blocks.reserve(count);
+            int txCount = 0;
+            for (int i = 0; i < count; ++i) {
+                blocks.append(blockFromRecord(records[i]));
+                txCount += static_cast<int>(records[i].tx_count);
+            }
+            QVector<archivas_tx_record> txRecords(txCount);
+            int copied = archivas_node_get_block_txs(from, count, txRecords.data(), txCount);
+            txs.reserve(qMax(0, copied));
+            for (int i = 0; i < copied; ++i) {
+                txs.append(txFromRecord(txRecords[i]));
+            }
+            // The chain moved between the two calls; keep the pair consistent
+            consistent = copied == txCount;
+        }
+        QMetaObject::invokeMethod(this, [this, key, from, consistent, blocks, txs]() {
+            if (!consistent) {
+                abandonRequest(key);
+                return;
+            }
+            markConnected();
+            finishRequest(key, [this, from, blocks, txs]() { emit blockPageLoaded(from, blocks, txs); });
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ArchivasRpcClient::queryEmbeddedTransactions(const QString& key, int limit)
 {
-    if (reply->error() != QNetworkReply::NoError) {
-        // Try fallback if not already using it
-        if (!m_usingFallback && !m_fallbackUrl.isEmpty()) {
-            QString originalUrl = m_baseUrl;
-            m_baseUrl = m_fallbackUrl;
-            m_usingFallback = true;
-            // Retry the request - extract endpoint from the original URL
-            QUrl originalRequestUrl = reply->request().url();
-            QString endpoint = originalRequestUrl.path();
-            if (endpoint.startsWith('/')) {
-                endpoint = endpoint.mid(1);
+    quint64 sequence = m_nextRequestId++;
+    if (limit <= 0) {
+        QMetaObject::invokeMethod(this, [this, key]() { abandonRequest(key); }, Qt::QueuedConnection);
+        return;
+    }
+    m_parsePool->start([this, key, limit, sequence]() {
+        QVector<archivas_tx_record> records(limit);
+        int count = archivas_node_get_recent_txs(limit, records.data());
+
+        QList<TransactionInfo> txs;
+        txs.reserve(qMax(0, count));
+        for (int i = 0; i < count; ++i) {
+            txs.append(txFromRecord(records[i]));
+        }
+        QMetaObject::invokeMethod(this, [this, key, sequence, count, txs]() {
+            if (count < 0) {
+                abandonRequest(key);
+                return;
             }
-            if (originalRequestUrl.hasQuery()) {
-                endpoint += "?" + originalRequestUrl.query();
+            markConnected();
+            if (!acceptResult(resourceOf(key), sequence)) {
+                abandonRequest(key);
+                return;
             }
-            makeGetRequest(endpoint);
-            reply->deleteLater();
+            finishRequest(key, [this, txs]() { emit transactionsUpdated(txs); });
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ArchivasRpcClient::onReplyFinished(QNetworkReply* reply)
+{
+    reply->deleteLater();
+    quint64 id = reply->property("rpcRequest").toULongLong();
+    QString baseUrl = reply->property("rpcEndpoint").toString();
+    qint64 latencyMs = m_clock.elapsed() - reply->property("rpcStartedMs").toLongLong();
+    bool failed = reply->error() != QNetworkReply::NoError;
+
+    auto it = m_requests.find(id);
+    if (it == m_requests.end()) {
+        // Answered by a hedged copy, superseded or past its deadline; aborted
+        if (!failed) {
+            m_endpointPool->recordSuccess(baseUrl, latencyMs);
+        }
+        return;
+    }
+    it->replies.removeOne(reply);
+
+    if (failed) {
+        m_endpointPool->recordFailure(baseUrl);
+        if (!it->replies.isEmpty()) {
+            return; // A hedged copy is still running
+        }
+        // Resend to the next endpoint with the same method and body. The
+        // request keeps its single-flight slot, so callers keep coalescing onto it.
+        QString next = m_endpointPool->pick(it->tried);
+        if (!next.isEmpty()) {
+            ++m_stats.retried;
+            sendRequest(id, next);
             return;
         }
 
+        QString key = it->key;
+        m_requests.erase(it);
+        abandonRequest(key);
         emit error(reply->errorString());
         emit disconnected();
         m_connected = false;
-        reply->deleteLater();
         return;
     }
 
-    if (!m_connected) {
-        m_connected = true;
-        emit connected();
+    m_endpointPool->recordSuccess(baseUrl, latencyMs);
+    PendingRequest request = m_requests.take(id);
+    for (QNetworkReply* other : request.replies) {
+        other->abort();
+    }
+    markConnected();
+    if (!request.parse) {
+        abandonRequest(request.key);
+        return;
     }
 
+    // Decoding large payloads stalls the GUI, so it happens on the parse pool
+    // and only the typed result comes back to this thread
     QByteArray data = reply->readAll();
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    ReplyParser parse = request.parse;
+    QString key = request.key;
+    QString resource = request.resource;
+    m_parsePool->start([this, id, resource, key, parse, data]() {
+        ParsedReply parsed;
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            parsed.kind = ParsedReply::Invalid;
+        } else {
+            parsed = parse(doc);
+        }
+        QMetaObject::invokeMethod(this, [this, id, resource, key, parsed]() {
+            deliverReply(id, resource, key, parsed);
+        }, Qt::QueuedConnection);
+    });
+}
+
+ArchivasRpcClient::ParsedReply ArchivasRpcClient::parseTipReply(const QJsonDocument& doc)
+{
+    ParsedReply parsed;
+    if (doc.isObject()) {
+        parsed.kind = ParsedReply::Tip;
+        parsed.tip = parseChainTip(doc.object());
+    }
+    return parsed;
+}
+
+ArchivasRpcClient::ParsedReply ArchivasRpcClient::parseBlocksReply(const QJsonDocument& doc)
+{
+    ParsedReply parsed;
+    if (doc.isArray()) {
+        parsed.kind = ParsedReply::Blocks;
+        parsed.blocks = parseBlocks(doc.array());
+    } else if (doc.isObject() && doc.object().contains("blocks")) {
+        parsed.kind = ParsedReply::Blocks;
+        parsed.blocks = parseBlocks(doc.object()["blocks"].toArray());
+    }
+    return parsed;
+}
 
-    if (parseError.error != QJsonParseError::NoError) {
+ArchivasRpcClient::ParsedReply ArchivasRpcClient::parseBlockRangeReply(const QJsonDocument& doc)
+{
+    ParsedReply parsed;
+    if (doc.isObject()) {
+        parsed.kind = ParsedReply::BlockRange;
+        parsed.blocks = parseBlockRange(doc.object()["blocks"].toArray());
+    }
+    return parsed;
+}
+
+ArchivasRpcClient::ParsedReply ArchivasRpcClient::parseBlockPageReply(const QJsonDocument& doc)
+{
+    ParsedReply parsed = parseBlockRangeReply(doc);
+    if (parsed.kind == ParsedReply::BlockRange) {
+        parsed.kind = ParsedReply::BlockPage;
+        parsed.txs = parseBlockRangeTxs(doc.object()["blocks"].toArray());
+    }
+    return parsed;
+}
+
+ArchivasRpcClient::ParsedReply ArchivasRpcClient::parseTransactionsReply(const QJsonDocument& doc)
+{
+    ParsedReply parsed;
+    if (doc.isArray()) {
+        parsed.kind = ParsedReply::Transactions;
+        parsed.txs = parseTransactions(doc.array());
+    } else if (doc.isObject() && doc.object().contains("transactions")) {
+        parsed.kind = ParsedReply::Transactions;
+        parsed.txs = parseTransactions(doc.object()["transactions"].toArray());
+    }
+    return parsed;
+}
+
+ArchivasRpcClient::ParsedReply ArchivasRpcClient::parseAccountReply(const QJsonDocument& doc)
+{
+    ParsedReply parsed;
+    if (doc.isObject()) {
+        parsed.kind = ParsedReply::Account;
+        parsed.account = parseAccount(doc.object());
+    }
+    return parsed;
+}
+
+void ArchivasRpcClient::deliverReply(quint64 sequence, const QString& resource,
+                                     const QString& key, const ParsedReply& parsed)
+{
+    if (parsed.kind == ParsedReply::Invalid) {
+        abandonRequest(key);
         emit error("Failed to parse JSON response");
-        reply->deleteLater();
         return;
     }
-
-    QString path = reply->url().path();
-
-    if (path.contains("chainTip")) {
-        if (doc.isObject()) {
-            ChainTip tip = parseChainTip(doc.object());
-            emit chainTipUpdated(tip);
-        }
-    } else if (path.contains("blocks/recent")) {
-        if (doc.isArray()) {
-            QList<BlockInfo> blocks = parseBlocks(doc.array());
-            emit blocksUpdated(blocks);
-        } else if (doc.isObject() && doc.object().contains("blocks")) {
-            QList<BlockInfo> blocks = parseBlocks(doc.object()["blocks"].toArray());
-            emit blocksUpdated(blocks);
-        }
-    } else if (path.contains("tx/recent")) {
-        if (doc.isArray()) {
-            QList<TransactionInfo> txs = parseTransactions(doc.array());
-            emit transactionsUpdated(txs);
-        } else if (doc.isObject() && doc.object().contains("transactions")) {
-            QList<TransactionInfo> txs = parseTransactions(doc.object()["transactions"].toArray());
-            emit transactionsUpdated(txs);
-        }
-    } else if (path.contains("account/")) {
-        if (doc.isObject()) {
-            AccountInfo account = parseAccount(doc.object());
-            emit accountUpdated(account);
-        }
+    // Parse jobs can finish out of order, and a slow reply can land after a
+    // newer one for the same resource
+    if (parsed.kind == ParsedReply::Unrecognized || !acceptResult(resource, sequence)) {
+        abandonRequest(key);
+        return;
     }
 
-    reply->deleteLater();
+    // Parsed once; the replay re-emits it to anyone asking within the TTL
+    std::function<void()> replay;
+    switch (parsed.kind) {
+    case ParsedReply::BlockRange:
+        // Cursor-driven, so never cached
+        abandonRequest(key);
+        applyBlockRange(parsed.blocks);
+        return;
+    case ParsedReply::BlockPage: {
+        quint64 from = key.section('/', 1, 1).toULongLong();
+        QList<BlockInfo> blocks = parsed.blocks;
+        QList<TransactionInfo> txs = parsed.txs;
+        replay = [this, from, blocks, txs]() { emit blockPageLoaded(from, blocks, txs); };
+        break;
+    }
+    case ParsedReply::Tip: {
+        ChainTip tip = parsed.tip;
+        replay = [this, tip]() { emit chainTipUpdated(tip); };
+        break;
+    }
+    case ParsedReply::Blocks: {
+        QList<BlockInfo> blocks = parsed.blocks;
+        replay = [this, blocks]() { emit blocksUpdated(blocks); };
+        break;
+    }
+    case ParsedReply::Transactions: {
+        QList<TransactionInfo> txs = parsed.txs;
+        replay = [this, txs]() { emit transactionsUpdated(txs); };
+        break;
+    }
+    case ParsedReply::Account: {
+        AccountInfo account = parsed.account;
+        replay = [this, account]() { emit accountUpdated(account); };
+        break;
+    }
+    case ParsedReply::Invalid:
+    case ParsedReply::Unrecognized:
+        return;
+    }
+    finishRequest(key, replay);
 }
 
 void ArchivasRpcClient::onNetworkError(QNetworkReply::NetworkError error)
@@ -200,10 +1319,10 @@ void ArchivasRpcClient::onNetworkError(QNetworkReply::NetworkError error)
 ChainTip ArchivasRpcClient::parseChainTip(const QJsonObject& json)
 {
     ChainTip tip;
-    tip.height = json.value("height").toString();
-    tip.hash = json.value("hash").toString();
-    tip.difficulty = json.value("difficulty").toString();
-    tip.timestamp = json.value("timestamp").toString();
+    tip.height = jsonUInt(json.value("height"));
+    tip.hash = Hash32::fromHex(json.value("hash").toString());
+    tip.difficulty = jsonUInt(json.value("difficulty"));
+    tip.timestamp = jsonTimestamp(json.value("timestamp"));
     return tip;
 }
 
@@ -214,18 +1333,65 @@ QList<BlockInfo> ArchivasRpcClient::parseBlocks(const QJsonArray& jsonArray)
         if (value.isObject()) {
             QJsonObject obj = value.toObject();
             BlockInfo block;
-            block.height = obj.value("height").toString();
-            block.hash = obj.value("hash").toString();
-            block.farmer = obj.value("farmer").toString();
-            block.txCount = obj.value("txCount").toInt();
-            block.timestamp = obj.value("timestamp").toString();
-            block.difficulty = obj.value("difficulty").toString();
+            block.height = jsonUInt(obj.value("height"));
+            block.hash = Hash32::fromHex(obj.value("hash").toString());
+            block.prevHash = Hash32::fromHex(obj.value("prevHash").toString());
+            block.farmer = Address::intern(obj.value("farmer").toString());
+            block.txCount = static_cast<quint32>(obj.value("txCount").toInt());
+            block.timestamp = jsonTimestamp(obj.value("timestamp"));
+            block.difficulty = jsonUInt(obj.value("difficulty"));
             blocks.append(block);
         }
     }
     return blocks;
 }
 
+QList<BlockInfo> ArchivasRpcClient::parseBlockRange(const QJsonArray& jsonArray)
+{
+    // /blocks/range returns whole blocks, with numeric fields and a Unix timestamp
+    QList<BlockInfo> blocks;
+    for (const QJsonValue& value : jsonArray) {
+        if (value.isObject()) {
+            QJsonObject obj = value.toObject();
+            BlockInfo block;
+            block.height = jsonUInt(obj.value("height"));
+            block.hash = Hash32::fromHex(obj.value("hash").toString());
+            block.prevHash = Hash32::fromHex(obj.value("prevHash").toString());
+            block.farmer = Address::intern(obj.value("farmerAddr").toString());
+            block.txCount = static_cast<quint32>(obj.value("txs").toArray().size());
+            block.timestamp = jsonTimestamp(obj.value("timestamp"));
+            block.difficulty = jsonUInt(obj.value("difficulty"));
+            blocks.append(block);
+        }
+    }
+    return blocks;
+}
+
+QList<TransactionInfo> ArchivasRpcClient::parseBlockRangeTxs(const QJsonArray& jsonArray)
+{
+    // Transactions inside /blocks/range blocks carry neither hash nor height
+    QList<TransactionInfo> txs;
+    for (const QJsonValue& value : jsonArray) {
+        QJsonObject block = value.toObject();
+        quint64 height = jsonUInt(block.value("height"));
+        qint64 timestamp = jsonTimestamp(block.value("timestamp"));
+        QJsonArray blockTxs = block.value("txs").toArray();
+        for (int i = 0; i < blockTxs.size(); ++i) {
+            QJsonObject obj = blockTxs[i].toObject();
+            TransactionInfo tx;
+            tx.index = static_cast<quint32>(i);
+            tx.from = Address::intern(obj.value("from").toString());
+            tx.to = Address::intern(obj.value("to").toString());
+            tx.amount = jsonInt(obj.value("amount"));
+            tx.fee = jsonInt(obj.value("fee"));
+            tx.height = height;
+            tx.timestamp = timestamp;
+            txs.append(tx);
+        }
+    }
+    return txs;
+}
+
 QList<TransactionInfo> ArchivasRpcClient::parseTransactions(const QJsonArray& jsonArray)
 {
     QList<TransactionInfo> txs;
@@ -233,13 +1399,13 @@ QList<TransactionInfo> ArchivasRpcClient::parseTransactions(const QJsonArray& js
         if (value.isObject()) {
             QJsonObject obj = value.toObject();
             TransactionInfo tx;
-            tx.hash = obj.value("hash").toString();
-            tx.from = obj.value("from").toString();
-            tx.to = obj.value("to").toString();
-            tx.amount = obj.value("amount").toString();
-            tx.fee = obj.value("fee").toString();
-            tx.height = obj.value("height").toString();
-            tx.timestamp = obj.value("timestamp").toString();
+            tx.hash = Hash32::fromHex(obj.value("hash").toString());
+            tx.from = Address::intern(obj.value("from").toString());
+            tx.to = Address::intern(obj.value("to").toString());
+            tx.amount = jsonInt(obj.value("amount"));
+            tx.fee = jsonInt(obj.value("fee"));
+            tx.height = jsonUInt(obj.value("height"));
+            tx.timestamp = jsonTimestamp(obj.value("timestamp"));
             txs.append(tx);
         }
     }
@@ -249,9 +1415,9 @@ QList<TransactionInfo> ArchivasRpcClient::parseTransactions(const QJsonArray& js
 AccountInfo ArchivasRpcClient::parseAccount(const QJsonObject& json)
 {
     AccountInfo account;
-    account.address = json.value("address").toString();
-    account.balance = json.value("balance").toString();
-    account.nonce = json.value("nonce").toString();
+    account.address = Address::intern(json.value("address").toString());
+    account.balance = jsonInt(json.value("balance"));
+    account.nonce = jsonUInt(json.value("nonce"));
     return account;
 }
 
@@ -0,0 +1,350 @@
+#include "blockheadercache.h"
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QTimer>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// File and width in bytes of each column; numbers are little-endian
+static const char* const kColumnFiles[] = {"hash.col", "farmer.col", "txcount.col", "timestamp.col", "difficulty.col"};
+static const int kColumnWidths[] = {32, 64, 4, 8, 8};
+// Number of valid entries, written after the columns so a crash loses only the tail
+static const char kCountFile[] = "count";
+static const char kCountMagic[8] = {'A', 'R', 'C', 'H', 'D', 'R', '0', '1'};
+
+// Files grow by this many entries at a time, so appends rarely remap
+static const quint64 kGrowEntries = 64 * 1024;
+// Blocks per background request, and the wait between requests while catching up
+static const int kPageSize = 100;
+static const int kBackfillIntervalMs = 200;
+// A request unanswered this long is given up on at the next chain tip
+static const qint64 kRequestRetryMs = 30000;
+
+BlockHeaderCache::BlockHeaderCache(ArchivasRpcClient* rpcClient, QObject *parent)
+    : QObject(parent)
+    , m_rpcClient(rpcClient)
+    , m_capacity(0)
+    , m_count(0)
+    , m_dirtyFrom(std::numeric_limits<quint64>::max())
+    , m_hasTip(false)
+    , m_tipHeight(0)
+    , m_verified(false)
+    , m_rewind(kPageSize)
+    , m_requestPending(false)
+    , m_requestFrom(0)
+{
+    for (int i = 0; i < ColumnCount; ++i) {
+        m_files[i] = nullptr;
+        m_maps[i] = nullptr;
+    }
+
+    connect(m_rpcClient, &ArchivasRpcClient::chainTipUpdated, this, &BlockHeaderCache::onChainTipUpdated);
+    connect(m_rpcClient, &ArchivasRpcClient::blocksAppended, this, &BlockHeaderCache::onBlocksAppended);
+    connect(m_rpcClient, &ArchivasRpcClient::reorgDetected, this, &BlockHeaderCache::onReorgDetected);
+    connect(m_rpcClient, &ArchivasRpcClient::sourceChanged, this, &BlockHeaderCache::onSourceChanged);
+    connect(m_rpcClient, &ArchivasRpcClient::blockPageLoaded, this, &BlockHeaderCache::onBlockPageLoaded);
+}
+
+BlockHeaderCache::~BlockHeaderCache()
+{
+    close();
+}
+
+bool BlockHeaderCache::open(const QString& dir)
+{
+    if (dir == m_dir) {
+        return isOpen();
+    }
+    close();
+    if (dir.isEmpty() || !QDir().mkpath(dir)) {
+        return false;
+    }
+
+    quint64 capacity = 0;
+    for (int i = 0; i < ColumnCount; ++i) {
+        m_files[i] = new QFile(QDir(dir).filePath(kColumnFiles[i]));
+        if (!m_files[i]->open(QIODevice::ReadWrite)) {
+            close();
+            return false;
+        }
+        quint64 entries = static_cast<quint64>(m_files[i]->size()) / kColumnWidths[i];
+        capacity = i == 0 ? entries : qMin(capacity, entries);
+    }
+
+    quint64 count = 0;
+    QFile countFile(QDir(dir).filePath(kCountFile));
+    if (countFile.open(QIODevice::ReadOnly)) {
+        QByteArray data = countFile.readAll();
+        if (data.size() == 16 && std::memcmp(data.constData(), kCountMagic, sizeof(kCountMagic)) == 0) {
+            count = qFromLittleEndian<quint64>(data.constData() + 8);
+        }
+    }
+
+    // Map what the shortest column holds; reserve() grows them all together
+    m_dir = dir;
+    m_capacity = 0;
+    if (!reserve(qMax<quint64>(capacity, 1))) {
+        close();
+        return false;
+    }
+    m_count = qMin(count, capacity);
+    m_verified = m_count == 0;
+    m_rewind = kPageSize;
+    emit changed(0);
+    return true;
+}
+
+void BlockHeaderCache::close()
+{
+    for (int i = 0; i < ColumnCount; ++i) {
+        if (m_files[i]) {
+            if (m_maps[i]) {
+                m_files[i]->unmap(m_maps[i]);
+            }
+            delete m_files[i];
+        }
+        m_files[i] = nullptr;
+        m_maps[i] = nullptr;
+    }
+    bool hadEntries = m_count > 0;
+    m_dir.clear();
+    m_capacity = 0;
+    m_count = 0;
+    m_dirtyFrom = std::numeric_limits<quint64>::max();
+    m_requestPending = false;
+    if (hadEntries) {
+        emit changed(0);
+    }
+}
+
+const uchar* BlockHeaderCache::cell(Column column, quint64 height) const
+{
+    return m_maps[column] + height * kColumnWidths[column];
+}
+
+Hash32 BlockHeaderCache::hash(quint64 height) const
+{
+    return Hash32::fromBytes(cell(HashColumn, height));
+}
+
+QString BlockHeaderCache::farmer(quint64 height) const
+{
+    const char* data = reinterpret_cast<const char*>(cell(FarmerColumn, height));
+    return QString::fromLatin1(data, static_cast<int>(qstrnlen(data, kColumnWidths[FarmerColumn])));
+}
+
+quint32 BlockHeaderCache::txCount(quint64 height) const
+{
+    return qFromLittleEndian<quint32>(cell(TxCountColumn, height));
+}
+
+qint64 BlockHeaderCache::timestamp(quint64 height) const
+{
+    return qFromLittleEndian<qint64>(cell(TimestampColumn, height));
+}
+
+quint64 BlockHeaderCache::difficulty(quint64 height) const
+{
+    return qFromLittleEndian<quint64>(cell(DifficultyColumn, height));
+}
+
+BlockInfo BlockHeaderCache::block(quint64 height) const
+{
+    BlockInfo block;
+    block.height = height;
+    block.hash = hash(height);
+    if (height > 0) {
+        block.prevHash = hash(height - 1);
+    }
+    block.farmer = Address::intern(farmer(height));
+    block.txCount = txCount(height);
+    block.timestamp = timestamp(height);
+    block.difficulty = difficulty(height);
+    return block;
+}
+
+bool BlockHeaderCache::reserve(quint64 count)
+{
+    if (count <= m_capacity) {
+        return true;
+    }
+    quint64 capacity = qMax(count, m_capacity + kGrowEntries);
+    for (int i = 0; i < ColumnCount; ++i) {
+        if (m_maps[i]) {
+            m_files[i]->unmap(m_maps[i]);
+            m_maps[i] = nullptr;
+        }
+        qint64 size = static_cast<qint64>(capacity * kColumnWidths[i]);
+        if (m_files[i]->size() < size && !m_files[i]->resize(size)) {
+            return false;
+        }
+        m_maps[i] = m_files[i]->map(0, size);
+        if (!m_maps[i]) {
+            return false;
+        }
+    }
+    m_capacity = capacity;
+    return true;
+}
+
+void BlockHeaderCache::append(const QList<BlockInfo>& blocks)
+{
+    quint64 first = m_count;
+    for (const BlockInfo& block : blocks) {
+        if (block.height < m_count) {
+            continue;
+        }
+        // Only the next height, on top of the newest entry
+        if (block.height != m_count ||
+            (m_count > 0 && !block.prevHash.isNull() && block.prevHash != hash(m_count - 1))) {
+            break;
+        }
+        if (!reserve(m_count + 1)) {
+            close();
+            return;
+        }
+
+        std::memcpy(m_maps[HashColumn] + m_count * kColumnWidths[HashColumn], block.hash.bytes.data(), block.hash.bytes.size());
+        uchar* farmer = m_maps[FarmerColumn] + m_count * kColumnWidths[FarmerColumn];
+        QByteArray address = block.farmer.toString().toLatin1().left(kColumnWidths[FarmerColumn]);
+        std::memset(farmer, 0, kColumnWidths[FarmerColumn]);
+        std::memcpy(farmer, address.constData(), address.size());
+        qToLittleEndian<quint32>(block.txCount, m_maps[TxCountColumn] + m_count * kColumnWidths[TxCountColumn]);
+        qToLittleEndian<qint64>(block.timestamp, m_maps[TimestampColumn] + m_count * kColumnWidths[TimestampColumn]);
+        qToLittleEndian<quint64>(block.difficulty, m_maps[DifficultyColumn] + m_count * kColumnWidths[DifficultyColumn]);
+        ++m_count;
+    }
+    if (m_count != first) {
+        m_dirtyFrom = qMin(m_dirtyFrom, first);
+        saveCount();
+        emit changed(first);
+    }
+}
+
+void BlockHeaderCache::truncate(quint64 count)
+{
+    if (count >= m_count) {
+        return;
+    }
+    // The files keep their size; entries past the count are overwritten later
+    m_count = count;
+    saveCount();
+    emit changed(count);
+}
+
+void BlockHeaderCache::saveCount()
+{
+    // The entries have to reach the disk before a count that covers them, or a
+    // system crash could leave the count pointing at stale bytes
+    if (m_dirtyFrom < m_count) {
+        const quint64 pageSize = static_cast<quint64>(::sysconf(_SC_PAGESIZE));
+        for (int i = 0; i < ColumnCount; ++i) {
+            quint64 begin = m_dirtyFrom * kColumnWidths[i];
+            begin -= begin % pageSize;
+            quint64 end = m_count * kColumnWidths[i];
+            if (::msync(m_maps[i] + begin, end - begin, MS_SYNC) != 0) {
+                return; // The saved count still covers only synced entries
+            }
+        }
+    }
+    m_dirtyFrom = std::numeric_limits<quint64>::max();
+
+    QSaveFile file(QDir(m_dir).filePath(kCountFile));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    char data[16];
+    std::memcpy(data, kCountMagic, sizeof(kCountMagic));
+    qToLittleEndian<quint64>(m_count, data + 8);
+    file.write(data, sizeof(data));
+    file.commit();
+}
+
+void BlockHeaderCache::onChainTipUpdated(const ChainTip& tip)
+{
+    // A tip with neither height nor hash did not parse
+    if (!isOpen() || (tip.height == 0 && tip.hash.isNull())) {
+        return;
+    }
+    m_hasTip = true;
+    m_tipHeight = tip.height;
+    if (m_count > m_tipHeight + 1) {
+        // The chain is shorter than the cache: check what is left of it
+        truncate(m_tipHeight + 1);
+        m_verified = m_count == 0;
+    }
+    if (m_requestPending && m_requestTimer.elapsed() > kRequestRetryMs) {
+        m_requestPending = false;
+    }
+    requestNext();
+}
+
+void BlockHeaderCache::requestNext()
+{
+    if (!isOpen() || !m_hasTip || m_requestPending) {
+        return;
+    }
+    // Unverified, start at the newest entry so its hash can be compared
+    quint64 from = m_verified ? m_count : m_count - 1;
+    if (from > m_tipHeight || (m_verified && m_count > m_tipHeight)) {
+        return;
+    }
+    m_requestPending = true;
+    m_requestFrom = from;
+    m_requestTimer.start();
+    m_rpcClient->getBlockPage(from, kPageSize);
+}
+
+void BlockHeaderCache::onBlockPageLoaded(quint64 from, const QList<BlockInfo>& blocks)
+{
+    if (!m_requestPending || from != m_requestFrom) {
+        return;
+    }
+    m_requestPending = false;
+    if (blocks.isEmpty()) {
+        return; // Retried on the next chain tip
+    }
+
+    if (!m_verified) {
+        if (from >= m_count || blocks.first().height != from || blocks.first().hash != hash(from)) {
+            // Not the node's chain from here: drop a stretch, twice as long
+            // each time, and check the entry below it
+            truncate(m_count > m_rewind ? m_count - m_rewind : 0);
+            m_rewind *= 2;
+            m_verified = m_count == 0;
+            QTimer::singleShot(kBackfillIntervalMs, this, &BlockHeaderCache::requestNext);
+            return;
+        }
+        m_verified = true;
+        m_rewind = kPageSize;
+    }
+
+    append(blocks);
+    QTimer::singleShot(kBackfillIntervalMs, this, &BlockHeaderCache::requestNext);
+}
+
+void BlockHeaderCache::onBlocksAppended(const QList<BlockInfo>& blocks)
+{
+    if (isOpen() && m_verified) {
+        append(blocks);
+    }
+}
+
+void BlockHeaderCache::onReorgDetected(quint64 fromHeight)
+{
+    truncate(fromHeight);
+}
+
+void BlockHeaderCache::onSourceChanged()
+{
+    // Keep the entries, but check them against the new servers' chain before
+    // appending, exactly as at startup; the check starts at their first tip
+    m_hasTip = false;
+    m_verified = m_count == 0;
+    m_rewind = kPageSize;
+    m_requestPending = false;
+}
@@ -0,0 +1,324 @@
+#include "blockhistorymodel.h"
+#include <limits>
+
+// Blocks per page; the most /blocks/range returns in one reply
+static const int kPageSize = 100;
+// Cap on resident pages, counting each page as kPageSize whole records
+static const int kPageCacheBytes = 16 * 1024 * 1024;
+static const int kPageCost = kPageSize * static_cast<int>(sizeof(BlockInfo));
+// A page that came back short, or not at all, is asked for again after this
+static const qint64 kPageRetryMs = 5000;
+
+BlockHistoryModel::BlockHistoryModel(ArchivasRpcClient* rpcClient, BlockHeaderCache* headerCache, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_rpcClient(rpcClient)
+    , m_headerCache(headerCache)
+    , m_hasTip(false)
+    , m_tipHeight(0)
+    , m_pages(kPageCacheBytes)
+    , m_firstVisibleRow(0)
+    , m_scrollDirection(1)
+{
+    m_clock.start();
+
+    // Show the cached history straight away; the first chain tip corrects it
+    if (m_headerCache->count() > 0) {
+        m_hasTip = true;
+        m_tipHeight = m_headerCache->count() - 1;
+    }
+
+    connect(m_rpcClient, &ArchivasRpcClient::chainTipUpdated, this, &BlockHistoryModel::onChainTipUpdated);
+    connect(m_rpcClient, &ArchivasRpcClient::blocksAppended, this, &BlockHistoryModel::onBlocksAppended);
+    connect(m_rpcClient, &ArchivasRpcClient::reorgDetected, this, &BlockHistoryModel::onReorgDetected);
+    // Pages are cheap to fetch again from the new servers
+    connect(m_rpcClient, &ArchivasRpcClient::sourceChanged, this, [this]() { onReorgDetected(0); });
+    connect(m_rpcClient, &ArchivasRpcClient::blockPageLoaded, this, &BlockHistoryModel::onBlockPageLoaded);
+    connect(m_headerCache, &BlockHeaderCache::changed, this, &BlockHistoryModel::onHeaderCacheChanged);
+}
+
+QModelIndex BlockHistoryModel::indexOfHeight(quint64 height) const
+{
+    if (!m_hasTip || height > m_tipHeight || m_tipHeight - height >= static_cast<quint64>(rowCount())) {
+        return QModelIndex();
+    }
+    return index(rowOf(height), HeightColumn);
+}
+
+void BlockHistoryModel::setVisibleRows(int first, int last)
+{
+    if (!m_hasTip || first < 0 || last < first) {
+        return;
+    }
+    last = qMin(last, rowCount() - 1);
+    if (first != m_firstVisibleRow) {
+        m_scrollDirection = first > m_firstVisibleRow ? 1 : -1;
+        m_firstVisibleRow = first;
+    }
+
+    quint64 newest = heightOf(first) / kPageSize;
+    quint64 oldest = heightOf(last) / kPageSize;
+    for (quint64 number = oldest; number <= newest; ++number) {
+        loadPage(number);
+    }
+    if (m_scrollDirection > 0 && oldest > 0) {
+        loadPage(oldest - 1);
+    } else if (m_scrollDirection < 0 && newest < m_tipHeight / kPageSize) {
+        loadPage(newest + 1);
+    }
+}
+
+bool BlockHistoryModel::block(int row, BlockInfo* block) const
+{
+    if (!m_hasTip || row < 0 || row >= rowCount()) {
+        return false;
+    }
+    quint64 height = heightOf(row);
+    if (m_headerCache->contains(height)) {
+        *block = m_headerCache->block(height);
+        return true;
+    }
+    int i = 0;
+    const BlockColumns* page = findBlock(height, &i);
+    if (!page) {
+        return false;
+    }
+    *block = page->at(i);
+    return true;
+}
+
+const BlockColumns* BlockHistoryModel::findBlock(quint64 height, int* index) const
+{
+    const BlockColumns* page = m_pages.object(height / kPageSize);
+    int i = static_cast<int>(height % kPageSize);
+    if (!page || i >= page->size()) {
+        return nullptr;
+    }
+    *index = i;
+    return page;
+}
+
+void BlockHistoryModel::requestPage(quint64 number) const
+{
+    quint64 from = number * kPageSize;
+    if (!m_hasTip || from > m_tipHeight) {
+        return;
+    }
+    qint64 now = m_clock.elapsed();
+    auto requested = m_requestedAtMs.constFind(number);
+    if (requested != m_requestedAtMs.constEnd() && now - *requested < kPageRetryMs) {
+        return;
+    }
+    m_requestedAtMs.insert(number, now);
+    m_rpcClient->getBlockPage(from, kPageSize);
+}
+
+void BlockHistoryModel::loadPage(quint64 number) const
+{
+    quint64 end = qMin<quint64>((number + 1) * kPageSize, m_tipHeight + 1);
+    if (m_headerCache->count() >= end) {
+        return;
+    }
+    // Looked up through the cache so pages on screen stay the most recently used
+    const BlockColumns* page = m_pages.object(number);
+    if (!page || number * kPageSize + page->size() < end) {
+        requestPage(number);
+    }
+}
+
+void BlockHistoryModel::onChainTipUpdated(const ChainTip& tip)
+{
+    // A tip with neither height nor hash did not parse
+    if (tip.height == 0 && tip.hash.isNull()) {
+        return;
+    }
+    setTipHeight(tip.height);
+}
+
+void BlockHistoryModel::setTipHeight(quint64 height)
+{
+    if (!m_hasTip) {
+        beginResetModel();
+        m_hasTip = true;
+        m_tipHeight = height;
+        endResetModel();
+        return;
+    }
+    // Rows count down from the tip, so new blocks go on top
+    if (height > m_tipHeight) {
+        beginInsertRows(QModelIndex(), 0, static_cast<int>(height - m_tipHeight) - 1);
+        m_tipHeight = height;
+        endInsertRows();
+    } else if (height < m_tipHeight) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(m_tipHeight - height) - 1);
+        m_tipHeight = height;
+        endRemoveRows();
+        truncateFrom(height + 1);
+    }
+}
+
+void BlockHistoryModel::onBlocksAppended(const QList<BlockInfo>& blocks)
+{
+    // Blocks the client follows at the tip extend the newest page in place, so
+    // the top of the history needs no page requests
+    for (const BlockInfo& block : blocks) {
+        quint64 number = block.height / kPageSize;
+        int i = static_cast<int>(block.height % kPageSize);
+        BlockColumns* page = m_pages.object(number);
+        if (page && page->size() == i) {
+            page->append(block);
+        } else if (!page && i == 0) {
+            page = new BlockColumns;
+            page->append(block);
+            m_pages.insert(number, page, kPageCost);
+        } else {
+            continue;
+        }
+        emitRowsChanged(block.height, block.height);
+    }
+}
+
+void BlockHistoryModel::onReorgDetected(quint64 fromHeight)
+{
+    truncateFrom(fromHeight);
+    emitRowsChanged(fromHeight, m_tipHeight);
+}
+
+void BlockHistoryModel::truncateFrom(quint64 height)
+{
+    quint64 number = height / kPageSize;
+    for (quint64 key : m_pages.keys()) {
+        if (key > number) {
+            m_pages.remove(key);
+        }
+    }
+    for (quint64 key : m_requestedAtMs.keys()) {
+        if (key >= number) {
+            m_requestedAtMs.remove(key);
+        }
+    }
+    BlockColumns* page = m_pages.object(number);
+    int keep = static_cast<int>(height % kPageSize);
+    if (page && page->size() > keep) {
+        page->removeLast(page->size() - keep);
+    }
+}
+
+void BlockHistoryModel::onBlockPageLoaded(quint64 from, const QList<BlockInfo>& blocks)
+{
+    if (from % kPageSize != 0) {
+        return; // Not one of ours
+    }
+    quint64 number = from / kPageSize;
+
+    BlockColumns* page = new BlockColumns;
+    for (int i = 0; i < blocks.size() && i < kPageSize; ++i) {
+        if (blocks[i].height != from + i) {
+            break;
+        }
+        page->append(blocks[i]);
+    }
+    // A short page ends at the tip as it was; the rest arrives through
+    // blocksAppended, or a later request once kPageRetryMs has passed
+    if (page->size() < kPageSize) {
+        m_requestedAtMs.insert(number, m_clock.elapsed());
+    } else {
+        m_requestedAtMs.remove(number);
+    }
+
+    // A reply replayed from the client's cache can be older than what was
+    // appended since
+    const BlockColumns* resident = m_pages.object(number);
+    if (page->size() == 0 || (resident && resident->size() >= page->size())) {
+        delete page;
+        return;
+    }
+    int count = page->size();
+    m_pages.insert(number, page, kPageCost);
+    emitRowsChanged(from, from + count - 1);
+}
+
+void BlockHistoryModel::onHeaderCacheChanged(quint64 fromHeight)
+{
+    emitRowsChanged(fromHeight, m_tipHeight);
+}
+
+void BlockHistoryModel::emitRowsChanged(quint64 lowest, quint64 highest)
+{
+    if (!m_hasTip) {
+        return;
+    }
+    highest = qMin(highest, m_tipHeight);
+    if (lowest > highest) {
+        return;
+    }
+    int last = rowCount() - 1;
+    if (rowOf(highest) > last) {
+        return;
+    }
+    int bottom = m_tipHeight - lowest > static_cast<quint64>(last) ? last : rowOf(lowest);
+    emit dataChanged(index(rowOf(highest), 0), index(bottom, ColumnCount - 1));
+}
+
+int BlockHistoryModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() || !m_hasTip) {
+        return 0;
+    }
+    return static_cast<int>(qMin<quint64>(m_tipHeight + 1, std::numeric_limits<int>::max()));
+}
+
+int BlockHistoryModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant BlockHistoryModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole)) {
+        return QVariant();
+    }
+    quint64 height = heightOf(index.row());
+    if (index.column() == HeightColumn) {
+        return role == Qt::DisplayRole ? QVariant(static_cast<qulonglong>(height)) : QVariant();
+    }
+
+    // The header cache comes first: its fields are read in place
+    int i = 0;
+    const BlockColumns* page = nullptr;
+    bool cached = m_headerCache->contains(height);
+    if (!cached) {
+        page = findBlock(height, &i);
+        if (!page) {
+            // Painted before setVisibleRows got to it, e.g. right after a jump
+            requestPage(height / kPageSize);
+            return QVariant();
+        }
+    }
+    switch (index.column()) {
+    case HashColumn:
+        return (cached ? m_headerCache->hash(height) : page->hashes[i]).toHex();
+    case FarmerColumn:
+        return cached ? m_headerCache->farmer(height) : page->farmers[i].toString();
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (index.column()) {
+    case TxCountColumn:
+        return cached ? m_headerCache->txCount(height) : page->txCounts[i];
+    case TimestampColumn:
+        return static_cast<qlonglong>(cached ? m_headerCache->timestamp(height) : page->timestamps[i]);
+    case DifficultyColumn:
+        return static_cast<qulonglong>(cached ? m_headerCache->difficulty(height) : page->difficulties[i]);
+    }
+    return QVariant();
+}
+
+QVariant BlockHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    static const char* const kHeaders[ColumnCount] = {"Height", "Hash", "Farmer", "Tx Count", "Timestamp", "Difficulty"};
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section < 0 || section >= ColumnCount) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    return QString(kHeaders[section]);
+}
@@ -2,26 +2,24 @@
 #include <QClipboard>
 #include <QApplication>
 #include <QHeaderView>
+#include <QScrollBar>
 
-BlocksPage::BlocksPage(ArchivasRpcClient* rpcClient, QWidget *parent)
+// Newest blocks the client follows; they extend the history without page requests
+static const int kFollowedBlocks = 20;
+
+BlocksPage::BlocksPage(ArchivasRpcClient* rpcClient, BlockHeaderCache* headerCache, QWidget *parent)
     : QWidget(parent)
     , m_rpcClient(rpcClient)
-    , m_tableWidget(nullptr)
-    , m_refreshTimer(nullptr)
+    , m_headerCache(headerCache)
+    , m_model(nullptr)
+    , m_tableView(nullptr)
+    , m_heightEdit(nullptr)
+    , m_columnsSized(false)
 {
     setupUi();
 
-    connect(m_rpcClient, &ArchivasRpcClient::blocksUpdated, this, &BlocksPage::onBlocksUpdated);
-
-    // Auto-refresh every 10 seconds
-    m_refreshTimer = new QTimer(this);
-    connect(m_refreshTimer, &QTimer::timeout, [this]() {
-        m_rpcClient->getRecentBlocks(20);
-    });
-    m_refreshTimer->start(10000);
-
-    // Initial load
-    m_rpcClient->getRecentBlocks(20);
+    // The client follows the chain tip polled by MainWindow and only reports changes
+    m_rpcClient->followBlocks(kFollowedBlocks);
 }
 
 BlocksPage::~BlocksPage()
@@ -33,87 +31,87 @@ void BlocksPage::setupUi()
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(20, 20, 20, 20);
 
-    m_tableWidget = new QTableWidget(this);
-    m_tableWidget->setColumnCount(6);
-    m_tableWidget->setHorizontalHeaderLabels({"Height", "Hash", "Farmer", "Tx Count", "Timestamp", "Difficulty"});
-    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    m_tableWidget->horizontalHeader()->setStretchLastSection(true);
-    m_tableWidget->setAlternatingRowColors(true);
-
-    connect(m_tableWidget, &QTableWidget::cellDoubleClicked, this, &BlocksPage::onTableDoubleClicked);
+    // Jump bar
+    QHBoxLayout* jumpLayout = new QHBoxLayout();
+    jumpLayout->addWidget(new QLabel("Go to Height:", this));
+    m_heightEdit = new QLineEdit(this);
+    m_heightEdit->setPlaceholderText("Block height...");
+    connect(m_heightEdit, &QLineEdit::returnPressed, this, &BlocksPage::onGoToHeightClicked);
+    jumpLayout->addWidget(m_heightEdit);
+    QPushButton* goButton = new QPushButton("Go", this);
+    connect(goButton, &QPushButton::clicked, this, &BlocksPage::onGoToHeightClicked);
+    jumpLayout->addWidget(goButton);
+    jumpLayout->addStretch();
+    mainLayout->addLayout(jumpLayout);
+
+    // Table
+    m_model = new BlockHistoryModel(m_rpcClient, m_headerCache, this);
+
+    m_tableView = new QTableView(this);
+    m_tableView->setModel(m_model);
+    m_tableView->setItemDelegate(new ChainItemDelegate(ChainItemDelegate::Plain, m_tableView));
+    m_tableView->setItemDelegateForColumn(BlockHistoryModel::HashColumn, new ChainItemDelegate(ChainItemDelegate::Abbreviated, m_tableView));
+    m_tableView->setItemDelegateForColumn(BlockHistoryModel::FarmerColumn, new ChainItemDelegate(ChainItemDelegate::Abbreviated, m_tableView));
+    m_tableView->setItemDelegateForColumn(BlockHistoryModel::TimestampColumn, new ChainItemDelegate(ChainItemDelegate::Timestamp, m_tableView));
+    m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableView->horizontalHeader()->setStretchLastSection(true);
+    // Uniform rows: the view never measures them
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_tableView->setAlternatingRowColors(true);
+
+    connect(m_tableView, &QTableView::doubleClicked, this, &BlocksPage::onTableDoubleClicked);
+    // Scrolling, resizing and new rows all move the scroll bar or its range
+    connect(m_tableView->verticalScrollBar(), &QScrollBar::valueChanged, this, &BlocksPage::updateVisibleRows);
+    connect(m_tableView->verticalScrollBar(), &QScrollBar::rangeChanged, this, &BlocksPage::updateVisibleRows);
+    connect(m_model, &QAbstractItemModel::modelReset, this, &BlocksPage::updateVisibleRows);
+
+    // Abbreviated cells keep a fixed width, so the first loaded rows are representative
+    connect(m_model, &QAbstractItemModel::dataChanged, this, [this]() {
+        if (!m_columnsSized) {
+            m_tableView->resizeColumnsToContents();
+            m_columnsSized = true;
+        }
+    });
 
-    mainLayout->addWidget(m_tableWidget);
+    mainLayout->addWidget(m_tableView);
 }
 
-void BlocksPage::onBlocksUpdated(const QList<BlockInfo>& blocks)
+void BlocksPage::updateVisibleRows()
 {
-    updateTable(blocks);
+    int first = m_tableView->rowAt(0);
+    if (first < 0) {
+        return;
+    }
+    int last = m_tableView->rowAt(m_tableView->viewport()->height() - 1);
+    if (last < 0) {
+        last = m_model->rowCount() - 1;
+    }
+    m_model->setVisibleRows(first, last);
 }
 
-void BlocksPage::updateTable(const QList<BlockInfo>& blocks)
+void BlocksPage::onGoToHeightClicked()
 {
-    m_tableWidget->setRowCount(blocks.size());
-
-    for (int i = 0; i < blocks.size(); ++i) {
-        const BlockInfo& block = blocks[i];
-
-        // Height
-        QTableWidgetItem* heightItem = new QTableWidgetItem(block.height);
-        m_tableWidget->setItem(i, 0, heightItem);
-
-        // Hash (truncated)
-        QString shortHash = block.hash;
-        if (shortHash.length() > 16) {
-            shortHash = shortHash.left(8) + "..." + shortHash.right(8);
-        }
-        QTableWidgetItem* hashItem = new QTableWidgetItem(shortHash);
-        hashItem->setData(Qt::UserRole, block.hash); // Store full hash
-        hashItem->setToolTip(block.hash);
-        m_tableWidget->setItem(i, 1, hashItem);
-
-        // Farmer
-        QString shortFarmer = block.farmer;
-        if (shortFarmer.length() > 16) {
-            shortFarmer = shortFarmer.left(8) + "..." + shortFarmer.right(8);
-        }
-        QTableWidgetItem* farmerItem = new QTableWidgetItem(shortFarmer);
-        farmerItem->setToolTip(block.farmer);
-        m_tableWidget->setItem(i, 2, farmerItem);
-
-        // Tx Count
-        QTableWidgetItem* txCountItem = new QTableWidgetItem(QString::number(block.txCount));
-        m_tableWidget->setItem(i, 3, txCountItem);
-
-        // Timestamp
-        QTableWidgetItem* timestampItem = new QTableWidgetItem(block.timestamp);
-        m_tableWidget->setItem(i, 4, timestampItem);
-
-        // Difficulty
-        QTableWidgetItem* difficultyItem = new QTableWidgetItem(block.difficulty);
-        m_tableWidget->setItem(i, 5, difficultyItem);
+    bool ok = false;
+    quint64 height = m_heightEdit->text().trimmed().toULongLong(&ok);
+    QModelIndex index = ok ? m_model->indexOfHeight(height) : QModelIndex();
+    if (!index.isValid()) {
+        return;
     }
-
-    m_tableWidget->resizeColumnsToContents();
+    // Only the pages around the target get loaded
+    m_tableView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+    m_tableView->selectRow(index.row());
 }
 
-void BlocksPage::onTableDoubleClicked(int row, int column)
+void BlocksPage::onTableDoubleClicked(const QModelIndex& index)
 {
-    Q_UNUSED(column);
-    if (row < 0 || row >= m_tableWidget->rowCount()) {
+    BlockInfo block;
+    if (!index.isValid() || !m_model->block(index.row(), &block)) {
         return;
     }
 
     // Copy hash to clipboard
-    QTableWidgetItem* hashItem = m_tableWidget->item(row, 1);
-    if (hashItem) {
-        QString fullHash = hashItem->data(Qt::UserRole).toString();
-        if (fullHash.isEmpty()) {
-            fullHash = hashItem->text();
-        }
-        QClipboard* clipboard = QApplication::clipboard();
-        clipboard->setText(fullHash);
-    }
+    QClipboard* clipboard = QApplication::clipboard();
+    clipboard->setText(block.hash.toHex());
 }
-
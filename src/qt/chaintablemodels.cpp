@@ -0,0 +1,261 @@
+#include "chaintablemodels.h"
+
+void BlockColumns::append(const BlockInfo& block)
+{
+    heights.append(block.height);
+    hashes.append(block.hash);
+    prevHashes.append(block.prevHash);
+    farmers.append(block.farmer);
+    txCounts.append(block.txCount);
+    timestamps.append(block.timestamp);
+    difficulties.append(block.difficulty);
+}
+
+void BlockColumns::removeLast(int count)
+{
+    int keep = size() - count;
+    heights.resize(keep);
+    hashes.resize(keep);
+    prevHashes.resize(keep);
+    farmers.resize(keep);
+    txCounts.resize(keep);
+    timestamps.resize(keep);
+    difficulties.resize(keep);
+}
+
+BlockInfo BlockColumns::at(int i) const
+{
+    BlockInfo block;
+    block.height = heights[i];
+    block.hash = hashes[i];
+    block.prevHash = prevHashes[i];
+    block.farmer = farmers[i];
+    block.txCount = txCounts[i];
+    block.timestamp = timestamps[i];
+    block.difficulty = difficulties[i];
+    return block;
+}
+
+void TransactionColumns::append(const TransactionInfo& tx)
+{
+    hashes.append(tx.hash);
+    indexes.append(tx.index);
+    froms.append(tx.from);
+    tos.append(tx.to);
+    amounts.append(tx.amount);
+    fees.append(tx.fee);
+    heights.append(tx.height);
+    timestamps.append(tx.timestamp);
+}
+
+void TransactionColumns::set(int i, const TransactionInfo& tx)
+{
+    hashes[i] = tx.hash;
+    indexes[i] = tx.index;
+    froms[i] = tx.from;
+    tos[i] = tx.to;
+    amounts[i] = tx.amount;
+    fees[i] = tx.fee;
+    heights[i] = tx.height;
+    timestamps[i] = tx.timestamp;
+}
+
+void TransactionColumns::removeFirst(int count)
+{
+    hashes.remove(0, count);
+    indexes.remove(0, count);
+    froms.remove(0, count);
+    tos.remove(0, count);
+    amounts.remove(0, count);
+    fees.remove(0, count);
+    heights.remove(0, count);
+    timestamps.remove(0, count);
+}
+
+void TransactionColumns::removeLast(int count)
+{
+    int keep = size() - count;
+    hashes.resize(keep);
+    indexes.resize(keep);
+    froms.resize(keep);
+    tos.resize(keep);
+    amounts.resize(keep);
+    fees.resize(keep);
+    heights.resize(keep);
+    timestamps.resize(keep);
+}
+
+void TransactionColumns::clear()
+{
+    removeFirst(size());
+}
+
+TransactionInfo TransactionColumns::at(int i) const
+{
+    TransactionInfo tx;
+    tx.hash = hashes[i];
+    tx.index = indexes[i];
+    tx.from = froms[i];
+    tx.to = tos[i];
+    tx.amount = amounts[i];
+    tx.fee = fees[i];
+    tx.height = heights[i];
+    tx.timestamp = timestamps[i];
+    return tx;
+}
+
+// Same transaction: by hash when both have one, else by position in the chain
+static bool sameTransaction(const TransactionInfo& a, const TransactionInfo& b)
+{
+    if (!a.hash.isNull() || !b.hash.isNull()) {
+        return a.hash == b.hash;
+    }
+    return a.height == b.height && a.index == b.index && a.from == b.from && a.to == b.to;
+}
+
+static bool identicalTransaction(const TransactionInfo& a, const TransactionInfo& b)
+{
+    return sameTransaction(a, b) && a.index == b.index && a.from == b.from && a.to == b.to &&
+           a.amount == b.amount && a.fee == b.fee && a.height == b.height && a.timestamp == b.timestamp;
+}
+
+TransactionTableModel::TransactionTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void TransactionTableModel::setTransactions(const QList<TransactionInfo>& txs)
+{
+    int oldCount = m_txs.size();
+    if (oldCount == 0 || txs.isEmpty()) {
+        reset(txs);
+        return;
+    }
+
+    // The newest row we have should reappear further down the new list, with
+    // the rows below it in the same order. Anything else is a new list.
+    TransactionInfo newest = transaction(0);
+    int added = 0;
+    while (added < txs.size() && !sameTransaction(txs[added], newest)) {
+        ++added;
+    }
+    if (added == txs.size()) {
+        reset(txs);
+        return;
+    }
+    int kept = qMin(oldCount, txs.size() - added);
+    QVector<int> changed;
+    for (int row = 0; row < kept; ++row) {
+        TransactionInfo old = transaction(row);
+        if (!sameTransaction(txs[added + row], old)) {
+            reset(txs);
+            return;
+        }
+        if (!identicalTransaction(txs[added + row], old)) {
+            changed.append(row);
+        }
+    }
+
+    if (kept < oldCount) {
+        beginRemoveRows(QModelIndex(), kept, oldCount - 1);
+        m_txs.removeFirst(oldCount - kept);
+        endRemoveRows();
+    }
+    // Rows shift down as new ones go on top, so update before inserting
+    for (int row : changed) {
+        m_txs.set(indexOf(row), txs[added + row]);
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+    }
+    if (added > 0) {
+        beginInsertRows(QModelIndex(), 0, added - 1);
+        for (int i = added - 1; i >= 0; --i) {
+            m_txs.append(txs[i]);
+        }
+        endInsertRows();
+    }
+}
+
+void TransactionTableModel::reset(const QList<TransactionInfo>& txs)
+{
+    beginResetModel();
+    m_txs.clear();
+    for (int i = txs.size() - 1; i >= 0; --i) {
+        m_txs.append(txs[i]);
+    }
+    endResetModel();
+}
+
+QString TransactionTableModel::displayId(int row) const
+{
+    return transaction(row).displayId();
+}
+
+int TransactionTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_txs.size();
+}
+
+int TransactionTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant TransactionTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole)) {
+        return QVariant();
+    }
+    int i = indexOf(index.row());
+    switch (index.column()) {
+    case HashColumn:
+        return displayId(index.row());
+    case FromColumn:
+        return m_txs.froms[i].toString();
+    case ToColumn:
+        return m_txs.tos[i].toString();
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (index.column()) {
+    case AmountColumn:
+        return static_cast<qlonglong>(m_txs.amounts[i]);
+    case FeeColumn:
+        return static_cast<qlonglong>(m_txs.fees[i]);
+    case HeightColumn:
+        return static_cast<qulonglong>(m_txs.heights[i]);
+    case TimestampColumn:
+        return static_cast<qlonglong>(m_txs.timestamps[i]);
+    }
+    return QVariant();
+}
+
+QVariant TransactionTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    static const char* const kHeaders[ColumnCount] = {"Hash", "From", "To", "Amount (RCHV)", "Fee (RCHV)", "Height", "Timestamp"};
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section < 0 || section >= ColumnCount) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    return QString(kHeaders[section]);
+}
+
+ChainItemDelegate::ChainItemDelegate(Format format, QObject *parent)
+    : QStyledItemDelegate(parent)
+    , m_format(format)
+{
+}
+
+QString ChainItemDelegate::displayText(const QVariant& value, const QLocale& locale) const
+{
+    Q_UNUSED(locale);
+    switch (m_format) {
+    case Abbreviated:
+        return abbreviate(value.toString());
+    case Timestamp:
+        return formatTimestamp(value.toLongLong());
+    case Plain:
+        break;
+    }
+    // Digits without group separators, as the tables have always shown them
+    return value.toString();
+}
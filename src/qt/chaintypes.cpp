@@ -0,0 +1,142 @@
+#include "chaintypes.h"
+#include <QDateTime>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVector>
+#include <algorithm>
+
+static const char kHexDigits[] = "0123456789abcdef";
+
+static int hexValue(ushort c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool Hash32::isNull() const
+{
+    for (quint8 b : bytes) {
+        if (b != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString Hash32::toHex() const
+{
+    QString hex(static_cast<int>(bytes.size()) * 2, Qt::Uninitialized);
+    QChar* out = hex.data();
+    for (quint8 b : bytes) {
+        *out++ = QLatin1Char(kHexDigits[b >> 4]);
+        *out++ = QLatin1Char(kHexDigits[b & 0x0f]);
+    }
+    return hex;
+}
+
+Hash32 Hash32::fromHex(const QString& hex)
+{
+    Hash32 hash;
+    if (hex.size() != static_cast<int>(hash.bytes.size()) * 2) {
+        return hash;
+    }
+    const QChar* in = hex.constData();
+    for (quint8& b : hash.bytes) {
+        int hi = hexValue(in[0].unicode());
+        int lo = hexValue(in[1].unicode());
+        if (hi < 0 || lo < 0) {
+            return Hash32();
+        }
+        b = static_cast<quint8>((hi << 4) | lo);
+        in += 2;
+    }
+    return hash;
+}
+
+Hash32 Hash32::fromBytes(const uint8_t* data)
+{
+    Hash32 hash;
+    std::copy(data, data + hash.bytes.size(), hash.bytes.begin());
+    return hash;
+}
+
+namespace {
+
+struct AddressTable {
+    QReadWriteLock lock;
+    QHash<QString, quint32> ids;
+    QVector<QString> strings{QString()};  // Index 0 is the empty address
+};
+
+AddressTable& addressTable()
+{
+    static AddressTable table;
+    return table;
+}
+
+} // namespace
+
+Address Address::intern(const QString& address)
+{
+    if (address.isEmpty()) {
+        return Address();
+    }
+
+    AddressTable& table = addressTable();
+    {
+        QReadLocker locker(&table.lock);
+        auto it = table.ids.constFind(address);
+        if (it != table.ids.constEnd()) {
+            return Address(*it);
+        }
+    }
+
+    QWriteLocker locker(&table.lock);
+    auto it = table.ids.constFind(address);
+    if (it != table.ids.constEnd()) {
+        return Address(*it);
+    }
+    quint32 id = static_cast<quint32>(table.strings.size());
+    table.strings.append(address);
+    table.ids.insert(address, id);
+    return Address(id);
+}
+
+QString Address::toString() const
+{
+    if (m_id == 0) {
+        return QString();
+    }
+    AddressTable& table = addressTable();
+    QReadLocker locker(&table.lock);
+    return table.strings.value(static_cast<int>(m_id));
+}
+
+QString formatTimestamp(qint64 seconds)
+{
+    return QDateTime::fromSecsSinceEpoch(seconds).toString("yyyy-MM-dd hh:mm:ss");
+}
+
+QString abbreviate(const QString& text)
+{
+    if (text.length() > 16) {
+        return text.left(8) + "..." + text.right(8);
+    }
+    return text;
+}
+
+QString TransactionInfo::displayId() const
+{
+    if (!hash.isNull()) {
+        return hash.toHex();
+    }
+    return QString("%1:%2").arg(height).arg(index);
+}
@@ -3,6 +3,7 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QStandardPaths>
 #include <QDebug>
@@ -50,6 +51,7 @@ void ConfigManager::loadDefaults()
     m_nodeConfig.executablePath = "";
     m_nodeConfig.network = "archivas-devnet-v4";
     m_nodeConfig.rpcBind = "127.0.0.1:8080";
+    m_nodeConfig.streamBind = "127.0.0.1:8081";
     // Use QStandardPaths for cross-platform data directory
     QString appDataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     if (appDataDir.isEmpty()) {
@@ -58,6 +60,7 @@ void ConfigManager::loadDefaults()
     m_nodeConfig.dataDir = appDataDir + "/data";
     m_nodeConfig.bootnodes = "seed.archivas.ai:9090";
     m_nodeConfig.autoStart = true; // Auto-start by default
+    m_nodeConfig.logLevel = "INFO"; // Per-block DEBUG lines slow down IBD
 
     // Farmer defaults - embedded Go code (no executable path needed)
     m_farmerConfig.executablePath = "";
@@ -65,11 +68,15 @@ void ConfigManager::loadDefaults()
     m_farmerConfig.farmerPrivkeyPath = appDataDir + "/farmer.key";
     m_farmerConfig.nodeUrl = "http://127.0.0.1:8080";
     m_farmerConfig.autoStart = true; // Auto-start by default
+    m_farmerConfig.logLevel = "INFO";
 
     // RPC defaults
-    m_rpcConfig.url = "http://127.0.0.1:8080";
-    m_rpcConfig.fallbackUrl = "https://seed.archivas.ai";
+    m_rpcConfig.urls = QStringList() << "http://127.0.0.1:8080" << "https://seed.archivas.ai";
+    m_rpcConfig.streamUrl = "http://127.0.0.1:8081/events";
     m_rpcConfig.pollIntervalMs = 5000;
+    m_rpcConfig.cacheTtlMs = 1000;
+    m_rpcConfig.hedgeRequests = false;
+    m_rpcConfig.requestTimeoutMs = 10000;
 
     // UI defaults
     m_uiConfig.theme = "dark";
@@ -131,9 +138,11 @@ QJsonObject ConfigManager::configToJson() const
     node["executable_path"] = m_nodeConfig.executablePath;
     node["network"] = m_nodeConfig.network;
     node["rpc_bind"] = m_nodeConfig.rpcBind;
+    node["stream_bind"] = m_nodeConfig.streamBind;
     node["data_dir"] = m_nodeConfig.dataDir;
     node["bootnodes"] = m_nodeConfig.bootnodes;
     node["auto_start"] = m_nodeConfig.autoStart;
+    node["log_level"] = m_nodeConfig.logLevel;
     json["node"] = node;
 
     // Farmer config
@@ -143,13 +152,17 @@ QJsonObject ConfigManager::configToJson() const
     farmer["farmer_privkey_path"] = m_farmerConfig.farmerPrivkeyPath;
     farmer["node_url"] = m_farmerConfig.nodeUrl;
     farmer["auto_start"] = m_farmerConfig.autoStart;
+    farmer["log_level"] = m_farmerConfig.logLevel;
     json["farmer"] = farmer;
 
     // RPC config
     QJsonObject rpc;
-    rpc["url"] = m_rpcConfig.url;
-    rpc["fallback_url"] = m_rpcConfig.fallbackUrl;
+    rpc["urls"] = QJsonArray::fromStringList(m_rpcConfig.urls);
+    rpc["stream_url"] = m_rpcConfig.streamUrl;
     rpc["poll_interval_ms"] = m_rpcConfig.pollIntervalMs;
+    rpc["cache_ttl_ms"] = m_rpcConfig.cacheTtlMs;
+    rpc["hedge_requests"] = m_rpcConfig.hedgeRequests;
+    rpc["request_timeout_ms"] = m_rpcConfig.requestTimeoutMs;
     json["rpc"] = rpc;
 
     // UI config
@@ -170,9 +183,11 @@ bool ConfigManager::jsonToConfig(const QJsonObject& json)
         if (node.contains("executable_path")) m_nodeConfig.executablePath = node["executable_path"].toString();
         if (node.contains("network")) m_nodeConfig.network = node["network"].toString();
         if (node.contains("rpc_bind")) m_nodeConfig.rpcBind = node["rpc_bind"].toString();
+        if (node.contains("stream_bind")) m_nodeConfig.streamBind = node["stream_bind"].toString();
         if (node.contains("data_dir")) m_nodeConfig.dataDir = node["data_dir"].toString();
         if (node.contains("bootnodes")) m_nodeConfig.bootnodes = node["bootnodes"].toString();
         if (node.contains("auto_start")) m_nodeConfig.autoStart = node["auto_start"].toBool();
+        if (node.contains("log_level")) m_nodeConfig.logLevel = node["log_level"].toString();
     }
 
     // Farmer config
@@ -183,14 +198,29 @@ bool ConfigManager::jsonToConfig(const QJsonObject& json)
         if (farmer.contains("farmer_privkey_path")) m_farmerConfig.farmerPrivkeyPath = farmer["farmer_privkey_path"].toString();
         if (farmer.contains("node_url")) m_farmerConfig.nodeUrl = farmer["node_url"].toString();
         if (farmer.contains("auto_start")) m_farmerConfig.autoStart = farmer["auto_start"].toBool();
+        if (farmer.contains("log_level")) m_farmerConfig.logLevel = farmer["log_level"].toString();
     }
 
     // RPC config
     if (json.contains("rpc") && json["rpc"].isObject()) {
         QJsonObject rpc = json["rpc"].toObject();
-        if (rpc.contains("url")) m_rpcConfig.url = rpc["url"].toString();
-        if (rpc.contains("fallback_url")) m_rpcConfig.fallbackUrl = rpc["fallback_url"].toString();
+        if (rpc.contains("urls")) {
+            m_rpcConfig.urls.clear();
+            for (const QJsonValue& url : rpc["urls"].toArray()) {
+                m_rpcConfig.urls.append(url.toString());
+            }
+        } else if (rpc.contains("url")) {
+            // Configs written before the endpoint list had a primary and a fallback
+            m_rpcConfig.urls = QStringList() << rpc["url"].toString();
+            if (!rpc["fallback_url"].toString().isEmpty()) {
+                m_rpcConfig.urls.append(rpc["fallback_url"].toString());
+            }
+        }
+        if (rpc.contains("stream_url")) m_rpcConfig.streamUrl = rpc["stream_url"].toString();
         if (rpc.contains("poll_interval_ms")) m_rpcConfig.pollIntervalMs = rpc["poll_interval_ms"].toInt();
+        if (rpc.contains("cache_ttl_ms")) m_rpcConfig.cacheTtlMs = rpc["cache_ttl_ms"].toInt();
+        if (rpc.contains("hedge_requests")) m_rpcConfig.hedgeRequests = rpc["hedge_requests"].toBool();
+        if (rpc.contains("request_timeout_ms")) m_rpcConfig.requestTimeoutMs = rpc["request_timeout_ms"].toInt();
     }
 
     // UI config
@@ -2,7 +2,7 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QScrollBar>
-#include <QTimer>
+#include <QFutureWatcher>
 #include <QFont>
 #include <QDateTime>
 #include <QFileInfo>
@@ -31,21 +31,16 @@ FarmerPage::FarmerPage(ArchivasNodeManager* nodeManager, ConfigManager* configMa
     , m_plotsPathEdit(nullptr)
     , m_farmerPrivkeyPathEdit(nullptr)
     , m_logTextEdit(nullptr)
-    , m_statusTimer(nullptr)
 {
     setupUi();
 
     // Connect signals
     connect(m_nodeManager, &ArchivasNodeManager::farmerStarted, this, &FarmerPage::onFarmerStarted);
     connect(m_nodeManager, &ArchivasNodeManager::farmerStopped, this, &FarmerPage::onFarmerStopped);
-    connect(m_nodeManager, &ArchivasNodeManager::farmerLog, this, &FarmerPage::onFarmerLog);
+    connect(m_nodeManager, &ArchivasNodeManager::farmerStateChanged, this, &FarmerPage::onFarmerStateChanged);
+    connect(m_nodeManager, &ArchivasNodeManager::logBatch, this, &FarmerPage::onLogBatch);
     connect(m_nodeManager, &ArchivasNodeManager::statusUpdated, this, &FarmerPage::updateStatus);
 
-    // Status update timer
-    m_statusTimer = new QTimer(this);
-    connect(m_statusTimer, &QTimer::timeout, this, &FarmerPage::updateStatus);
-    m_statusTimer->start(5000); // Update every 5 seconds
-
     // Load config
     FarmerConfig config = m_configManager->getFarmerConfig();
     m_plotsPathEdit->setText(config.plotsPath);
@@ -150,22 +145,32 @@ void FarmerPage::setupUi()
 }
 
 void FarmerPage::onStartFarmer()
+{
+    launchFarmer(false);
+}
+
+void FarmerPage::launchFarmer(bool restart)
 {
     FarmerConfig config = m_configManager->getFarmerConfig();
     config.plotsPath = m_plotsPathEdit->text();
     config.farmerPrivkeyPath = m_farmerPrivkeyPathEdit->text();
     
     QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    m_logTextEdit->appendPlainText(QString("[%1] Starting farmer...").arg(timestamp));
+    m_logTextEdit->appendPlainText(QString("[%1] %2 farmer...").arg(timestamp, restart ? "Restarting" : "Starting"));
     m_logTextEdit->appendPlainText(QString("[%1] Plots: %2, Node URL: %3").arg(timestamp, config.plotsPath, config.nodeUrl));
     
-    bool success = m_nodeManager->startFarmer(config.nodeUrl, config.plotsPath, config.farmerPrivkeyPath);
-    if (!success) {
-        QString error = "ERROR: Failed to start farmer. Check the logs above for details.";
-        m_logTextEdit->appendPlainText(error);
-    } else {
-        m_logTextEdit->appendPlainText(QString("[%1] Farmer start command sent successfully. Waiting for farmer to start...").arg(timestamp));
-    }
+    QFuture<bool> started = restart
+        ? m_nodeManager->restartFarmer(config.nodeUrl, config.plotsPath, config.farmerPrivkeyPath)
+        : m_nodeManager->startFarmer(config.nodeUrl, config.plotsPath, config.farmerPrivkeyPath);
+
+    auto* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher]() {
+        if (!watcher->result()) {
+            m_logTextEdit->appendPlainText("ERROR: Failed to start farmer. Check the logs above for details.");
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(started);
     
     // Save config
     m_configManager->setFarmerConfig(config);
@@ -181,8 +186,14 @@ void FarmerPage::onStopFarmer()
 
 void FarmerPage::onRestartFarmer()
 {
-    m_nodeManager->stopFarmer();
-    QTimer::singleShot(1000, this, &FarmerPage::onStartFarmer);
+    // The new instance starts as soon as the old one has finished stopping
+    launchFarmer(true);
+}
+
+void FarmerPage::onFarmerStateChanged()
+{
+    updateStatus();
+    updateControls();
 }
 
 void FarmerPage::onFarmerStarted()
@@ -201,13 +212,13 @@ void FarmerPage::onFarmerStopped()
     m_logTextEdit->appendPlainText(QString("[%1] Farmer stopped").arg(timestamp));
 }
 
-void FarmerPage::onFarmerLog(const QString &level, const QString &message)
+void FarmerPage::onLogBatch(const QVector<LogRecord> &records)
 {
-    if (message.isEmpty()) {
+    QString lines = formatLogRecords(records, LogRecord::Farmer);
+    if (lines.isEmpty()) {
         return;
     }
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    m_logTextEdit->appendPlainText(QString("[%1] [%2] %3").arg(timestamp, level, message));
+    m_logTextEdit->appendPlainText(lines);
     // Auto-scroll to bottom
     QScrollBar* scrollBar = m_logTextEdit->verticalScrollBar();
     scrollBar->setValue(scrollBar->maximum());
@@ -215,14 +226,9 @@ void FarmerPage::onFarmerLog(const QString &level, const QString &message)
 
 void FarmerPage::updateStatus()
 {
-    bool running = m_nodeManager->isFarmerRunning();
-    if (running) {
-        m_statusLabel->setText("Running");
-        m_statusLabel->setStyleSheet("color: green; font-weight: bold;");
-    } else {
-        m_statusLabel->setText("Stopped");
-        m_statusLabel->setStyleSheet("color: red; font-weight: bold;");
-    }
+    ArchivasNodeManager::ServiceState state = m_nodeManager->farmerState();
+    m_statusLabel->setText(ArchivasNodeManager::serviceStateName(state));
+    m_statusLabel->setStyleSheet(ArchivasNodeManager::serviceStateStyle(state));
     
     // Update plot count
     int plotCount = m_nodeManager->getPlotCount();
@@ -337,10 +343,11 @@ void FarmerPage::onCreatePlot()
 
 void FarmerPage::updateControls()
 {
+    ArchivasNodeManager::ServiceState state = m_nodeManager->farmerState();
     bool running = m_nodeManager->isFarmerRunning();
     m_startButton->setEnabled(!running);
-    m_stopButton->setEnabled(running);
-    m_restartButton->setEnabled(running);
+    m_stopButton->setEnabled(state == ArchivasNodeManager::Starting || state == ArchivasNodeManager::Running);
+    m_restartButton->setEnabled(state == ArchivasNodeManager::Running);
     m_plotsPathEdit->setEnabled(!running);
     m_farmerPrivkeyPathEdit->setEnabled(!running);
     // Plot creation can be done anytime
@@ -14,6 +14,9 @@
 #include <QLabel>
 #include <QFile>
 #include <QIODevice>
+#include <QComboBox>
+#include <QSignalBlocker>
+#include "configmanager.h"
 
 LogsPage::LogsPage(ArchivasNodeManager* nodeManager, QWidget *parent)
     : QWidget(parent)
@@ -23,13 +26,15 @@ LogsPage::LogsPage(ArchivasNodeManager* nodeManager, QWidget *parent)
     , m_farmerLogs(nullptr)
     , m_searchEdit(nullptr)
     , m_autoScrollCheck(nullptr)
+    , m_nodeLevelCombo(nullptr)
+    , m_farmerLevelCombo(nullptr)
     , m_autoScroll(true)
 {
     setupUi();
     
     // Connect to node manager signals
-    connect(m_nodeManager, &ArchivasNodeManager::nodeLog, this, &LogsPage::onNodeLog);
-    connect(m_nodeManager, &ArchivasNodeManager::farmerLog, this, &LogsPage::onFarmerLog);
+    connect(m_nodeManager, &ArchivasNodeManager::logBatch, this, &LogsPage::onLogBatch);
+    connect(m_nodeManager, &ArchivasNodeManager::logLevelChanged, this, &LogsPage::onManagerLogLevelChanged);
 }
 
 LogsPage::~LogsPage()
@@ -79,6 +84,10 @@ void LogsPage::setupUi()
     nodeButtonsLayout->addWidget(clearNodeButton);
     nodeButtonsLayout->addWidget(saveNodeButton);
     nodeButtonsLayout->addStretch();
+    nodeButtonsLayout->addWidget(new QLabel("Level:", nodeTab));
+    m_nodeLevelCombo = createLevelCombo(LogRecord::Node, nodeTab);
+    connect(m_nodeLevelCombo, &QComboBox::currentTextChanged, this, &LogsPage::onNodeLogLevelChanged);
+    nodeButtonsLayout->addWidget(m_nodeLevelCombo);
     nodeTabLayout->addLayout(nodeButtonsLayout);
     
     m_tabWidget->addTab(nodeTab, "Node Logs");
@@ -99,6 +108,10 @@ void LogsPage::setupUi()
     farmerButtonsLayout->addWidget(clearFarmerButton);
     farmerButtonsLayout->addWidget(saveFarmerButton);
     farmerButtonsLayout->addStretch();
+    farmerButtonsLayout->addWidget(new QLabel("Level:", farmerTab));
+    m_farmerLevelCombo = createLevelCombo(LogRecord::Farmer, farmerTab);
+    connect(m_farmerLevelCombo, &QComboBox::currentTextChanged, this, &LogsPage::onFarmerLogLevelChanged);
+    farmerButtonsLayout->addWidget(m_farmerLevelCombo);
     farmerTabLayout->addLayout(farmerButtonsLayout);
     
     m_tabWidget->addTab(farmerTab, "Farmer Logs");
@@ -106,42 +119,61 @@ void LogsPage::setupUi()
     mainLayout->addWidget(m_tabWidget);
 }
 
-void LogsPage::addNodeLog(const QString &level, const QString &message)
+QComboBox* LogsPage::createLevelCombo(LogRecord::Source source, QWidget* parent)
 {
-    onNodeLog(level, message);
+    QComboBox* combo = new QComboBox(parent);
+    combo->addItems(ArchivasNodeManager::logLevelNames());
+    combo->setCurrentText(m_nodeManager->logLevel(source));
+    combo->setToolTip("Messages below this level are dropped before they are formatted");
+    return combo;
 }
 
-void LogsPage::addFarmerLog(const QString &level, const QString &message)
+void LogsPage::onNodeLogLevelChanged(const QString& level)
 {
-    onFarmerLog(level, message);
+    m_nodeManager->setLogLevel(LogRecord::Node, level);
+
+    ConfigManager* config = ConfigManager::instance();
+    NodeConfig nodeConfig = config->getNodeConfig();
+    nodeConfig.logLevel = level;
+    config->setNodeConfig(nodeConfig);
+    config->saveConfig();
 }
 
-void LogsPage::onNodeLog(const QString &level, const QString &message)
+void LogsPage::onFarmerLogLevelChanged(const QString& level)
 {
-    if (message.isEmpty()) {
-        return;
-    }
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    QString logLine = QString("[%1] [%2] %3").arg(timestamp, level, message);
-    m_nodeLogs->appendPlainText(logLine);
-    
-    if (m_autoScroll) {
-        QScrollBar* scrollBar = m_nodeLogs->verticalScrollBar();
-        scrollBar->setValue(scrollBar->maximum());
-    }
+    m_nodeManager->setLogLevel(LogRecord::Farmer, level);
+
+    ConfigManager* config = ConfigManager::instance();
+    FarmerConfig farmerConfig = config->getFarmerConfig();
+    farmerConfig.logLevel = level;
+    config->setFarmerConfig(farmerConfig);
+    config->saveConfig();
 }
 
-void LogsPage::onFarmerLog(const QString &level, const QString &message)
+void LogsPage::onManagerLogLevelChanged(LogRecord::Source source, const QString& level)
 {
-    if (message.isEmpty()) {
+    // Keep the selector in sync when the level is changed from Settings
+    QComboBox* combo = source == LogRecord::Node ? m_nodeLevelCombo : m_farmerLevelCombo;
+    QSignalBlocker blocker(combo);
+    combo->setCurrentText(level);
+}
+
+void LogsPage::onLogBatch(const QVector<LogRecord> &records)
+{
+    appendLogs(m_nodeLogs, formatLogRecords(records, LogRecord::Node));
+    appendLogs(m_farmerLogs, formatLogRecords(records, LogRecord::Farmer));
+}
+
+void LogsPage::appendLogs(QPlainTextEdit* view, const QString &lines)
+{
+    if (lines.isEmpty()) {
         return;
     }
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    QString logLine = QString("[%1] [%2] %3").arg(timestamp, level, message);
-    m_farmerLogs->appendPlainText(logLine);
-    
+    // One append per batch keeps layout work independent of the line count
+    view->appendPlainText(lines);
+
     if (m_autoScroll) {
-        QScrollBar* scrollBar = m_farmerLogs->verticalScrollBar();
+        QScrollBar* scrollBar = view->verticalScrollBar();
         scrollBar->setValue(scrollBar->maximum());
     }
 }
@@ -16,6 +16,19 @@
 #include <QWindow>
 #include <QDebug>
 #include <QFile>
+#include <QCloseEvent>
+#include <QFutureWatcher>
+#include <QEvent>
+
+static const int kEndpointProbeIntervalMs = 15000;
+// Tip poll while the event stream is live; it only covers for a stream that stalls
+static const int kStreamingPollIntervalMs = 60000;
+
+// Location of a GUI cache, next to the node's chain data
+static QString guiCacheDir(const NodeConfig& nodeConfig, const QString& name)
+{
+    return nodeConfig.dataDir.isEmpty() ? QString() : nodeConfig.dataDir + "/gui-cache/" + name;
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -31,11 +44,16 @@ MainWindow::MainWindow(QWidget *parent)
     , m_logsPage(nullptr)
     , m_nodeManager(nullptr)
     , m_rpcClient(nullptr)
+    , m_headerCache(nullptr)
+    , m_txIndex(nullptr)
     , m_configManager(nullptr)
-    , m_pollTimer(nullptr)
+    , m_scheduler(nullptr)
+    , m_tipTask(-1)
+    , m_transactionsRefreshDue(false)
     , m_nodeRunning(false)
     , m_farmerRunning(false)
     , m_rpcConnected(false)
+    , m_shutdownComplete(false)
 {
     // Initialize config manager
     m_configManager = ConfigManager::instance();
@@ -59,17 +77,34 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_nodeManager, &ArchivasNodeManager::nodeStopped, this, &MainWindow::onNodeStatusChanged);
     connect(m_nodeManager, &ArchivasNodeManager::farmerStarted, this, &MainWindow::onFarmerStatusChanged);
     connect(m_nodeManager, &ArchivasNodeManager::farmerStopped, this, &MainWindow::onFarmerStatusChanged);
-    // Log connections will be set up after logs page is created
+    m_nodeManager->setLogLevel(LogRecord::Node, m_configManager->getNodeConfig().logLevel);
+    m_nodeManager->setLogLevel(LogRecord::Farmer, m_configManager->getFarmerConfig().logLevel);
+    m_nodeManager->setStreamBind(m_configManager->getNodeConfig().streamBind);
 
     // Initialize RPC client
     RpcConfig rpcConfig = m_configManager->getRpcConfig();
     m_rpcClient = new ArchivasRpcClient(this);
-    m_rpcClient->setBaseUrl(rpcConfig.url);
-    m_rpcClient->setFallbackUrl(rpcConfig.fallbackUrl);
+    m_rpcClient->setEndpoints(rpcConfig.urls);
+    m_rpcClient->setHedgingEnabled(rpcConfig.hedgeRequests);
+    m_rpcClient->setEmbeddedRpcBind(m_configManager->getNodeConfig().rpcBind);
+    m_rpcClient->setCacheTtl(rpcConfig.cacheTtlMs);
+    m_rpcClient->setRequestTimeout(rpcConfig.requestTimeoutMs);
+    m_rpcClient->subscribe(rpcConfig.streamUrl);
     connect(m_rpcClient, &ArchivasRpcClient::chainTipUpdated, this, &MainWindow::onChainTipUpdated);
+    connect(m_rpcClient, &ArchivasRpcClient::subscriptionChanged, this, &MainWindow::onSubscriptionChanged);
     connect(m_rpcClient, &ArchivasRpcClient::connected, this, &MainWindow::onRpcConnected);
     connect(m_rpcClient, &ArchivasRpcClient::disconnected, this, &MainWindow::onRpcDisconnected);
 
+    // Block headers seen in earlier sessions, shown before anything is fetched
+    m_headerCache = new BlockHeaderCache(m_rpcClient, this);
+    m_headerCache->open(guiCacheDir(m_configManager->getNodeConfig(), "headers"));
+    // Transactions by address, built in the background from block pages
+    m_txIndex = new TransactionIndex(m_rpcClient, this);
+    m_txIndex->open(guiCacheDir(m_configManager->getNodeConfig(), "txindex"));
+
+    // Every periodic refresh runs from here; see startPolling()
+    m_scheduler = new RefreshScheduler(this);
+
     setupUi();
     setupMenuBar();
     setupStatusBar();
@@ -86,22 +121,33 @@ MainWindow::MainWindow(QWidget *parent)
         NodeConfig nodeConfig = m_configManager->getNodeConfig();
         FarmerConfig farmerConfig = m_configManager->getFarmerConfig();
         
+        auto startFarmer = [this, farmerConfig]() {
+            qDebug() << "Auto-starting Archivas farmer...";
+            m_nodeManager->startFarmer(farmerConfig.nodeUrl, farmerConfig.plotsPath,
+                                      farmerConfig.farmerPrivkeyPath);
+        };
+
         // Always auto-start node with default config (unless explicitly disabled)
         if (nodeConfig.autoStart) {
             qDebug() << "Auto-starting Archivas node...";
             // Extract genesis file from Qt resources to a temporary file
             QString genesisPath = extractGenesisFile();
-            m_nodeManager->startNode(nodeConfig.network, nodeConfig.rpcBind, 
-                                    nodeConfig.dataDir, nodeConfig.bootnodes, genesisPath);
-        }
-        
-        // Auto-start farmer after a short delay (node should be ready first)
-        if (farmerConfig.autoStart) {
-            QTimer::singleShot(1000, this, [this, farmerConfig]() {
-                qDebug() << "Auto-starting Archivas farmer...";
-                m_nodeManager->startFarmer(farmerConfig.nodeUrl, farmerConfig.plotsPath,
-                                          farmerConfig.farmerPrivkeyPath);
-            });
+            QFuture<bool> nodeStarted = m_nodeManager->startNode(nodeConfig.network, nodeConfig.rpcBind,
+                                                                 nodeConfig.dataDir, nodeConfig.bootnodes, genesisPath);
+
+            // Start the farmer once the node is actually up
+            if (farmerConfig.autoStart) {
+                auto* watcher = new QFutureWatcher<bool>(this);
+                connect(watcher, &QFutureWatcher<bool>::finished, this, [watcher, startFarmer]() {
+                    if (watcher->result()) {
+                        startFarmer();
+                    }
+                    watcher->deleteLater();
+                });
+                watcher->setFuture(nodeStarted);
+            }
+        } else if (farmerConfig.autoStart) {
+            startFarmer();
         }
     });
 }
@@ -145,6 +191,50 @@ MainWindow::~MainWindow()
 {
 }
 
+void MainWindow::closeEvent(QCloseEvent *event)
+{
+    if (m_shutdownComplete || (!m_nodeManager->isNodeRunning() && !m_nodeManager->isFarmerRunning())) {
+        event->accept();
+        return;
+    }
+
+    // Let the node and farmer tear down without blocking the UI, then quit
+    event->ignore();
+    if (!isVisible()) {
+        return; // Shutdown already in progress
+    }
+    hide();
+    auto* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        m_shutdownComplete = true;
+        QApplication::quit();
+    });
+    watcher->setFuture(m_nodeManager->shutdown());
+}
+
+void MainWindow::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::WindowStateChange) {
+        // Nothing is on screen while minimized, so nothing needs refreshing
+        m_scheduler->setPaused(isMinimized() || !isVisible());
+    }
+    QMainWindow::changeEvent(event);
+}
+
+void MainWindow::showEvent(QShowEvent *event)
+{
+    QMainWindow::showEvent(event);
+    m_scheduler->setPaused(isMinimized());
+}
+
+void MainWindow::hideEvent(QHideEvent *event)
+{
+    // Hidden to the tray, or on the way out in closeEvent()
+    QMainWindow::hideEvent(event);
+    m_scheduler->setPaused(true);
+}
+
 void MainWindow::setupUi()
 {
     setWindowTitle("Archivas Core");
@@ -218,13 +308,9 @@ void MainWindow::setupPages()
     m_overviewPage = new OverviewPage(m_rpcClient, m_nodeManager, this);
     m_nodePage = new NodePage(m_nodeManager, m_configManager, this);
     m_farmerPage = new FarmerPage(m_nodeManager, m_configManager, this);
-    m_blocksPage = new BlocksPage(m_rpcClient, this);
-    m_transactionsPage = new TransactionsPage(m_rpcClient, this);
+    m_blocksPage = new BlocksPage(m_rpcClient, m_headerCache, this);
+    m_transactionsPage = new TransactionsPage(m_rpcClient, m_txIndex, this);
     m_logsPage = new LogsPage(m_nodeManager, this);
-    
-    // Connect logs after logs page is created
-    connect(m_nodeManager, &ArchivasNodeManager::nodeLog, m_logsPage, &LogsPage::addNodeLog);
-    connect(m_nodeManager, &ArchivasNodeManager::farmerLog, m_logsPage, &LogsPage::addFarmerLog);
 
     // Add pages to stack
     m_stackedWidget->addWidget(m_overviewPage);
@@ -239,6 +325,7 @@ void MainWindow::onPageChanged(int index)
 {
     if (m_stackedWidget && index >= 0 && index < m_stackedWidget->count()) {
         m_stackedWidget->setCurrentIndex(index);
+        m_scheduler->setCurrentPage(m_stackedWidget->currentWidget());
     }
 }
 
@@ -256,10 +343,33 @@ void MainWindow::onFarmerStatusChanged()
 
 void MainWindow::onChainTipUpdated(const ChainTip& tip)
 {
-    Q_UNUSED(tip);
+    // A moving chain brings every refresh back to full rate; while the tip
+    // stays put the poll slows down
+    if (tip.height != m_lastTip.height || tip.hash != m_lastTip.hash) {
+        m_lastTip = tip;
+        m_scheduler->snap();
+    } else if (m_tipTask >= 0) {
+        m_scheduler->backOff(m_tipTask);
+    }
     updateStatusBar();
 }
 
+void MainWindow::onSubscriptionChanged(bool live)
+{
+    Q_UNUSED(live);
+    if (m_tipTask >= 0) {
+        m_scheduler->setInterval(m_tipTask, tipPollIntervalMs());
+    }
+}
+
+int MainWindow::tipPollIntervalMs() const
+{
+    if (m_rpcClient->isSubscribed()) {
+        return kStreamingPollIntervalMs;
+    }
+    return m_configManager->getRpcConfig().pollIntervalMs;
+}
+
 void MainWindow::onRpcConnected()
 {
     m_rpcConnected = true;
@@ -280,34 +390,52 @@ void MainWindow::updateStatusBar()
     status += QString("RPC: %1").arg(m_rpcConnected ? "Connected" : "Disconnected");
 
     statusBar()->showMessage(status);
+    statusBar()->setToolTip(QString("Refresh wakeups in the last minute: %1").arg(m_scheduler->wakeupsPerMinute()));
 }
 
 void MainWindow::startPolling()
 {
-    if (m_pollTimer) {
+    if (m_tipTask >= 0) {
         return; // Already started
     }
-    
-    RpcConfig rpcConfig = m_configManager->getRpcConfig();
-    m_pollTimer = new QTimer(this);
-    m_pollTimer->setSingleShot(false);
-    connect(m_pollTimer, &QTimer::timeout, [this]() {
-        if (m_rpcClient) {
-            m_rpcClient->getChainTip();
-            m_rpcClient->getRecentBlocks(20);
-            m_rpcClient->getRecentTransactions(50);
+
+    // Only the tip is polled; blocks and transactions are fetched when it
+    // moves. A due Transactions refresh rides along in the same batch.
+    m_tipTask = m_scheduler->addTask(nullptr, tipPollIntervalMs(), [this]() {
+        RpcBatch batch = m_rpcClient->batch().chainTip();
+        if (m_transactionsRefreshDue) {
+            m_transactionsRefreshDue = false;
+            m_transactionsPage->addRefreshTo(batch);
         }
+        batch.send();
     });
-    m_pollTimer->start(rpcConfig.pollIntervalMs);
-
-    // Initial poll after a short delay to ensure event loop is running
-    QTimer::singleShot(500, [this]() {
-        if (m_rpcClient) {
-            m_rpcClient->getChainTip();
-            m_rpcClient->getRecentBlocks(20);
-            m_rpcClient->getRecentTransactions(50);
-        }
+    m_scheduler->addTask(nullptr, kEndpointProbeIntervalMs, [this]() {
+        m_rpcClient->endpointPool()->probe();
+    });
+
+    // Page refreshes triggered by events are held back while the page is hidden
+    int transactionsTask = m_scheduler->addTask(m_transactionsPage, 0, [this]() {
+        m_transactionsRefreshDue = true;
+        m_scheduler->requestRun(m_tipTask);
     });
+    connect(m_rpcClient, &ArchivasRpcClient::blocksAppended, this, [this, transactionsTask]() {
+        m_scheduler->requestRun(transactionsTask);
+    });
+    connect(m_rpcClient, &ArchivasRpcClient::reorgDetected, this, [this, transactionsTask]() {
+        m_scheduler->requestRun(transactionsTask);
+    });
+    connect(m_rpcClient, &ArchivasRpcClient::sourceChanged, this, [this, transactionsTask]() {
+        m_scheduler->requestRun(transactionsTask);
+    });
+    int endpointsTask = m_scheduler->addTask(m_overviewPage, 0, [this]() {
+        m_overviewPage->updateEndpoints();
+    });
+    connect(m_rpcClient->endpointPool(), &RpcEndpointPool::statsChanged, this, [this, endpointsTask]() {
+        m_scheduler->requestRun(endpointsTask);
+    });
+
+    m_scheduler->requestRun(m_tipTask);
+    m_scheduler->requestRun(transactionsTask);
 }
 
 void MainWindow::showSettings()
@@ -316,11 +444,20 @@ void MainWindow::showSettings()
     if (dialog.exec() == QDialog::Accepted) {
         // Reload config
         m_configManager->loadConfig();
+        m_nodeManager->setLogLevel(LogRecord::Node, m_configManager->getNodeConfig().logLevel);
+        m_nodeManager->setLogLevel(LogRecord::Farmer, m_configManager->getFarmerConfig().logLevel);
+        m_nodeManager->setStreamBind(m_configManager->getNodeConfig().streamBind);
         RpcConfig rpcConfig = m_configManager->getRpcConfig();
-        m_rpcClient->setBaseUrl(rpcConfig.url);
-        m_rpcClient->setFallbackUrl(rpcConfig.fallbackUrl);
-        if (m_pollTimer) {
-            m_pollTimer->setInterval(rpcConfig.pollIntervalMs);
+        m_rpcClient->setEndpoints(rpcConfig.urls);
+        m_rpcClient->setHedgingEnabled(rpcConfig.hedgeRequests);
+        m_rpcClient->setEmbeddedRpcBind(m_configManager->getNodeConfig().rpcBind);
+        m_rpcClient->setCacheTtl(rpcConfig.cacheTtlMs);
+        m_rpcClient->setRequestTimeout(rpcConfig.requestTimeoutMs);
+        m_rpcClient->subscribe(rpcConfig.streamUrl);
+        m_headerCache->open(guiCacheDir(m_configManager->getNodeConfig(), "headers"));
+        m_txIndex->open(guiCacheDir(m_configManager->getNodeConfig(), "txindex"));
+        if (m_tipTask >= 0) {
+            m_scheduler->setInterval(m_tipTask, tipPollIntervalMs());
         }
     }
 }
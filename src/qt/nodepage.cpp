@@ -1,6 +1,6 @@
 #include "nodepage.h"
 #include <QScrollBar>
-#include <QTimer>
+#include <QFutureWatcher>
 #include <QFont>
 #include <QDateTime>
 
@@ -14,21 +14,16 @@ NodePage::NodePage(ArchivasNodeManager* nodeManager, ConfigManager* configManage
     , m_statusLabel(nullptr)
     , m_peerCountLabel(nullptr)
     , m_logTextEdit(nullptr)
-    , m_statusTimer(nullptr)
 {
     setupUi();
 
     // Connect signals
     connect(m_nodeManager, &ArchivasNodeManager::nodeStarted, this, &NodePage::onNodeStarted);
     connect(m_nodeManager, &ArchivasNodeManager::nodeStopped, this, &NodePage::onNodeStopped);
-    connect(m_nodeManager, &ArchivasNodeManager::nodeLog, this, &NodePage::onNodeLog);
+    connect(m_nodeManager, &ArchivasNodeManager::nodeStateChanged, this, &NodePage::onNodeStateChanged);
+    connect(m_nodeManager, &ArchivasNodeManager::logBatch, this, &NodePage::onLogBatch);
     connect(m_nodeManager, &ArchivasNodeManager::statusUpdated, this, &NodePage::updateStatus);
 
-    // Status update timer
-    m_statusTimer = new QTimer(this);
-    connect(m_statusTimer, &QTimer::timeout, this, &NodePage::updateStatus);
-    m_statusTimer->start(5000); // Update every 5 seconds
-
     updateStatus();
 }
 
@@ -86,24 +81,33 @@ void NodePage::setupUi()
 }
 
 void NodePage::onStartNode()
+{
+    launchNode(false);
+}
+
+void NodePage::launchNode(bool restart)
 {
     NodeConfig config = m_configManager->getNodeConfig();
     
     QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    m_logTextEdit->appendPlainText(QString("[%1] Starting Archivas node...").arg(timestamp));
+    m_logTextEdit->appendPlainText(QString("[%1] %2 Archivas node...").arg(timestamp, restart ? "Restarting" : "Starting"));
     m_logTextEdit->appendPlainText(QString("[%1] Network: %2, RPC Bind: %3, Data Dir: %4")
         .arg(timestamp, config.network, config.rpcBind, config.dataDir));
     
     // Extract genesis file from Qt resources
     QString genesisPath = extractGenesisFile();
-    bool success = m_nodeManager->startNode(config.network, config.rpcBind, 
-                                           config.dataDir, config.bootnodes, genesisPath);
-    if (!success) {
-        QString error = "ERROR: Failed to start node. Check the logs above for details.";
-        m_logTextEdit->appendPlainText(error);
-    } else {
-        m_logTextEdit->appendPlainText(QString("[%1] Node start command sent successfully. Waiting for node to start...").arg(timestamp));
-    }
+    QFuture<bool> started = restart
+        ? m_nodeManager->restartNode(config.network, config.rpcBind, config.dataDir, config.bootnodes, genesisPath)
+        : m_nodeManager->startNode(config.network, config.rpcBind, config.dataDir, config.bootnodes, genesisPath);
+
+    auto* watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher]() {
+        if (!watcher->result()) {
+            m_logTextEdit->appendPlainText("ERROR: Failed to start node. Check the logs above for details.");
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(started);
     
     // Save config
     m_configManager->setNodeConfig(config);
@@ -119,8 +123,8 @@ void NodePage::onStopNode()
 
 void NodePage::onRestartNode()
 {
-    onStopNode();
-    QTimer::singleShot(1000, this, &NodePage::onStartNode);
+    // The new instance starts as soon as the old one has finished stopping
+    launchNode(true);
 }
 
 QString NodePage::extractGenesisFile()
@@ -173,13 +177,19 @@ void NodePage::onNodeStopped()
     m_logTextEdit->appendPlainText(QString("[%1] Node stopped").arg(timestamp));
 }
 
-void NodePage::onNodeLog(const QString &level, const QString &message)
+void NodePage::onNodeStateChanged()
 {
-    if (message.isEmpty()) {
+    updateStatus();
+    updateControls();
+}
+
+void NodePage::onLogBatch(const QVector<LogRecord> &records)
+{
+    QString lines = formatLogRecords(records, LogRecord::Node);
+    if (lines.isEmpty()) {
         return;
     }
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    m_logTextEdit->appendPlainText(QString("[%1] [%2] %3").arg(timestamp, level, message));
+    m_logTextEdit->appendPlainText(lines);
     // Auto-scroll to bottom
     QScrollBar* scrollBar = m_logTextEdit->verticalScrollBar();
     scrollBar->setValue(scrollBar->maximum());
@@ -187,14 +197,9 @@ void NodePage::onNodeLog(const QString &level, const QString &message)
 
 void NodePage::updateStatus()
 {
-    bool running = m_nodeManager->isNodeRunning();
-    if (running) {
-        m_statusLabel->setText("Running");
-        m_statusLabel->setStyleSheet("color: green; font-weight: bold;");
-    } else {
-        m_statusLabel->setText("Stopped");
-        m_statusLabel->setStyleSheet("color: red; font-weight: bold;");
-    }
+    ArchivasNodeManager::ServiceState state = m_nodeManager->nodeState();
+    m_statusLabel->setText(ArchivasNodeManager::serviceStateName(state));
+    m_statusLabel->setStyleSheet(ArchivasNodeManager::serviceStateStyle(state));
     
     // Update peer count
     int peerCount = m_nodeManager->getPeerCount();
@@ -203,8 +208,8 @@ void NodePage::updateStatus()
 
 void NodePage::updateControls()
 {
-    bool running = m_nodeManager->isNodeRunning();
-    m_startButton->setEnabled(!running);
-    m_stopButton->setEnabled(running);
-    m_restartButton->setEnabled(running);
+    ArchivasNodeManager::ServiceState state = m_nodeManager->nodeState();
+    m_startButton->setEnabled(!m_nodeManager->isNodeRunning());
+    m_stopButton->setEnabled(state == ArchivasNodeManager::Starting || state == ArchivasNodeManager::Running);
+    m_restartButton->setEnabled(state == ArchivasNodeManager::Running);
 }
@@ -5,7 +5,9 @@
 #include <QGridLayout>
 #include <QVBoxLayout>
 #include <QLabel>
-#include <QTimer>
+#include <QHeaderView>
+#include <QColor>
+#include <QFont>
 
 OverviewPage::OverviewPage(ArchivasRpcClient* rpcClient, ArchivasNodeManager* nodeManager, QWidget *parent)
     : QWidget(parent)
@@ -19,7 +21,7 @@ OverviewPage::OverviewPage(ArchivasRpcClient* rpcClient, ArchivasNodeManager* no
     , m_farmerStatusLabel(nullptr)
     , m_networkLabel(nullptr)
     , m_rpcStatusLabel(nullptr)
-    , m_updateTimer(nullptr)
+    , m_endpointTable(nullptr)
     , m_nodeRunning(false)
     , m_farmerRunning(false)
     , m_rpcConnected(false)
@@ -36,14 +38,10 @@ OverviewPage::OverviewPage(ArchivasRpcClient* rpcClient, ArchivasNodeManager* no
     connect(m_nodeManager, &ArchivasNodeManager::farmerStopped, this, &OverviewPage::onFarmerStatusChanged);
     connect(m_nodeManager, &ArchivasNodeManager::statusUpdated, this, &OverviewPage::updateDisplay);
 
-    // Update timer
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &OverviewPage::updateDisplay);
-    m_updateTimer->start(5000); // Update every 5 seconds
-
     // Initial update
     updateDisplay();
     updateStatusIndicators();
+    updateEndpoints();
 }
 
 OverviewPage::~OverviewPage()
@@ -103,6 +101,21 @@ void OverviewPage::setupUi()
 
     mainLayout->addWidget(serviceGroup);
 
+    // RPC Endpoints Group
+    QGroupBox* endpointGroup = new QGroupBox("RPC Endpoints", this);
+    QVBoxLayout* endpointLayout = new QVBoxLayout(endpointGroup);
+
+    m_endpointTable = new QTableWidget(endpointGroup);
+    m_endpointTable->setColumnCount(6);
+    m_endpointTable->setHorizontalHeaderLabels({"Endpoint", "Status", "Avg (ms)", "p95 (ms)", "Errors", "Latency"});
+    m_endpointTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_endpointTable->setSelectionMode(QAbstractItemView::NoSelection);
+    m_endpointTable->verticalHeader()->setVisible(false);
+    m_endpointTable->horizontalHeader()->setStretchLastSection(true);
+    endpointLayout->addWidget(m_endpointTable);
+
+    mainLayout->addWidget(endpointGroup);
+
     mainLayout->addStretch();
 }
 
@@ -142,9 +155,9 @@ void OverviewPage::updateDisplay()
     int height = m_nodeManager->getCurrentHeight();
     if (height > 0) {
         m_chainHeightLabel->setText(QString::number(height));
-    } else if (!m_currentTip.height.isEmpty()) {
+    } else if (m_currentTip.height > 0) {
         // Fallback to RPC data if node manager doesn't have data yet
-        m_chainHeightLabel->setText(m_currentTip.height);
+        m_chainHeightLabel->setText(QString::number(m_currentTip.height));
     } else {
         m_chainHeightLabel->setText("—");
     }
@@ -157,28 +170,28 @@ void OverviewPage::updateDisplay()
         }
         m_chainHashLabel->setText(shortHash);
         m_chainHashLabel->setToolTip(tipHash); // Show full hash on hover
-    } else if (!m_currentTip.hash.isEmpty()) {
+    } else if (!m_currentTip.hash.isNull()) {
         // Fallback to RPC data
-        QString shortHash = m_currentTip.hash;
-        if (shortHash.length() > 16) {
-            shortHash = shortHash.left(8) + "..." + shortHash.right(8);
-        }
-        m_chainHashLabel->setText(shortHash);
-        m_chainHashLabel->setToolTip(m_currentTip.hash);
+        QString hash = m_currentTip.hash.toHex();
+        m_chainHashLabel->setText(abbreviate(hash));
+        m_chainHashLabel->setToolTip(hash);
     } else {
         m_chainHashLabel->setText("—");
         m_chainHashLabel->setToolTip("");
     }
 
-    // Difficulty from RPC (node manager doesn't provide this yet)
-    if (!m_currentTip.difficulty.isEmpty()) {
-        m_difficultyLabel->setText(m_currentTip.difficulty);
+    quint64 difficulty = m_nodeManager->getDifficulty();
+    if (difficulty > 0) {
+        m_difficultyLabel->setText(QString::number(difficulty));
+    } else if (m_currentTip.difficulty > 0) {
+        // Fallback to RPC data
+        m_difficultyLabel->setText(QString::number(m_currentTip.difficulty));
     } else {
         m_difficultyLabel->setText("—");
     }
 
-    if (!m_currentTip.timestamp.isEmpty()) {
-        m_timestampLabel->setText(m_currentTip.timestamp);
+    if (m_currentTip.timestamp > 0) {
+        m_timestampLabel->setText(formatTimestamp(m_currentTip.timestamp));
     } else {
         m_timestampLabel->setText("—");
     }
@@ -189,6 +202,59 @@ void OverviewPage::updateDisplay()
     updateStatusIndicators();
 }
 
+void OverviewPage::updateEndpoints()
+{
+    static const QString kBars[] = {" ", "\u2581", "\u2582", "\u2583", "\u2584", "\u2585", "\u2586", "\u2587", "\u2588"};
+
+    RpcEndpointPool* pool = m_rpcClient->endpointPool();
+    QVector<RpcEndpointStats> endpoints = pool->stats();
+    const QVector<int>& bounds = RpcEndpointPool::latencyBucketBounds();
+    QString active = pool->pick();
+
+    m_endpointTable->setRowCount(endpoints.size());
+    for (int row = 0; row < endpoints.size(); ++row) {
+        const RpcEndpointStats& endpoint = endpoints[row];
+        quint64 successes = endpoint.requests - endpoint.failures;
+
+        QTableWidgetItem* urlItem = new QTableWidgetItem(endpoint.url);
+        if (endpoint.url == active) {
+            QFont font = urlItem->font();
+            font.setBold(true);
+            urlItem->setFont(font);
+            urlItem->setToolTip("Currently preferred");
+        }
+        m_endpointTable->setItem(row, 0, urlItem);
+
+        QTableWidgetItem* statusItem = new QTableWidgetItem(endpoint.healthy ? "Healthy" : "Demoted");
+        statusItem->setForeground(endpoint.healthy ? QColor("green") : QColor("red"));
+        m_endpointTable->setItem(row, 1, statusItem);
+
+        m_endpointTable->setItem(row, 2, new QTableWidgetItem(successes > 0 ? QString::number(qRound(endpoint.latencyMs)) : "—"));
+        m_endpointTable->setItem(row, 3, new QTableWidgetItem(successes > 0 ? QString::number(pool->p95LatencyMs(endpoint.url)) : "—"));
+        m_endpointTable->setItem(row, 4, new QTableWidgetItem(QString("%1 / %2").arg(endpoint.failures).arg(endpoint.requests)));
+
+        // One bar per latency bucket, scaled to the fullest bucket
+        quint64 peak = 0;
+        for (quint64 count : endpoint.histogram) {
+            peak = qMax(peak, count);
+        }
+        QString bars;
+        QStringList tooltip;
+        for (int bucket = 0; bucket < endpoint.histogram.size(); ++bucket) {
+            quint64 count = endpoint.histogram[bucket];
+            bars += kBars[peak > 0 ? static_cast<int>((count * 8 + peak - 1) / peak) : 0];
+            QString range = bucket < bounds.size()
+                ? QString("\u2264 %1 ms").arg(bounds[bucket])
+                : QString("> %1 ms").arg(bounds.last());
+            tooltip.append(QString("%1: %2").arg(range).arg(count));
+        }
+        QTableWidgetItem* histogramItem = new QTableWidgetItem(bars);
+        histogramItem->setToolTip(tooltip.join("\n"));
+        m_endpointTable->setItem(row, 5, histogramItem);
+    }
+    m_endpointTable->resizeColumnsToContents();
+}
+
 void OverviewPage::updateStatusIndicators()
 {
     // Node status
@@ -0,0 +1,192 @@
+#include "refreshscheduler.h"
+#include <QTimer>
+#include <QWidget>
+
+// Interval doublings allowed while a task's page is showing and while it is not
+static const int kMaxShowingBackoff = 2;
+static const int kMaxHiddenBackoff = 4;
+static const qint64 kMaxIntervalMs = 5 * 60 * 1000;
+static const qint64 kWakeupWindowMs = 60000;
+
+RefreshScheduler::RefreshScheduler(QObject *parent)
+    : QObject(parent)
+    , m_currentPage(nullptr)
+    , m_paused(false)
+    , m_timer(nullptr)
+{
+    m_clock.start();
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &RefreshScheduler::onTimeout);
+}
+
+int RefreshScheduler::addTask(QWidget* page, int intervalMs, std::function<void()> run)
+{
+    Task task;
+    task.page = page;
+    task.intervalMs = qMax(0, intervalMs);
+    task.run = std::move(run);
+    m_tasks.append(task);
+    reschedule(m_tasks.last());
+    rearm();
+    return m_tasks.size() - 1;
+}
+
+void RefreshScheduler::setInterval(int task, int intervalMs)
+{
+    if (task < 0 || task >= m_tasks.size()) {
+        return;
+    }
+    m_tasks[task].intervalMs = qMax(0, intervalMs);
+    reschedule(m_tasks[task]);
+    rearm();
+}
+
+void RefreshScheduler::requestRun(int task)
+{
+    if (task < 0 || task >= m_tasks.size()) {
+        return;
+    }
+    Task& t = m_tasks[task];
+    if (!isShowing(t)) {
+        t.pending = true;
+        return;
+    }
+    t.dueMs = m_clock.elapsed();
+    rearm();
+}
+
+void RefreshScheduler::backOff(int task)
+{
+    if (task < 0 || task >= m_tasks.size()) {
+        return;
+    }
+    Task& t = m_tasks[task];
+    t.backoff = qMin(t.backoff + 1, kMaxHiddenBackoff);
+    reschedule(t);
+    rearm();
+}
+
+void RefreshScheduler::snap()
+{
+    for (Task& task : m_tasks) {
+        if (task.backoff > 0) {
+            task.backoff = 0;
+            reschedule(task);
+        }
+    }
+    rearm();
+}
+
+void RefreshScheduler::setCurrentPage(QWidget* page)
+{
+    m_currentPage = page;
+    if (m_paused) {
+        return;
+    }
+    // What the page shows may be stale: refresh it now, then at full rate
+    qint64 now = m_clock.elapsed();
+    for (Task& task : m_tasks) {
+        if (task.page == page && (task.pending || task.backoff > 0)) {
+            task.backoff = 0;
+            task.dueMs = now;
+        }
+    }
+    rearm();
+}
+
+void RefreshScheduler::setPaused(bool paused)
+{
+    if (m_paused == paused) {
+        return;
+    }
+    m_paused = paused;
+    if (m_paused) {
+        m_timer->stop();
+        return;
+    }
+
+    // Back from the tray: bring whatever is on screen up to date at once
+    qint64 now = m_clock.elapsed();
+    for (Task& task : m_tasks) {
+        task.backoff = 0;
+        if (isShowing(task) && (task.pending || task.intervalMs > 0)) {
+            task.dueMs = now;
+        } else {
+            reschedule(task);
+        }
+    }
+    rearm();
+}
+
+int RefreshScheduler::wakeupsPerMinute()
+{
+    qint64 cutoff = m_clock.elapsed() - kWakeupWindowMs;
+    while (!m_wakeups.isEmpty() && m_wakeups.head() < cutoff) {
+        m_wakeups.dequeue();
+    }
+    return m_wakeups.size();
+}
+
+bool RefreshScheduler::isShowing(const Task& task) const
+{
+    return !m_paused && (task.page == nullptr || task.page == m_currentPage);
+}
+
+qint64 RefreshScheduler::effectiveIntervalMs(const Task& task) const
+{
+    int backoff = qMin(task.backoff, isShowing(task) ? kMaxShowingBackoff : kMaxHiddenBackoff);
+    return qMin(kMaxIntervalMs, static_cast<qint64>(task.intervalMs) << backoff);
+}
+
+void RefreshScheduler::reschedule(Task& task)
+{
+    task.dueMs = task.intervalMs > 0 ? m_clock.elapsed() + effectiveIntervalMs(task) : -1;
+}
+
+void RefreshScheduler::rearm()
+{
+    if (m_paused) {
+        return;
+    }
+    qint64 next = -1;
+    for (const Task& task : m_tasks) {
+        if (task.dueMs >= 0 && (next < 0 || task.dueMs < next)) {
+            next = task.dueMs;
+        }
+    }
+    if (next < 0) {
+        m_timer->stop();
+        return;
+    }
+    m_timer->start(static_cast<int>(qMax<qint64>(0, next - m_clock.elapsed())));
+}
+
+void RefreshScheduler::onTimeout()
+{
+    if (m_paused) {
+        return;
+    }
+    qint64 now = m_clock.elapsed();
+    m_wakeups.enqueue(now);
+    wakeupsPerMinute();
+
+    // Collected first: a task may call back into the scheduler while it runs
+    QVector<std::function<void()>> due;
+    for (Task& task : m_tasks) {
+        if (task.dueMs < 0 || task.dueMs > now) {
+            continue;
+        }
+        task.pending = false;
+        if (task.intervalMs > 0 && !isShowing(task)) {
+            // Nobody is looking: each run waits twice as long as the last
+            task.backoff = qMin(task.backoff + 1, kMaxHiddenBackoff);
+        }
+        reschedule(task);
+        due.append(task.run);
+    }
+    for (const std::function<void()>& run : due) {
+        run();
+    }
+    rearm();
+}
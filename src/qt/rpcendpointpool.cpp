@@ -0,0 +1,203 @@
+#include "rpcendpointpool.h"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QElapsedTimer>
+#include <QUrl>
+#include <limits>
+
+// Weight of the newest sample in the latency and error averages
+static const double kEwmaAlpha = 0.2;
+// Consecutive failures before an endpoint is demoted
+static const int kDemoteAfterFailures = 2;
+static const int kProbeTimeoutMs = 5000;
+// p95 needs this many samples; until then kDefaultP95Ms is assumed
+static const quint64 kMinP95Samples = 20;
+static const int kDefaultP95Ms = 1000;
+
+static QString normalizeUrl(const QString& url)
+{
+    QString clean = url.trimmed();
+    while (clean.endsWith('/')) {
+        clean.chop(1);
+    }
+    return clean;
+}
+
+RpcEndpointPool::RpcEndpointPool(QObject *parent)
+    : QObject(parent)
+    , m_probeManager(nullptr)
+{
+    m_probeManager = new QNetworkAccessManager(this);
+}
+
+const QVector<int>& RpcEndpointPool::latencyBucketBounds()
+{
+    static const QVector<int> bounds = {10, 25, 50, 100, 250, 500, 1000, 2500, 5000};
+    return bounds;
+}
+
+void RpcEndpointPool::setUrls(const QStringList& urls)
+{
+    QVector<RpcEndpointStats> endpoints;
+    for (const QString& url : urls) {
+        QString clean = normalizeUrl(url);
+        if (clean.isEmpty()) {
+            continue;
+        }
+        bool duplicate = false;
+        for (const RpcEndpointStats& endpoint : endpoints) {
+            duplicate = duplicate || endpoint.url == clean;
+        }
+        if (duplicate) {
+            continue;
+        }
+
+        // Keep the history of endpoints that stay configured
+        int existing = indexOf(clean);
+        if (existing >= 0) {
+            endpoints.append(m_endpoints[existing]);
+        } else {
+            RpcEndpointStats endpoint;
+            endpoint.url = clean;
+            endpoint.histogram.fill(0, latencyBucketBounds().size() + 1);
+            endpoints.append(endpoint);
+        }
+    }
+    m_endpoints = endpoints;
+    emit statsChanged();
+}
+
+QStringList RpcEndpointPool::urls() const
+{
+    QStringList urls;
+    for (const RpcEndpointStats& endpoint : m_endpoints) {
+        urls.append(endpoint.url);
+    }
+    return urls;
+}
+
+int RpcEndpointPool::indexOf(const QString& url) const
+{
+    for (int i = 0; i < m_endpoints.size(); ++i) {
+        if (m_endpoints[i].url == url) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+double RpcEndpointPool::score(const RpcEndpointStats& endpoint)
+{
+    // Until an endpoint has answered once, configuration order decides
+    if (endpoint.requests == endpoint.failures) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // Lower is better. Errors weigh heavily so a fast but flaky endpoint loses.
+    return endpoint.latencyMs * (1.0 + 4.0 * endpoint.errorRate);
+}
+
+QString RpcEndpointPool::pick(const QStringList& exclude) const
+{
+    const RpcEndpointStats* best = nullptr;
+    for (const RpcEndpointStats& endpoint : m_endpoints) {
+        if (exclude.contains(endpoint.url)) {
+            continue;
+        }
+        if (!best || (endpoint.healthy && !best->healthy) ||
+            (endpoint.healthy == best->healthy && score(endpoint) < score(*best))) {
+            best = &endpoint;
+        }
+    }
+    return best ? best->url : QString();
+}
+
+void RpcEndpointPool::recordSuccess(const QString& url, qint64 latencyMs)
+{
+    int index = indexOf(url);
+    if (index < 0) {
+        return;
+    }
+    RpcEndpointStats& endpoint = m_endpoints[index];
+    ++endpoint.requests;
+    bool firstSuccess = endpoint.requests - endpoint.failures == 1;
+    endpoint.latencyMs = firstSuccess
+        ? latencyMs
+        : endpoint.latencyMs + kEwmaAlpha * (latencyMs - endpoint.latencyMs);
+    endpoint.errorRate *= 1.0 - kEwmaAlpha;
+    endpoint.consecutiveFailures = 0;
+    endpoint.healthy = true;
+
+    const QVector<int>& bounds = latencyBucketBounds();
+    int bucket = 0;
+    while (bucket < bounds.size() && latencyMs > bounds[bucket]) {
+        ++bucket;
+    }
+    ++endpoint.histogram[bucket];
+
+    emit statsChanged();
+}
+
+void RpcEndpointPool::recordFailure(const QString& url)
+{
+    int index = indexOf(url);
+    if (index < 0) {
+        return;
+    }
+    RpcEndpointStats& endpoint = m_endpoints[index];
+    ++endpoint.requests;
+    ++endpoint.failures;
+    endpoint.errorRate += kEwmaAlpha * (1.0 - endpoint.errorRate);
+    if (++endpoint.consecutiveFailures >= kDemoteAfterFailures) {
+        endpoint.healthy = false;
+    }
+    emit statsChanged();
+}
+
+int RpcEndpointPool::p95LatencyMs(const QString& url) const
+{
+    int index = indexOf(url);
+    if (index < 0) {
+        return kDefaultP95Ms;
+    }
+    const RpcEndpointStats& endpoint = m_endpoints[index];
+    quint64 samples = endpoint.requests - endpoint.failures;
+    if (samples < kMinP95Samples) {
+        return kDefaultP95Ms;
+    }
+
+    const QVector<int>& bounds = latencyBucketBounds();
+    quint64 threshold = (samples * 95 + 99) / 100;
+    quint64 seen = 0;
+    for (int bucket = 0; bucket < bounds.size(); ++bucket) {
+        seen += endpoint.histogram[bucket];
+        if (seen >= threshold) {
+            return bounds[bucket];
+        }
+    }
+    return bounds.last() * 2;
+}
+
+void RpcEndpointPool::probe()
+{
+    // Demoted endpoints get a chance to come back; healthy ones keep their
+    // latency current even when requests are going elsewhere
+    for (const RpcEndpointStats& endpoint : m_endpoints) {
+        QNetworkRequest request(QUrl(endpoint.url + "/chainTip"));
+        request.setRawHeader("User-Agent", "Archivas-Core-GUI/1.0");
+        request.setTransferTimeout(kProbeTimeoutMs);
+
+        QElapsedTimer timer;
+        timer.start();
+        QNetworkReply* reply = m_probeManager->get(request);
+        QString url = endpoint.url;
+        connect(reply, &QNetworkReply::finished, this, [this, reply, url, timer]() {
+            if (reply->error() == QNetworkReply::NoError) {
+                recordSuccess(url, timer.elapsed());
+            } else {
+                recordFailure(url);
+            }
+            reply->deleteLater();
+        });
+    }
+}
@@ -6,9 +6,12 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLineEdit>
+#include <QPlainTextEdit>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QPushButton>
 #include <QFileDialog>
+#include "archivasnodemanager.h"
 
 SettingsDialog::SettingsDialog(ConfigManager* configManager, QWidget *parent)
     : QDialog(parent)
@@ -51,6 +54,10 @@ void SettingsDialog::setupUi()
     m_nodeRpcBindEdit = new QLineEdit(nodeTab);
     nodeLayout->addRow("RPC Bind:", m_nodeRpcBindEdit);
 
+    m_nodeStreamBindEdit = new QLineEdit(nodeTab);
+    m_nodeStreamBindEdit->setToolTip("Where the node pushes new blocks to the GUI. Leave empty to disable.");
+    nodeLayout->addRow("Event Stream Bind:", m_nodeStreamBindEdit);
+
     QHBoxLayout* nodeDataDirLayout = new QHBoxLayout();
     m_nodeDataDirEdit = new QLineEdit(nodeTab);
     QPushButton* nodeDataDirBrowse = new QPushButton("Browse...", nodeTab);
@@ -65,6 +72,10 @@ void SettingsDialog::setupUi()
     m_nodeAutoStartCheck = new QCheckBox(nodeTab);
     nodeLayout->addRow("Auto-start:", m_nodeAutoStartCheck);
 
+    m_nodeLogLevelCombo = new QComboBox(nodeTab);
+    m_nodeLogLevelCombo->addItems(ArchivasNodeManager::logLevelNames());
+    nodeLayout->addRow("Log Level:", m_nodeLogLevelCombo);
+
     tabWidget->addTab(nodeTab, "Node");
 
     // Farmer tab
@@ -103,6 +114,10 @@ void SettingsDialog::setupUi()
     m_farmerAutoStartCheck = new QCheckBox(farmerTab);
     farmerLayout->addRow("Auto-start:", m_farmerAutoStartCheck);
 
+    m_farmerLogLevelCombo = new QComboBox(farmerTab);
+    m_farmerLogLevelCombo->addItems(ArchivasNodeManager::logLevelNames());
+    farmerLayout->addRow("Log Level:", m_farmerLogLevelCombo);
+
     tabWidget->addTab(farmerTab, "Farmer");
 
     // RPC tab
@@ -110,15 +125,29 @@ void SettingsDialog::setupUi()
     QFormLayout* rpcLayout = new QFormLayout(rpcTab);
     rpcLayout->setSpacing(10);
 
-    m_rpcUrlEdit = new QLineEdit(rpcTab);
-    rpcLayout->addRow("RPC URL:", m_rpcUrlEdit);
+    m_rpcUrlsEdit = new QPlainTextEdit(rpcTab);
+    m_rpcUrlsEdit->setToolTip("One URL per line, in order of preference. Requests fail over down the list.");
+    m_rpcUrlsEdit->setMaximumHeight(90);
+    rpcLayout->addRow("RPC Endpoints:", m_rpcUrlsEdit);
 
-    m_rpcFallbackUrlEdit = new QLineEdit(rpcTab);
-    rpcLayout->addRow("Fallback URL:", m_rpcFallbackUrlEdit);
+    m_rpcStreamUrlEdit = new QLineEdit(rpcTab);
+    m_rpcStreamUrlEdit->setToolTip("Server-Sent Events feed of new blocks. Leave empty to rely on polling.");
+    rpcLayout->addRow("Event Stream URL:", m_rpcStreamUrlEdit);
 
     m_rpcPollIntervalEdit = new QLineEdit(rpcTab);
     rpcLayout->addRow("Poll Interval (ms):", m_rpcPollIntervalEdit);
 
+    m_rpcCacheTtlEdit = new QLineEdit(rpcTab);
+    m_rpcCacheTtlEdit->setToolTip("Identical requests within this window share one response. 0 disables.");
+    rpcLayout->addRow("Response Cache (ms):", m_rpcCacheTtlEdit);
+
+    m_rpcHedgeCheck = new QCheckBox("Also ask the next endpoint when a request is slow", rpcTab);
+    rpcLayout->addRow("Hedged Requests:", m_rpcHedgeCheck);
+
+    m_rpcTimeoutEdit = new QLineEdit(rpcTab);
+    m_rpcTimeoutEdit->setToolTip("Requests still unanswered after this long are aborted.");
+    rpcLayout->addRow("Request Timeout (ms):", m_rpcTimeoutEdit);
+
     tabWidget->addTab(rpcTab, "RPC");
 
     // UI tab
@@ -152,9 +181,11 @@ void SettingsDialog::loadConfig()
     m_nodeExecutableEdit->setText(nodeConfig.executablePath);
     m_nodeNetworkEdit->setText(nodeConfig.network);
     m_nodeRpcBindEdit->setText(nodeConfig.rpcBind);
+    m_nodeStreamBindEdit->setText(nodeConfig.streamBind);
     m_nodeDataDirEdit->setText(nodeConfig.dataDir);
     m_nodeBootnodesEdit->setText(nodeConfig.bootnodes);
     m_nodeAutoStartCheck->setChecked(nodeConfig.autoStart);
+    m_nodeLogLevelCombo->setCurrentText(nodeConfig.logLevel);
 
     FarmerConfig farmerConfig = m_configManager->getFarmerConfig();
     m_farmerExecutableEdit->setText(farmerConfig.executablePath);
@@ -162,11 +193,15 @@ void SettingsDialog::loadConfig()
     m_farmerPrivkeyPathEdit->setText(farmerConfig.farmerPrivkeyPath);
     m_farmerNodeUrlEdit->setText(farmerConfig.nodeUrl);
     m_farmerAutoStartCheck->setChecked(farmerConfig.autoStart);
+    m_farmerLogLevelCombo->setCurrentText(farmerConfig.logLevel);
 
     RpcConfig rpcConfig = m_configManager->getRpcConfig();
-    m_rpcUrlEdit->setText(rpcConfig.url);
-    m_rpcFallbackUrlEdit->setText(rpcConfig.fallbackUrl);
+    m_rpcUrlsEdit->setPlainText(rpcConfig.urls.join("\n"));
+    m_rpcStreamUrlEdit->setText(rpcConfig.streamUrl);
     m_rpcPollIntervalEdit->setText(QString::number(rpcConfig.pollIntervalMs));
+    m_rpcCacheTtlEdit->setText(QString::number(rpcConfig.cacheTtlMs));
+    m_rpcHedgeCheck->setChecked(rpcConfig.hedgeRequests);
+    m_rpcTimeoutEdit->setText(QString::number(rpcConfig.requestTimeoutMs));
 
     UiConfig uiConfig = m_configManager->getUiConfig();
     m_uiThemeEdit->setText(uiConfig.theme);
@@ -180,9 +215,11 @@ void SettingsDialog::saveConfig()
     nodeConfig.executablePath = m_nodeExecutableEdit->text();
     nodeConfig.network = m_nodeNetworkEdit->text();
     nodeConfig.rpcBind = m_nodeRpcBindEdit->text();
+    nodeConfig.streamBind = m_nodeStreamBindEdit->text().trimmed();
     nodeConfig.dataDir = m_nodeDataDirEdit->text();
     nodeConfig.bootnodes = m_nodeBootnodesEdit->text();
     nodeConfig.autoStart = m_nodeAutoStartCheck->isChecked();
+    nodeConfig.logLevel = m_nodeLogLevelCombo->currentText();
     m_configManager->setNodeConfig(nodeConfig);
 
     FarmerConfig farmerConfig;
@@ -191,12 +228,20 @@ void SettingsDialog::saveConfig()
     farmerConfig.farmerPrivkeyPath = m_farmerPrivkeyPathEdit->text();
     farmerConfig.nodeUrl = m_farmerNodeUrlEdit->text();
     farmerConfig.autoStart = m_farmerAutoStartCheck->isChecked();
+    farmerConfig.logLevel = m_farmerLogLevelCombo->currentText();
     m_configManager->setFarmerConfig(farmerConfig);
 
     RpcConfig rpcConfig;
-    rpcConfig.url = m_rpcUrlEdit->text();
-    rpcConfig.fallbackUrl = m_rpcFallbackUrlEdit->text();
+    for (const QString& line : m_rpcUrlsEdit->toPlainText().split('\n')) {
+        if (!line.trimmed().isEmpty()) {
+            rpcConfig.urls.append(line.trimmed());
+        }
+    }
+    rpcConfig.streamUrl = m_rpcStreamUrlEdit->text().trimmed();
     rpcConfig.pollIntervalMs = m_rpcPollIntervalEdit->text().toInt();
+    rpcConfig.cacheTtlMs = m_rpcCacheTtlEdit->text().toInt();
+    rpcConfig.hedgeRequests = m_rpcHedgeCheck->isChecked();
+    rpcConfig.requestTimeoutMs = m_rpcTimeoutEdit->text().toInt();
     m_configManager->setRpcConfig(rpcConfig);
 
     UiConfig uiConfig;
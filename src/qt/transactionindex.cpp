@@ -0,0 +1,705 @@
+#include "transactionindex.h"
+#include "chaintablemodels.h"
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+// On disk: fixed-size transaction records in chain order, the addresses they
+// refer to one per line, and a state file naming how much of both is valid
+// along with the hashes of the newest blocks indexed
+static const char kTxFile[] = "txs.dat";
+static const char kAddressFile[] = "addresses.dat";
+static const char kStateFile[] = "state";
+static const char kStateMagic[8] = {'A', 'R', 'C', 'T', 'X', 'I', '0', '2'};
+// magic, height u64, count u64, hash count u64, then the hashes oldest first
+static const int kStateHeaderSize = 32;
+// height u64, timestamp i64, amount i64, fee i64, index u32, from u32, to u32, reserved u32, hash[32]
+static const int kRecordSize = 80;
+
+// Hashes of the newest blocks kept with the index. At startup and after an
+// endpoint change they are compared with the node's chain: the index is kept
+// up to the last block that agrees, and rebuilt if none does (a reorg deeper
+// than this, or an index built from another network or seed).
+static const int kCheckedBlocks = 100;
+static const int kPageSize = 100;
+static const int kBackfillIntervalMs = 200;
+static const qint64 kRequestRetryMs = 30000;
+// Addresses a prefix may expand to before the rest are ignored
+static const int kMaxPrefixAddresses = 64;
+
+struct TransactionIndex::Store {
+    QString dir;
+    QFile txFile;
+    QFile addressFile;
+    quint64 height = 0;
+    QVector<Hash32> recentHashes;               // Blocks height - size() up to height - 1
+
+    TransactionColumns txs;                     // Id is the position
+    QVector<Address> addresses;                 // By file reference
+    QHash<quint32, quint32> references;         // Address::id() -> file reference
+    QHash<quint32, QVector<quint32>> postings;  // File reference -> tx ids, ascending
+    QMap<QString, quint32> addressKeys;         // Lowercase address -> file reference
+    QHash<QByteArray, quint32> hashes;          // Raw hash -> tx id
+    QMap<QString, quint32> hashKeys;            // Hex hash -> tx id
+
+    bool load(const QString& path);
+    void saveState();
+    quint32 reference(const Address& address, QByteArray* newAddresses);
+    void add(const TransactionInfo& tx, quint32 from, quint32 to);
+    bool append(quint64 from, const QList<BlockInfo>& blocks, const QList<TransactionInfo>& txs);
+    void truncate(quint64 height);
+    void verify(quint64 from, const QList<BlockInfo>& blocks);
+    void candidates(const QString& needle, QVector<quint32>* singles, QVector<const QVector<quint32>*>* lists) const;
+    bool matchesText(const QString& needle, quint32 id) const;
+    void run(Query* query) const;
+    bool update(Query* query) const;
+};
+
+struct TransactionIndex::Query {
+    quint64 sequence = 0;
+    QString text;
+    QString needle;               // Trimmed and lowercase
+    TransactionFilter filter;
+    int limit = 0;
+    quint32 scanned = 0;          // Ids below this are in summary
+    TransactionSummary summary;
+    QList<TransactionInfo> txs;   // Newest first, at most limit
+};
+
+bool TransactionIndex::Store::load(const QString& path)
+{
+    if (path.isEmpty() || !QDir().mkpath(path)) {
+        return false;
+    }
+    dir = path;
+    txFile.setFileName(QDir(dir).filePath(kTxFile));
+    addressFile.setFileName(QDir(dir).filePath(kAddressFile));
+    if (!txFile.open(QIODevice::ReadWrite) || !addressFile.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    // A state file that does not parse, including one from before block hashes
+    // were kept, leaves the index empty to be rebuilt
+    quint64 savedHeight = 0;
+    quint64 savedCount = 0;
+    QFile stateFile(QDir(dir).filePath(kStateFile));
+    if (stateFile.open(QIODevice::ReadOnly)) {
+        QByteArray data = stateFile.readAll();
+        quint64 hashCount = data.size() >= kStateHeaderSize ? qFromLittleEndian<quint64>(data.constData() + 24) : 0;
+        if (data.size() >= kStateHeaderSize && std::memcmp(data.constData(), kStateMagic, sizeof(kStateMagic)) == 0 &&
+            hashCount <= static_cast<quint64>(kCheckedBlocks) &&
+            static_cast<quint64>(data.size()) == kStateHeaderSize + hashCount * 32) {
+            savedHeight = qFromLittleEndian<quint64>(data.constData() + 8);
+            savedCount = qFromLittleEndian<quint64>(data.constData() + 16);
+            for (quint64 i = 0; i < hashCount; ++i) {
+                recentHashes.append(Hash32::fromBytes(reinterpret_cast<const uint8_t*>(data.constData() + kStateHeaderSize + i * 32)));
+            }
+        }
+    }
+
+    // Line n is reference n; a line cut short by a crash is dropped
+    QByteArray addressData = addressFile.readAll();
+    QList<QByteArray> lines = addressData.split('\n');
+    lines.removeLast();
+    addressFile.resize(addressData.lastIndexOf('\n') + 1);
+    for (const QByteArray& line : lines) {
+        QString text = QString::fromLatin1(line);
+        Address address = Address::intern(text);
+        references.insert(address.id(), static_cast<quint32>(addresses.size()));
+        addressKeys.insert(text.toLower(), static_cast<quint32>(addresses.size()));
+        addresses.append(address);
+    }
+
+    // Records past the saved count were written by a run that did not finish
+    savedCount = qMin(savedCount, static_cast<quint64>(txFile.size() / kRecordSize));
+    QByteArray records = txFile.read(static_cast<qint64>(savedCount) * kRecordSize);
+    for (quint64 i = 0; i < savedCount; ++i) {
+        const char* record = records.constData() + i * kRecordSize;
+        quint32 from = qFromLittleEndian<quint32>(record + 36);
+        quint32 to = qFromLittleEndian<quint32>(record + 40);
+        if (from >= static_cast<quint32>(addresses.size()) || to >= static_cast<quint32>(addresses.size())) {
+            savedCount = i;
+            break;
+        }
+        TransactionInfo tx;
+        tx.height = qFromLittleEndian<quint64>(record);
+        tx.timestamp = qFromLittleEndian<qint64>(record + 8);
+        tx.amount = qFromLittleEndian<qint64>(record + 16);
+        tx.fee = qFromLittleEndian<qint64>(record + 24);
+        tx.index = qFromLittleEndian<quint32>(record + 32);
+        tx.from = addresses[from];
+        tx.to = addresses[to];
+        tx.hash = Hash32::fromBytes(reinterpret_cast<const uint8_t*>(record + 48));
+        add(tx, from, to);
+    }
+    txFile.resize(static_cast<qint64>(savedCount) * kRecordSize);
+    height = savedHeight;
+    if (static_cast<quint64>(recentHashes.size()) > height) {
+        truncate(0);
+    }
+    return true;
+}
+
+void TransactionIndex::Store::saveState()
+{
+    QSaveFile file(QDir(dir).filePath(kStateFile));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QByteArray data(kStateHeaderSize + recentHashes.size() * 32, Qt::Uninitialized);
+    std::memcpy(data.data(), kStateMagic, sizeof(kStateMagic));
+    qToLittleEndian<quint64>(height, data.data() + 8);
+    qToLittleEndian<quint64>(static_cast<quint64>(txs.size()), data.data() + 16);
+    qToLittleEndian<quint64>(static_cast<quint64>(recentHashes.size()), data.data() + 24);
+    for (int i = 0; i < recentHashes.size(); ++i) {
+        std::memcpy(data.data() + kStateHeaderSize + i * 32, recentHashes[i].bytes.data(), 32);
+    }
+    file.write(data);
+    file.commit();
+}
+
+quint32 TransactionIndex::Store::reference(const Address& address, QByteArray* newAddresses)
+{
+    auto known = references.constFind(address.id());
+    if (known != references.constEnd()) {
+        return *known;
+    }
+    quint32 ref = static_cast<quint32>(addresses.size());
+    QString text = address.toString();
+    references.insert(address.id(), ref);
+    addressKeys.insert(text.toLower(), ref);
+    addresses.append(address);
+    newAddresses->append(text.toLatin1());
+    newAddresses->append('\n');
+    return ref;
+}
+
+void TransactionIndex::Store::add(const TransactionInfo& tx, quint32 from, quint32 to)
+{
+    quint32 id = static_cast<quint32>(txs.size());
+    txs.append(tx);
+    postings[from].append(id);
+    if (to != from) {
+        postings[to].append(id);
+    }
+    if (!tx.hash.isNull()) {
+        hashes.insert(QByteArray(reinterpret_cast<const char*>(tx.hash.bytes.data()), 32), id);
+        hashKeys.insert(tx.hash.toHex(), id);
+    }
+}
+
+bool TransactionIndex::Store::append(quint64 from, const QList<BlockInfo>& blocks, const QList<TransactionInfo>& blockTxs)
+{
+    // Only pages that continue the index, as far as their heights run on
+    quint64 end = from;
+    for (const BlockInfo& block : blocks) {
+        if (block.height != end) {
+            break;
+        }
+        ++end;
+    }
+    if (height < from || height >= end) {
+        return false;
+    }
+
+    QByteArray records;
+    QByteArray newAddresses;
+    for (const TransactionInfo& tx : blockTxs) {
+        if (tx.height < height || tx.height >= end) {
+            continue;
+        }
+        quint32 fromRef = reference(tx.from, &newAddresses);
+        quint32 toRef = reference(tx.to, &newAddresses);
+        add(tx, fromRef, toRef);
+
+        char record[kRecordSize] = {};
+        qToLittleEndian<quint64>(tx.height, record);
+        qToLittleEndian<qint64>(tx.timestamp, record + 8);
+        qToLittleEndian<qint64>(tx.amount, record + 16);
+        qToLittleEndian<qint64>(tx.fee, record + 24);
+        qToLittleEndian<quint32>(tx.index, record + 32);
+        qToLittleEndian<quint32>(fromRef, record + 36);
+        qToLittleEndian<quint32>(toRef, record + 40);
+        std::memcpy(record + 48, tx.hash.bytes.data(), 32);
+        records.append(record, kRecordSize);
+    }
+
+    // Addresses first: a record must never name one that is not on disk
+    addressFile.seek(addressFile.size());
+    addressFile.write(newAddresses);
+    addressFile.flush();
+    txFile.seek(txFile.size());
+    txFile.write(records);
+    txFile.flush();
+    for (const BlockInfo& block : blocks) {
+        if (block.height >= height && block.height < end) {
+            recentHashes.append(block.hash);
+        }
+    }
+    if (recentHashes.size() > kCheckedBlocks) {
+        recentHashes.remove(0, recentHashes.size() - kCheckedBlocks);
+    }
+    height = end;
+    saveState();
+    return true;
+}
+
+void TransactionIndex::Store::truncate(quint64 newHeight)
+{
+    if (newHeight >= height) {
+        return;
+    }
+    quint32 first = static_cast<quint32>(std::lower_bound(txs.heights.constBegin(), txs.heights.constEnd(), newHeight) -
+                                         txs.heights.constBegin());
+    for (quint32 id = static_cast<quint32>(txs.size()); id-- > first;) {
+        // Ids grow along each posting list, so the dropped ones are at the back
+        for (const Address& address : {txs.froms[id], txs.tos[id]}) {
+            QVector<quint32>& list = postings[references.value(address.id())];
+            if (!list.isEmpty() && list.last() == id) {
+                list.removeLast();
+            }
+        }
+        if (!txs.hashes[id].isNull()) {
+            hashes.remove(QByteArray(reinterpret_cast<const char*>(txs.hashes[id].bytes.data()), 32));
+            hashKeys.remove(txs.hashes[id].toHex());
+        }
+    }
+    txs.removeLast(txs.size() - static_cast<int>(first));
+    txFile.resize(static_cast<qint64>(first) * kRecordSize);
+    quint64 dropped = qMin<quint64>(height - newHeight, static_cast<quint64>(recentHashes.size()));
+    recentHashes.resize(recentHashes.size() - static_cast<int>(dropped));
+    height = newHeight;
+    saveState();
+}
+
+// Drops what sits above the last kept hash that matches blocks, a page of the
+// node's chain starting at from; all of it when none does
+void TransactionIndex::Store::verify(quint64 from, const QList<BlockInfo>& blocks)
+{
+    quint64 first = height - static_cast<quint64>(recentHashes.size());
+    if (height == 0 || recentHashes.isEmpty() || from > first) {
+        truncate(0);
+        return;
+    }
+    quint64 agreed = 0;
+    for (const BlockInfo& block : blocks) {
+        if (block.height < first) {
+            continue;
+        }
+        if (block.height >= height || block.hash != recentHashes[static_cast<int>(block.height - first)]) {
+            break;
+        }
+        agreed = block.height + 1;
+    }
+    truncate(agreed);
+}
+
+// Ids whose text matches: each list ascending, read from the back
+void TransactionIndex::Store::candidates(const QString& needle, QVector<quint32>* singles,
+                                        QVector<const QVector<quint32>*>* lists) const
+{
+    // Position in the chain
+    int colon = needle.indexOf(':');
+    bool heightOk = false;
+    bool indexOk = false;
+    quint64 txHeight = needle.left(colon).toULongLong(&heightOk);
+    quint32 txIndex = needle.mid(colon + 1).toUInt(&indexOk);
+    if (colon > 0 && heightOk && indexOk) {
+        auto it = std::lower_bound(txs.heights.constBegin(), txs.heights.constEnd(), txHeight);
+        for (; it != txs.heights.constEnd() && *it == txHeight; ++it) {
+            quint32 id = static_cast<quint32>(it - txs.heights.constBegin());
+            if (txs.indexes[id] == txIndex) {
+                singles->append(id);
+            }
+        }
+    }
+
+    // Hashes, exact or by prefix
+    if (needle.size() == 64) {
+        Hash32 hash = Hash32::fromHex(needle);
+        auto it = hashes.constFind(QByteArray(reinterpret_cast<const char*>(hash.bytes.data()), 32));
+        if (it != hashes.constEnd()) {
+            singles->append(*it);
+        }
+    } else {
+        for (auto it = hashKeys.lowerBound(needle); it != hashKeys.constEnd() && it.key().startsWith(needle); ++it) {
+            singles->append(it.value());
+        }
+    }
+    std::sort(singles->begin(), singles->end());
+    lists->append(singles);
+
+    // Addresses by prefix, through their posting lists
+    int expanded = 0;
+    for (auto it = addressKeys.lowerBound(needle);
+         it != addressKeys.constEnd() && it.key().startsWith(needle) && expanded < kMaxPrefixAddresses; ++it, ++expanded) {
+        auto postingsIt = postings.constFind(it.value());
+        if (postingsIt != postings.constEnd()) {
+            lists->append(&*postingsIt);
+        }
+    }
+}
+
+bool TransactionIndex::Store::matchesText(const QString& needle, quint32 id) const
+{
+    if (needle.isEmpty()) {
+        return true;
+    }
+    const Hash32& hash = txs.hashes[id];
+    return txs.froms[id].toString().toLower().startsWith(needle) ||
+           txs.tos[id].toString().toLower().startsWith(needle) ||
+           (!hash.isNull() && hash.toHex().startsWith(needle)) ||
+           QString("%1:%2").arg(txs.heights[id]).arg(txs.indexes[id]) == needle;
+}
+
+// Evaluated with & rather than &&, so a loop over the columns has no branches
+static inline bool inRanges(const TransactionFilter& filter, qint64 amount, qint64 fee, qint64 timestamp)
+{
+    return (amount >= filter.minAmount) & (amount <= filter.maxAmount) &
+           (fee >= filter.minFee) & (fee <= filter.maxFee) &
+           (timestamp >= filter.fromTime) & (timestamp <= filter.toTime);
+}
+
+void TransactionIndex::Store::run(Query* query) const
+{
+    const TransactionFilter& filter = query->filter;
+    const qint64* amounts = txs.amounts.constData();
+    const qint64* fees = txs.fees.constData();
+    const qint64* timestamps = txs.timestamps.constData();
+
+    // Heights only grow with the id, so their range is a run of ids
+    quint32 lo = static_cast<quint32>(std::lower_bound(txs.heights.constBegin(), txs.heights.constEnd(), filter.minHeight) -
+                                      txs.heights.constBegin());
+    quint32 hi = static_cast<quint32>(std::upper_bound(txs.heights.constBegin(), txs.heights.constEnd(), filter.maxHeight) -
+                                      txs.heights.constBegin());
+
+    TransactionSummary summary;
+    QVector<quint32> ids;
+    if (query->needle.isEmpty()) {
+        // One pass for the totals, then newest first for the rows
+        for (quint32 id = lo; id < hi; ++id) {
+            bool keep = inRanges(filter, amounts[id], fees[id], timestamps[id]);
+            summary.count += keep;
+            summary.totalAmount += keep ? amounts[id] : 0;
+            summary.totalFee += keep ? fees[id] : 0;
+        }
+        for (quint32 id = hi; id-- > lo && ids.size() < query->limit;) {
+            if (inRanges(filter, amounts[id], fees[id], timestamps[id])) {
+                ids.append(id);
+            }
+        }
+    } else {
+        QVector<quint32> singles;
+        QVector<const QVector<quint32>*> lists;
+        candidates(query->needle, &singles, &lists);
+
+        // Merge newest first within the height range; a transaction sent
+        // between two matching addresses counts once
+        QVector<int> positions;
+        for (const QVector<quint32>* list : lists) {
+            positions.append(static_cast<int>(std::lower_bound(list->constBegin(), list->constEnd(), hi) - list->constBegin()));
+        }
+        quint32 previous = hi;
+        for (;;) {
+            int best = -1;
+            for (int i = 0; i < lists.size(); ++i) {
+                if (positions[i] > 0 && (best < 0 || (*lists[i])[positions[i] - 1] > (*lists[best])[positions[best] - 1])) {
+                    best = i;
+                }
+            }
+            if (best < 0) {
+                break;
+            }
+            quint32 id = (*lists[best])[--positions[best]];
+            if (id < lo) {
+                break;
+            }
+            if (id == previous || !inRanges(filter, amounts[id], fees[id], timestamps[id])) {
+                continue;
+            }
+            previous = id;
+            ++summary.count;
+            summary.totalAmount += amounts[id];
+            summary.totalFee += fees[id];
+            if (ids.size() < query->limit) {
+                ids.append(id);
+            }
+        }
+    }
+
+    query->txs.clear();
+    query->txs.reserve(ids.size());
+    for (quint32 id : ids) {
+        query->txs.append(txs.at(static_cast<int>(id)));
+    }
+    query->summary = summary;
+    query->scanned = static_cast<quint32>(txs.size());
+}
+
+bool TransactionIndex::Store::update(Query* query) const
+{
+    quint32 size = static_cast<quint32>(txs.size());
+    if (query->scanned > size) {
+        run(query); // Truncated beneath it
+        return true;
+    }
+    // Only the transactions indexed since the last look
+    const TransactionFilter& filter = query->filter;
+    QList<TransactionInfo> added;
+    for (quint32 id = query->scanned; id < size; ++id) {
+        if (txs.heights[id] < filter.minHeight || txs.heights[id] > filter.maxHeight ||
+            !inRanges(filter, txs.amounts[id], txs.fees[id], txs.timestamps[id]) || !matchesText(query->needle, id)) {
+            continue;
+        }
+        ++query->summary.count;
+        query->summary.totalAmount += txs.amounts[id];
+        query->summary.totalFee += txs.fees[id];
+        added.prepend(txs.at(static_cast<int>(id)));
+    }
+    query->scanned = size;
+    if (added.isEmpty()) {
+        return false;
+    }
+    query->txs = added + query->txs;
+    while (query->txs.size() > query->limit) {
+        query->txs.removeLast();
+    }
+    return true;
+}
+
+bool TransactionFilter::isEmpty() const
+{
+    TransactionFilter all;
+    return minAmount == all.minAmount && maxAmount == all.maxAmount && minFee == all.minFee && maxFee == all.maxFee &&
+           minHeight == all.minHeight && maxHeight == all.maxHeight && fromTime == all.fromTime && toTime == all.toTime;
+}
+
+TransactionIndex::TransactionIndex(ArchivasRpcClient* rpcClient, QObject *parent)
+    : QObject(parent)
+    , m_rpcClient(rpcClient)
+    , m_worker(nullptr)
+    , m_latestSearch(0)
+    , m_ready(false)
+    , m_indexedHeight(0)
+    , m_hasTip(false)
+    , m_tipHeight(0)
+    , m_verified(false)
+    , m_requestPending(false)
+    , m_requestFrom(0)
+{
+    m_worker = new QThreadPool(this);
+    m_worker->setMaxThreadCount(1);
+
+    connect(m_rpcClient, &ArchivasRpcClient::chainTipUpdated, this, &TransactionIndex::onChainTipUpdated);
+    connect(m_rpcClient, &ArchivasRpcClient::reorgDetected, this, &TransactionIndex::onReorgDetected);
+    connect(m_rpcClient, &ArchivasRpcClient::sourceChanged, this, &TransactionIndex::onSourceChanged);
+    connect(m_rpcClient, &ArchivasRpcClient::blockPageLoaded, this, &TransactionIndex::onBlockPageLoaded);
+}
+
+TransactionIndex::~TransactionIndex()
+{
+    // Tasks use the store and this object; let them finish first
+    m_worker->waitForDone();
+}
+
+void TransactionIndex::open(const QString& dir)
+{
+    if (m_store && m_store->dir == dir) {
+        return;
+    }
+    close();
+    if (dir.isEmpty()) {
+        return;
+    }
+
+    std::shared_ptr<Store> store = std::make_shared<Store>();
+    m_store = store;
+    m_worker->start([this, store, dir]() {
+        bool ok = store->load(dir);
+        quint64 height = store->height;
+        QMetaObject::invokeMethod(this, [this, store, ok, height]() {
+            if (store != m_store) {
+                return; // Closed or reopened elsewhere meanwhile
+            }
+            if (!ok) {
+                m_store.reset();
+                return;
+            }
+            m_ready = true;
+            m_verified = height == 0;
+            m_indexedHeight = height;
+            emit indexedHeightChanged(height);
+            requestNext();
+        }, Qt::QueuedConnection);
+    });
+}
+
+void TransactionIndex::close()
+{
+    bool wasReady = m_ready;
+    m_store.reset();
+    m_query.reset();
+    m_ready = false;
+    m_requestPending = false;
+    m_indexedHeight = 0;
+    if (wasReady) {
+        emit indexedHeightChanged(0);
+    }
+}
+
+void TransactionIndex::search(const QString& text, const TransactionFilter& filter, int limit)
+{
+    std::shared_ptr<Query> query = std::make_shared<Query>();
+    query->sequence = ++m_latestSearch;
+    query->text = text;
+    query->needle = text.trimmed().toLower();
+    query->filter = filter;
+    query->limit = limit;
+    m_query = query;
+
+    std::shared_ptr<Store> store = m_store;
+    if (!store) {
+        emit searchFinished(text, QList<TransactionInfo>(), TransactionSummary());
+        return;
+    }
+    m_worker->start([this, store, query]() {
+        if (query->sequence != m_latestSearch) {
+            return; // Superseded while queued
+        }
+        store->run(query.get());
+        post(query);
+    });
+}
+
+void TransactionIndex::clearSearch()
+{
+    ++m_latestSearch;
+    m_query.reset();
+}
+
+void TransactionIndex::refresh(const std::shared_ptr<Store>& store, const std::shared_ptr<Query>& query)
+{
+    if (query && query->sequence == m_latestSearch && store->update(query.get())) {
+        post(query);
+    }
+}
+
+void TransactionIndex::post(const std::shared_ptr<Query>& query)
+{
+    QString text = query->text;
+    QList<TransactionInfo> txs = query->txs;
+    TransactionSummary summary = query->summary;
+    QMetaObject::invokeMethod(this, [this, text, txs, summary, sequence = query->sequence]() {
+        if (sequence == m_latestSearch) {
+            emit searchFinished(text, txs, summary);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void TransactionIndex::setIndexedHeight(quint64 height)
+{
+    if (height != m_indexedHeight) {
+        m_indexedHeight = height;
+        emit indexedHeightChanged(height);
+    }
+}
+
+void TransactionIndex::onChainTipUpdated(const ChainTip& tip)
+{
+    // A tip with neither height nor hash did not parse
+    if (tip.height == 0 && tip.hash.isNull()) {
+        return;
+    }
+    m_hasTip = true;
+    m_tipHeight = tip.height;
+    if (m_indexedHeight > m_tipHeight + 1) {
+        truncate(m_tipHeight + 1);
+    }
+    if (m_requestPending && m_requestTimer.elapsed() > kRequestRetryMs) {
+        m_requestPending = false;
+    }
+    requestNext();
+}
+
+void TransactionIndex::onReorgDetected(quint64 fromHeight)
+{
+    if (fromHeight < m_indexedHeight) {
+        truncate(fromHeight);
+    }
+}
+
+void TransactionIndex::onSourceChanged()
+{
+    // Checked against the new servers' chain before anything more is added
+    m_hasTip = false;
+    m_verified = m_indexedHeight == 0;
+    m_requestPending = false;
+}
+
+void TransactionIndex::truncate(quint64 height)
+{
+    std::shared_ptr<Store> store = m_store;
+    if (!m_ready || !store) {
+        return;
+    }
+    std::shared_ptr<Query> query = m_query;
+    m_worker->start([this, store, query, height]() {
+        store->truncate(height);
+        refresh(store, query);
+    });
+    setIndexedHeight(qMin(m_indexedHeight, height));
+}
+
+void TransactionIndex::requestNext()
+{
+    if (!m_ready || !m_hasTip || m_requestPending || (m_verified && m_indexedHeight > m_tipHeight)) {
+        return;
+    }
+    m_requestPending = true;
+    // Unverified, start at the oldest block whose hash was kept
+    m_requestFrom = m_verified ? m_indexedHeight : m_indexedHeight - qMin<quint64>(m_indexedHeight, kCheckedBlocks);
+    m_requestTimer.start();
+    m_rpcClient->getBlockPage(m_requestFrom, kPageSize);
+}
+
+void TransactionIndex::onBlockPageLoaded(quint64 from, const QList<BlockInfo>& blocks, const QList<TransactionInfo>& txs)
+{
+    if (!m_requestPending || from != m_requestFrom) {
+        return;
+    }
+    std::shared_ptr<Store> store = m_store;
+    if (!store || blocks.isEmpty()) {
+        m_requestPending = false;
+        return; // Retried on the next chain tip
+    }
+    // Still pending until the worker has applied it, so the next request
+    // starts where this page ended
+    std::shared_ptr<Query> query = m_query;
+    bool verify = !m_verified;
+    m_worker->start([this, store, query, from, blocks, txs, verify]() {
+        if (verify) {
+            store->verify(from, blocks);
+        }
+        store->append(from, blocks, txs);
+        refresh(store, query);
+        quint64 height = store->height;
+        QMetaObject::invokeMethod(this, [this, store, height, verify]() {
+            if (store != m_store) {
+                return;
+            }
+            m_requestPending = false;
+            m_verified = m_verified || verify;
+            setIndexedHeight(height);
+            QTimer::singleShot(kBackfillIntervalMs, this, &TransactionIndex::requestNext);
+        }, Qt::QueuedConnection);
+    });
+}
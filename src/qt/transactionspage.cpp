@@ -2,31 +2,73 @@
 #include <QClipboard>
 #include <QApplication>
 #include <QHeaderView>
+#include <QCheckBox>
+#include <QDateTime>
+#include <QDateTimeEdit>
+#include <QDialog>
+#include <QMenu>
+#include <QMessageBox>
+#include <utility>
 
-TransactionsPage::TransactionsPage(ArchivasRpcClient* rpcClient, QWidget *parent)
+// Rows in the recent transactions list
+static const int kRecentTransactions = 50;
+// Mempool transactions listed above them
+static const int kMaxPending = 100;
+// A pending transaction this many blocks past its expected height has been
+// dropped or replaced rather than mined
+static const quint64 kPendingBlocks = 10;
+// Search results shown at once; the summary row gives the full count
+static const int kSearchLimit = 1000;
+// Where the time window dialog starts
+static const qint64 kDefaultWindowSeconds = 7 * 24 * 3600;
+
+// "Amount: 10 to 20", with either bound left open when empty
+static QString rangeText(const QString& name, const QString& min, const QString& max)
+{
+    if (max.isEmpty()) {
+        return QString("%1: %2 or more").arg(name, min);
+    }
+    if (min.isEmpty()) {
+        return QString("%1: up to %2").arg(name, max);
+    }
+    return QString("%1: %2 to %3").arg(name, min, max);
+}
+
+TransactionsPage::TransactionsPage(ArchivasRpcClient* rpcClient, TransactionIndex* txIndex, QWidget *parent)
     : QWidget(parent)
     , m_rpcClient(rpcClient)
-    , m_tableWidget(nullptr)
-    , m_filterEdit(nullptr)
-    , m_refreshTimer(nullptr)
+    , m_txIndex(txIndex)
+    , m_model(nullptr)
+    , m_tableView(nullptr)
+    , m_searchEdit(nullptr)
+    , m_addFilterButton(nullptr)
+    , m_chipLayout(nullptr)
+    , m_statusLabel(nullptr)
+    , m_summaryLabel(nullptr)
+    , m_searching(false)
+    , m_columnsSized(false)
 {
     setupUi();
 
     connect(m_rpcClient, &ArchivasRpcClient::transactionsUpdated, this, &TransactionsPage::onTransactionsUpdated);
+    connect(m_rpcClient, &ArchivasRpcClient::mempoolTransactionAdded, this, &TransactionsPage::onMempoolTransactionAdded);
+    connect(m_txIndex, &TransactionIndex::searchFinished, this, &TransactionsPage::onSearchFinished);
+    connect(m_txIndex, &TransactionIndex::indexedHeightChanged, this, &TransactionsPage::updateStatus);
+    updateStatus();
+}
 
-    // Auto-refresh every 10 seconds
-    m_refreshTimer = new QTimer(this);
-    connect(m_refreshTimer, &QTimer::timeout, [this]() {
-        m_rpcClient->getRecentTransactions(50);
-    });
-    m_refreshTimer->start(10000);
+TransactionsPage::~TransactionsPage()
+{
+}
 
-    // Initial load
-    m_rpcClient->getRecentTransactions(50);
+void TransactionsPage::refresh()
+{
+    m_rpcClient->getRecentTransactions(kRecentTransactions);
 }
 
-TransactionsPage::~TransactionsPage()
+void TransactionsPage::addRefreshTo(RpcBatch& batch)
 {
+    batch.recentTxs(kRecentTransactions);
 }
 
 void TransactionsPage::setupUi()
@@ -34,130 +76,418 @@ void TransactionsPage::setupUi()
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(20, 20, 20, 20);
 
-    // Filter bar
-    QHBoxLayout* filterLayout = new QHBoxLayout();
-    filterLayout->addWidget(new QLabel("Filter by Address:", this));
-    m_filterEdit = new QLineEdit(this);
-    m_filterEdit->setPlaceholderText("Enter address to filter...");
-    filterLayout->addWidget(m_filterEdit);
-    QPushButton* filterButton = new QPushButton("Filter", this);
-    connect(filterButton, &QPushButton::clicked, this, &TransactionsPage::onFilterClicked);
-    filterLayout->addWidget(filterButton);
-    filterLayout->addStretch();
-    mainLayout->addLayout(filterLayout);
+    // Search bar; every keystroke searches the whole chain
+    QHBoxLayout* searchLayout = new QHBoxLayout();
+    searchLayout->addWidget(new QLabel("Search:", this));
+    m_searchEdit = new QLineEdit(this);
+    m_searchEdit->setPlaceholderText("Address, hash or height:index...");
+    m_searchEdit->setClearButtonEnabled(true);
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &TransactionsPage::runSearch);
+    searchLayout->addWidget(m_searchEdit);
+
+    m_addFilterButton = new QPushButton("Add Filter", this);
+    QMenu* filterMenu = new QMenu(m_addFilterButton);
+    filterMenu->addAction("Amount...", this, [this]() { editFilter(AmountFilter); });
+    filterMenu->addAction("Fee...", this, [this]() { editFilter(FeeFilter); });
+    filterMenu->addAction("Height...", this, [this]() { editFilter(HeightFilter); });
+    filterMenu->addAction("Time Window...", this, [this]() { editFilter(TimeFilter); });
+    m_addFilterButton->setMenu(filterMenu);
+    searchLayout->addWidget(m_addFilterButton);
+
+    m_statusLabel = new QLabel(this);
+    searchLayout->addWidget(m_statusLabel);
+    mainLayout->addLayout(searchLayout);
+
+    // Active filters, each removed by clicking it
+    m_chipLayout = new QHBoxLayout();
+    m_chipLayout->addStretch();
+    mainLayout->addLayout(m_chipLayout);
 
     // Table
-    m_tableWidget = new QTableWidget(this);
-    m_tableWidget->setColumnCount(7);
-    m_tableWidget->setHorizontalHeaderLabels({"Hash", "From", "To", "Amount (RCHV)", "Fee (RCHV)", "Height", "Timestamp"});
-    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    m_tableWidget->horizontalHeader()->setStretchLastSection(true);
-    m_tableWidget->setAlternatingRowColors(true);
+    m_model = new TransactionTableModel(this);
+
+    m_tableView = new QTableView(this);
+    m_tableView->setModel(m_model);
+    m_tableView->setItemDelegate(new ChainItemDelegate(ChainItemDelegate::Plain, m_tableView));
+    m_tableView->setItemDelegateForColumn(TransactionTableModel::HashColumn, new ChainItemDelegate(ChainItemDelegate::Abbreviated, m_tableView));
+    m_tableView->setItemDelegateForColumn(TransactionTableModel::FromColumn, new ChainItemDelegate(ChainItemDelegate::Abbreviated, m_tableView));
+    m_tableView->setItemDelegateForColumn(TransactionTableModel::ToColumn, new ChainItemDelegate(ChainItemDelegate::Abbreviated, m_tableView));
+    m_tableView->setItemDelegateForColumn(TransactionTableModel::TimestampColumn, new ChainItemDelegate(ChainItemDelegate::Timestamp, m_tableView));
+    m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableView->horizontalHeader()->setStretchLastSection(true);
+    // Uniform rows: the view never measures them
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_tableView->setAlternatingRowColors(true);
 
-    connect(m_tableWidget, &QTableWidget::cellDoubleClicked, this, &TransactionsPage::onTableDoubleClicked);
+    connect(m_tableView, &QTableView::doubleClicked, this, &TransactionsPage::onTableDoubleClicked);
 
-    mainLayout->addWidget(m_tableWidget);
+    mainLayout->addWidget(m_tableView);
+
+    // Count and totals for everything that matches, not only the rows shown
+    m_summaryLabel = new QLabel(this);
+    m_summaryLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    mainLayout->addWidget(m_summaryLabel);
+    updateSummary();
 }
 
 void TransactionsPage::onTransactionsUpdated(const QList<TransactionInfo>& txs)
 {
-    m_allTransactions = txs;
-    updateTable(txs);
+    m_recent = txs;
+
+    quint64 newestHeight = 0;
+    for (const TransactionInfo& tx : txs) {
+        newestHeight = qMax(newestHeight, tx.height);
+    }
+    for (int i = m_pending.size() - 1; i >= 0; --i) {
+        const TransactionInfo& pending = m_pending[i];
+        if (isMined(pending) || pending.height + kPendingBlocks < newestHeight) {
+            m_pending.removeAt(i);
+        }
+    }
+
+    if (!m_searching) {
+        showTransactions(recentRows());
+        updateSummary();
+    }
 }
 
-void TransactionsPage::updateTable(const QList<TransactionInfo>& txs)
+void TransactionsPage::onMempoolTransactionAdded(const TransactionInfo& tx)
 {
-    m_tableWidget->setRowCount(txs.size());
+    // The stream can report a transaction the last poll already saw mined
+    if (isMined(tx)) {
+        return;
+    }
+    for (const TransactionInfo& pending : m_pending) {
+        if (pending.hash == tx.hash) {
+            return;
+        }
+    }
+    m_pending.prepend(tx);
+    if (m_pending.size() > kMaxPending) {
+        m_pending.removeLast();
+    }
+    if (!m_searching) {
+        showTransactions(recentRows());
+    }
+}
 
-    for (int i = 0; i < txs.size(); ++i) {
-        const TransactionInfo& tx = txs[i];
+QList<TransactionInfo> TransactionsPage::recentRows() const
+{
+    if (m_pending.isEmpty()) {
+        return m_recent;
+    }
+    return m_pending + m_recent;
+}
 
-        // Hash (truncated)
-        QString shortHash = tx.hash;
-        if (shortHash.length() > 16) {
-            shortHash = shortHash.left(8) + "..." + shortHash.right(8);
-        }
-        QTableWidgetItem* hashItem = new QTableWidgetItem(shortHash);
-        hashItem->setData(Qt::UserRole, tx.hash);
-        hashItem->setToolTip(tx.hash);
-        m_tableWidget->setItem(i, 0, hashItem);
-
-        // From (truncated)
-        QString shortFrom = tx.from;
-        if (shortFrom.length() > 16) {
-            shortFrom = shortFrom.left(8) + "..." + shortFrom.right(8);
-        }
-        QTableWidgetItem* fromItem = new QTableWidgetItem(shortFrom);
-        fromItem->setToolTip(tx.from);
-        m_tableWidget->setItem(i, 1, fromItem);
-
-        // To (truncated)
-        QString shortTo = tx.to;
-        if (shortTo.length() > 16) {
-            shortTo = shortTo.left(8) + "..." + shortTo.right(8);
+bool TransactionsPage::isMined(const TransactionInfo& pending) const
+{
+    // Pending ids are not block hashes, so match on the transfer itself
+    for (const TransactionInfo& tx : m_recent) {
+        if (tx.from == pending.from && tx.to == pending.to && tx.amount == pending.amount && tx.fee == pending.fee) {
+            return true;
         }
-        QTableWidgetItem* toItem = new QTableWidgetItem(shortTo);
-        toItem->setToolTip(tx.to);
-        m_tableWidget->setItem(i, 2, toItem);
-
-        // Amount
-        QTableWidgetItem* amountItem = new QTableWidgetItem(tx.amount);
-        m_tableWidget->setItem(i, 3, amountItem);
+    }
+    return false;
+}
 
-        // Fee
-        QTableWidgetItem* feeItem = new QTableWidgetItem(tx.fee);
-        m_tableWidget->setItem(i, 4, feeItem);
+void TransactionsPage::showTransactions(const QList<TransactionInfo>& txs)
+{
+    m_model->setTransactions(txs);
 
-        // Height
-        QTableWidgetItem* heightItem = new QTableWidgetItem(tx.height);
-        m_tableWidget->setItem(i, 5, heightItem);
+    // Abbreviated cells keep a fixed width, so the first rows are representative
+    if (!m_columnsSized && m_model->rowCount() > 0) {
+        m_tableView->resizeColumnsToContents();
+        m_columnsSized = true;
+    }
+}
 
-        // Timestamp
-        QTableWidgetItem* timestampItem = new QTableWidgetItem(tx.timestamp);
-        m_tableWidget->setItem(i, 6, timestampItem);
+void TransactionsPage::onTableDoubleClicked(const QModelIndex& index)
+{
+    if (!index.isValid()) {
+        return;
     }
 
-    m_tableWidget->resizeColumnsToContents();
+    // Copy hash to clipboard
+    QClipboard* clipboard = QApplication::clipboard();
+    clipboard->setText(m_model->displayId(index.row()));
 }
 
-void TransactionsPage::onTableDoubleClicked(int row, int column)
+void TransactionsPage::runSearch()
 {
-    Q_UNUSED(column);
-    if (row < 0 || row >= m_tableWidget->rowCount()) {
+    QString text = m_searchEdit->text();
+    if (text.trimmed().isEmpty() && m_filter.isEmpty()) {
+        m_searching = false;
+        m_txIndex->clearSearch();
+        showTransactions(recentRows());
+        updateSummary();
         return;
     }
+    m_searching = true;
+    m_txIndex->search(text, m_filter, kSearchLimit);
+}
 
-    // Copy hash to clipboard
-    QTableWidgetItem* hashItem = m_tableWidget->item(row, 0);
-    if (hashItem) {
-        QString fullHash = hashItem->data(Qt::UserRole).toString();
-        if (fullHash.isEmpty()) {
-            fullHash = hashItem->text();
+void TransactionsPage::onSearchFinished(const QString& text, const QList<TransactionInfo>& txs, const TransactionSummary& summary)
+{
+    // The user may have typed on since
+    if (!m_searching || text != m_searchEdit->text()) {
+        return;
+    }
+    m_summary = summary;
+    showTransactions(txs);
+    updateSummary();
+}
+
+void TransactionsPage::updateStatus()
+{
+    m_statusLabel->setText(m_txIndex->isReady()
+        ? QString("%1 blocks indexed").arg(m_txIndex->indexedHeight())
+        : QString("Index not loaded"));
+}
+
+void TransactionsPage::updateSummary()
+{
+    TransactionSummary summary = m_summary;
+    if (!m_searching) {
+        summary = TransactionSummary();
+        for (const TransactionInfo& tx : m_recent) {
+            ++summary.count;
+            summary.totalAmount += tx.amount;
+            summary.totalFee += tx.fee;
         }
-        QClipboard* clipboard = QApplication::clipboard();
-        clipboard->setText(fullHash);
     }
+    m_summaryLabel->setText(QString("%1 %2   Total amount: %3 RCHV   Total fees: %4 RCHV")
+        .arg(summary.count)
+        .arg(m_searching ? "matching transactions" : "recent transactions")
+        .arg(summary.totalAmount)
+        .arg(summary.totalFee));
 }
 
-void TransactionsPage::onFilterClicked()
+void TransactionsPage::editFilter(FilterKind kind)
 {
-    QString filter = m_filterEdit->text().trimmed();
-    if (filter.isEmpty()) {
-        updateTable(m_allTransactions);
+    bool accepted = false;
+    QString min;
+    QString max;
+    bool ok = true;
+    switch (kind) {
+    case AmountFilter:
+    case FeeFilter: {
+        qint64* low = kind == AmountFilter ? &m_filter.minAmount : &m_filter.minFee;
+        qint64* high = kind == AmountFilter ? &m_filter.maxAmount : &m_filter.maxFee;
+        TransactionFilter all;
+        if (*low != all.minAmount) {
+            min = QString::number(*low);
+        }
+        if (*high != all.maxAmount) {
+            max = QString::number(*high);
+        }
+        accepted = editRange(kind == AmountFilter ? "Amount Range (RCHV)" : "Fee Range (RCHV)", &min, &max);
+        if (accepted) {
+            qint64 newLow = min.isEmpty() ? all.minAmount : min.toLongLong(&ok);
+            bool highOk = true;
+            qint64 newHigh = max.isEmpty() ? all.maxAmount : max.toLongLong(&highOk);
+            ok = ok && highOk;
+            if (ok) {
+                // Bounds entered the wrong way round mean the same range
+                *low = qMin(newLow, newHigh);
+                *high = qMax(newLow, newHigh);
+            }
+        }
+        break;
+    }
+    case HeightFilter: {
+        TransactionFilter all;
+        if (m_filter.minHeight != all.minHeight) {
+            min = QString::number(m_filter.minHeight);
+        }
+        if (m_filter.maxHeight != all.maxHeight) {
+            max = QString::number(m_filter.maxHeight);
+        }
+        accepted = editRange("Height Range", &min, &max);
+        if (accepted) {
+            quint64 newLow = min.isEmpty() ? all.minHeight : min.toULongLong(&ok);
+            bool highOk = true;
+            quint64 newHigh = max.isEmpty() ? all.maxHeight : max.toULongLong(&highOk);
+            ok = ok && highOk;
+            if (ok) {
+                m_filter.minHeight = qMin(newLow, newHigh);
+                m_filter.maxHeight = qMax(newLow, newHigh);
+            }
+        }
+        break;
+    }
+    case TimeFilter:
+        accepted = editTimeWindow();
+        break;
+    }
+
+    if (!accepted) {
+        return;
+    }
+    if (!ok) {
+        QMessageBox::warning(this, "Invalid Input", "Please enter whole numbers, or leave a bound empty.");
         return;
     }
+    updateChips();
+    runSearch();
+}
 
-    QList<TransactionInfo> filtered;
-    for (const TransactionInfo& tx : m_allTransactions) {
-        if (tx.from.contains(filter, Qt::CaseInsensitive) ||
-            tx.to.contains(filter, Qt::CaseInsensitive) ||
-            tx.hash.contains(filter, Qt::CaseInsensitive)) {
-            filtered.append(tx);
-        }
+bool TransactionsPage::editRange(const QString& title, QString* min, QString* max)
+{
+    QDialog dialog(this);
+    dialog.setWindowTitle(title);
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+    QHBoxLayout* rangeLayout = new QHBoxLayout();
+    rangeLayout->addWidget(new QLabel("From:", &dialog));
+    QLineEdit* minEdit = new QLineEdit(*min, &dialog);
+    minEdit->setPlaceholderText("Any");
+    rangeLayout->addWidget(minEdit);
+    rangeLayout->addWidget(new QLabel("To:", &dialog));
+    QLineEdit* maxEdit = new QLineEdit(*max, &dialog);
+    maxEdit->setPlaceholderText("Any");
+    rangeLayout->addWidget(maxEdit);
+    layout->addLayout(rangeLayout);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    QPushButton* applyButton = new QPushButton("Apply", &dialog);
+    QPushButton* cancelButton = new QPushButton("Cancel", &dialog);
+    applyButton->setDefault(true);
+    connect(applyButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    connect(cancelButton, &QPushButton::clicked, &dialog, &QDialog::reject);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(applyButton);
+    buttonLayout->addWidget(cancelButton);
+    layout->addLayout(buttonLayout);
+
+    if (dialog.exec() != QDialog::Accepted) {
+        return false;
+    }
+    *min = minEdit->text().trimmed();
+    *max = maxEdit->text().trimmed();
+    return true;
+}
+
+bool TransactionsPage::editTimeWindow()
+{
+    TransactionFilter all;
+    qint64 now = QDateTime::currentSecsSinceEpoch();
+    qint64 from = m_filter.fromTime != all.fromTime ? m_filter.fromTime : now - kDefaultWindowSeconds;
+    qint64 to = m_filter.toTime != all.toTime ? m_filter.toTime : now;
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Time Window");
+
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+    QHBoxLayout* fromLayout = new QHBoxLayout();
+    fromLayout->addWidget(new QLabel("From:", &dialog));
+    QDateTimeEdit* fromEdit = new QDateTimeEdit(QDateTime::fromSecsSinceEpoch(from), &dialog);
+    fromEdit->setCalendarPopup(true);
+    fromLayout->addWidget(fromEdit);
+    layout->addLayout(fromLayout);
+
+    QHBoxLayout* toLayout = new QHBoxLayout();
+    toLayout->addWidget(new QLabel("To:", &dialog));
+    QDateTimeEdit* toEdit = new QDateTimeEdit(QDateTime::fromSecsSinceEpoch(to), &dialog);
+    toEdit->setCalendarPopup(true);
+    toLayout->addWidget(toEdit);
+    // An open end keeps taking in new blocks
+    QCheckBox* openEndCheck = new QCheckBox("Up to now", &dialog);
+    openEndCheck->setChecked(m_filter.toTime == all.toTime);
+    toEdit->setEnabled(!openEndCheck->isChecked());
+    connect(openEndCheck, &QCheckBox::toggled, toEdit, [toEdit](bool checked) { toEdit->setEnabled(!checked); });
+    toLayout->addWidget(openEndCheck);
+    layout->addLayout(toLayout);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    QPushButton* applyButton = new QPushButton("Apply", &dialog);
+    QPushButton* cancelButton = new QPushButton("Cancel", &dialog);
+    applyButton->setDefault(true);
+    connect(applyButton, &QPushButton::clicked, &dialog, &QDialog::accept);
+    connect(cancelButton, &QPushButton::clicked, &dialog, &QDialog::reject);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(applyButton);
+    buttonLayout->addWidget(cancelButton);
+    layout->addLayout(buttonLayout);
+
+    if (dialog.exec() != QDialog::Accepted) {
+        return false;
+    }
+    m_filter.fromTime = fromEdit->dateTime().toSecsSinceEpoch();
+    m_filter.toTime = openEndCheck->isChecked() ? all.toTime : toEdit->dateTime().toSecsSinceEpoch();
+    if (m_filter.fromTime > m_filter.toTime) {
+        std::swap(m_filter.fromTime, m_filter.toTime);
     }
+    return true;
+}
 
-    updateTable(filtered);
+void TransactionsPage::removeFilter(FilterKind kind)
+{
+    TransactionFilter all;
+    switch (kind) {
+    case AmountFilter:
+        m_filter.minAmount = all.minAmount;
+        m_filter.maxAmount = all.maxAmount;
+        break;
+    case FeeFilter:
+        m_filter.minFee = all.minFee;
+        m_filter.maxFee = all.maxFee;
+        break;
+    case HeightFilter:
+        m_filter.minHeight = all.minHeight;
+        m_filter.maxHeight = all.maxHeight;
+        break;
+    case TimeFilter:
+        m_filter.fromTime = all.fromTime;
+        m_filter.toTime = all.toTime;
+        break;
+    }
+    updateChips();
+    runSearch();
 }
 
+void TransactionsPage::updateChips()
+{
+    // Everything before the trailing stretch is a chip
+    while (m_chipLayout->count() > 1) {
+        QLayoutItem* item = m_chipLayout->takeAt(0);
+        item->widget()->deleteLater();
+        delete item;
+    }
+
+    TransactionFilter all;
+    auto bound = [](bool open, const QString& value) { return open ? QString() : value; };
+    QList<QPair<FilterKind, QString>> chips;
+    if (m_filter.minAmount != all.minAmount || m_filter.maxAmount != all.maxAmount) {
+        chips.append({AmountFilter, rangeText("Amount",
+            bound(m_filter.minAmount == all.minAmount, QString::number(m_filter.minAmount)),
+            bound(m_filter.maxAmount == all.maxAmount, QString::number(m_filter.maxAmount)))});
+    }
+    if (m_filter.minFee != all.minFee || m_filter.maxFee != all.maxFee) {
+        chips.append({FeeFilter, rangeText("Fee",
+            bound(m_filter.minFee == all.minFee, QString::number(m_filter.minFee)),
+            bound(m_filter.maxFee == all.maxFee, QString::number(m_filter.maxFee)))});
+    }
+    if (m_filter.minHeight != all.minHeight || m_filter.maxHeight != all.maxHeight) {
+        chips.append({HeightFilter, rangeText("Height",
+            bound(m_filter.minHeight == all.minHeight, QString::number(m_filter.minHeight)),
+            bound(m_filter.maxHeight == all.maxHeight, QString::number(m_filter.maxHeight)))});
+    }
+    if (m_filter.fromTime != all.fromTime || m_filter.toTime != all.toTime) {
+        QString from = formatTimestamp(m_filter.fromTime);
+        QString to = formatTimestamp(m_filter.toTime);
+        chips.append({TimeFilter, m_filter.toTime == all.toTime ? QString("Time: since %1").arg(from)
+                                : m_filter.fromTime == all.fromTime ? QString("Time: until %1").arg(to)
+                                : QString("Time: %1 to %2").arg(from, to)});
+    }
+
+    for (int i = 0; i < chips.size(); ++i) {
+        FilterKind kind = chips[i].first;
+        QPushButton* chip = new QPushButton(chips[i].second + QString(" ") + QChar(0x00D7), this);
+        chip->setToolTip("Remove this filter");
+        chip->setStyleSheet("QPushButton { border: 1px solid #999; border-radius: 10px; padding: 2px 10px; }");
+        connect(chip, &QPushButton::clicked, this, [this, kind]() { removeFilter(kind); });
+        m_chipLayout->insertWidget(i, chip);
+    }
+}
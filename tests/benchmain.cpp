@@ -0,0 +1,24 @@
+#include <QApplication>
+#include <QtTest>
+#include <memory>
+#include "benchutil.h"
+
+// Runs every registered benchmark class in turn, passing the arguments on to
+// QTest for each (e.g. -silent, -maxwarnings 0)
+int main(int argc, char *argv[])
+{
+    // The pages need a QApplication; offscreen keeps it headless in CI
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    app.setApplicationName("archivas-bench");
+
+    qInfo().noquote() << QString("Benchmark scale %1 (ARCHIVAS_BENCH_SCALE)").arg(benchScale());
+    int failed = 0;
+    for (BenchmarkFactory factory : registeredBenchmarks()) {
+        std::unique_ptr<QObject> benchmark(factory());
+        failed += QTest::qExec(benchmark.get(), argc, argv) != 0;
+    }
+    return failed;
+}
@@ -0,0 +1,447 @@
+#include "benchutil.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDeadlineTimer>
+#include <QEventLoop>
+#include <QtDebug>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+
+#if defined(Q_OS_UNIX)
+#include <time.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#include <unistd.h>
+
+// Every allocation in the process goes through these, including Qt's
+// containers (which call malloc directly) and operator new. The real
+// allocator stays glibc's; this only counts.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+static std::atomic<quint64> s_allocations{0};
+static std::atomic<qint64> s_liveBytes{0};
+static thread_local quint64 t_allocations = 0;
+
+static inline void* counted(void* ptr)
+{
+    if (ptr) {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_liveBytes.fetch_add(static_cast<qint64>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+        ++t_allocations;
+    }
+    return ptr;
+}
+
+extern "C" {
+void* malloc(size_t size)
+{
+    return counted(__libc_malloc(size));
+}
+
+void* calloc(size_t count, size_t size)
+{
+    return counted(__libc_calloc(count, size));
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    qint64 old = ptr ? static_cast<qint64>(malloc_usable_size(ptr)) : 0;
+    void* result = __libc_realloc(ptr, size);
+    if (result) {
+        s_liveBytes.fetch_sub(old, std::memory_order_relaxed);
+        counted(result);
+    } else if (size == 0) {
+        s_liveBytes.fetch_sub(old, std::memory_order_relaxed);  // Freed
+    }
+    return result;
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+    return counted(__libc_memalign(alignment, size));
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+    return counted(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size)
+{
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* ptr = counted(__libc_memalign(alignment, size));
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *result = ptr;
+    return 0;
+}
+
+void* valloc(size_t size)
+{
+    return counted(__libc_memalign(static_cast<size_t>(sysconf(_SC_PAGESIZE)), size));
+}
+
+void free(void* ptr)
+{
+    if (ptr) {
+        s_liveBytes.fetch_sub(static_cast<qint64>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+    }
+    __libc_free(ptr);
+}
+}
+
+bool AllocationCounter::supported() { return true; }
+quint64 AllocationCounter::total() { return s_allocations.load(std::memory_order_relaxed); }
+quint64 AllocationCounter::thisThread() { return t_allocations; }
+qint64 AllocationCounter::liveBytes() { return s_liveBytes.load(std::memory_order_relaxed); }
+#else
+bool AllocationCounter::supported() { return false; }
+quint64 AllocationCounter::total() { return 0; }
+quint64 AllocationCounter::thisThread() { return 0; }
+qint64 AllocationCounter::liveBytes() { return 0; }
+#endif
+
+double benchScale()
+{
+    static const double scale = []() {
+        bool ok = false;
+        double value = qEnvironmentVariable("ARCHIVAS_BENCH_SCALE").toDouble(&ok);
+        return ok && value > 0 ? value : 1.0;
+    }();
+    return scale;
+}
+
+int scaled(qint64 count, int minimum)
+{
+    return static_cast<int>(qMax<qint64>(minimum, std::llround(static_cast<double>(count) * benchScale())));
+}
+
+qint64 threadCpuNs()
+{
+#if defined(Q_OS_UNIX)
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+#endif
+    return 0;
+}
+
+void Measurement::restart()
+{
+    m_allocStart = AllocationCounter::total();
+    m_threadAllocStart = AllocationCounter::thisThread();
+    m_cpuStart = threadCpuNs();
+    m_timer.start();
+}
+
+StallProbe::StallProbe()
+    : m_lastNs(0)
+    , m_longestNs(0)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(1);
+    QObject::connect(&m_timer, &QTimer::timeout, [this]() {
+        qint64 now = m_clock.nsecsElapsed();
+        m_longestNs = qMax(m_longestNs, now - m_lastNs);
+        m_lastNs = now;
+    });
+}
+
+void StallProbe::start()
+{
+    m_longestNs = 0;
+    m_lastNs = 0;
+    m_clock.start();
+    m_timer.start();
+}
+
+void StallProbe::stop()
+{
+    m_timer.stop();
+}
+
+qint64 StallProbe::longestNs() const
+{
+    // Including the stretch since the last tick
+    return qMax(m_longestNs, m_timer.isActive() ? m_clock.nsecsElapsed() - m_lastNs : 0);
+}
+
+qint64 Samples::percentile(double p) const
+{
+    if (m_values.isEmpty()) {
+        return 0;
+    }
+    QVector<qint64> sorted = m_values;
+    std::sort(sorted.begin(), sorted.end());
+    // Nearest rank
+    int rank = static_cast<int>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[qBound(0, rank - 1, sorted.size() - 1)];
+}
+
+double Samples::mean() const
+{
+    if (m_values.isEmpty()) {
+        return 0;
+    }
+    double sum = 0;
+    for (qint64 value : m_values) {
+        sum += static_cast<double>(value);
+    }
+    return sum / m_values.size();
+}
+
+QString formatNs(qint64 ns)
+{
+    if (ns < 10000) {
+        return QString("%1 ns").arg(ns);
+    }
+    if (ns < 10000000) {
+        return QString("%1 us").arg(ns / 1000.0, 0, 'f', 1);
+    }
+    return QString("%1 ms").arg(ns / 1000000.0, 0, 'f', 1);
+}
+
+QString formatBytes(qint64 bytes)
+{
+    if (qAbs(bytes) < 10 * 1024) {
+        return QString("%1 B").arg(bytes);
+    }
+    if (qAbs(bytes) < 10 * 1024 * 1024) {
+        return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    }
+    return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+void report(const QString& name, const QString& value)
+{
+    qInfo().noquote() << QString("  %1 %2").arg(name, -44).arg(value);
+}
+
+void report(const QString& name, const Samples& samples)
+{
+    report(name, QString("p50 %1  p99 %2  max %3  (%4 samples)")
+        .arg(formatNs(samples.percentile(50)), formatNs(samples.percentile(99)), formatNs(samples.max()))
+        .arg(samples.count()));
+}
+
+void reportAllocations(const QString& name, const Samples& samples)
+{
+    if (!AllocationCounter::supported()) {
+        report(name, "not counted on this platform");
+        return;
+    }
+    report(name, QString("p50 %1  p99 %2  max %3")
+        .arg(samples.percentile(50)).arg(samples.percentile(99)).arg(samples.max()));
+}
+
+bool waitUntil(const std::function<bool()>& done, int timeoutMs)
+{
+    QDeadlineTimer deadline(timeoutMs);
+    while (!done()) {
+        if (deadline.hasExpired()) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 10);
+    }
+    return true;
+}
+
+namespace Synthetic {
+
+static QString sha256Hex(const QByteArray& seed)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(seed, QCryptographicHash::Sha256).toHex());
+}
+
+// splitmix64, so values spread well from consecutive seeds
+static quint64 mix(quint64 x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+QString farmer(quint64 height)
+{
+    return pickAddress(height, kFarmers);
+}
+
+QString blockHash(quint64 height)
+{
+    return sha256Hex("block:" + QByteArray::number(height));
+}
+
+QString txHash(quint64 height, int index)
+{
+    return sha256Hex("tx:" + QByteArray::number(height) + ":" + QByteArray::number(index));
+}
+
+QString address(quint64 n)
+{
+    // "arcv1" and 38 base32-looking characters, like a bech32 address
+    static const char kAlphabet[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+    QString text = QStringLiteral("arcv1");
+    quint64 bits = mix(n);
+    for (int i = 0; i < 38; ++i) {
+        if (i % 12 == 0) {
+            bits = mix(bits + static_cast<quint64>(i));
+        }
+        text.append(QLatin1Char(kAlphabet[bits & 31]));
+        bits >>= 5;
+    }
+    return text;
+}
+
+QString pickAddress(quint64 seed, int population)
+{
+    quint64 r = mix(seed);
+    // Half of the picks go to the busiest 1% of addresses
+    quint64 busy = qMax<quint64>(1, static_cast<quint64>(population) / 100);
+    return address((r & 1) ? (r >> 1) % busy : (r >> 1) % static_cast<quint64>(population));
+}
+
+QString sender(quint64 height, int index)
+{
+    return pickAddress((height << 20 | static_cast<quint64>(index)) * 2, kWallets);
+}
+
+QString recipient(quint64 height, int index)
+{
+    return pickAddress((height << 20 | static_cast<quint64>(index)) * 2 + 1, kWallets);
+}
+
+qint64 amount(quint64 height, int index)
+{
+    return static_cast<qint64>(mix(height * 7919 + static_cast<quint64>(index)) % 1000000000ULL) + 1;
+}
+
+qint64 fee(quint64 height, int index)
+{
+    return static_cast<qint64>(mix(height * 104729 + static_cast<quint64>(index)) % 10000ULL) + 100;
+}
+
+qint64 timestamp(quint64 height)
+{
+    return 1700000000 + static_cast<qint64>(height) * 20;
+}
+
+BlockInfo block(quint64 height, int txCount)
+{
+    BlockInfo block;
+    block.height = height;
+    block.hash = Hash32::fromHex(blockHash(height));
+    if (height > 0) {
+        block.prevHash = Hash32::fromHex(blockHash(height - 1));
+    }
+    block.farmer = Address::intern(farmer(height));
+    block.txCount = static_cast<quint32>(txCount);
+    block.timestamp = timestamp(height);
+    block.difficulty = 1000000 + height % 1000;
+    return block;
+}
+
+TransactionInfo transaction(quint64 height, int index)
+{
+    TransactionInfo tx;
+    tx.hash = Hash32::fromHex(txHash(height, index));
+    tx.index = static_cast<quint32>(index);
+    tx.from = Address::intern(sender(height, index));
+    tx.to = Address::intern(recipient(height, index));
+    tx.amount = amount(height, index);
+    tx.fee = fee(height, index);
+    tx.height = height;
+    tx.timestamp = timestamp(height);
+    return tx;
+}
+
+QByteArray recentBlocks(quint64 tip, int count)
+{
+    // Remote nodes send numbers as strings on these endpoints
+    QByteArray out;
+    out.reserve(count * 260);
+    out.append('[');
+    for (int i = 0; i < count && static_cast<quint64>(i) <= tip; ++i) {
+        quint64 height = tip - static_cast<quint64>(i);
+        if (i > 0) {
+            out.append(',');
+        }
+        out.append("{\"height\":\"").append(QByteArray::number(height))
+           .append("\",\"hash\":\"").append(blockHash(height).toLatin1())
+           .append("\",\"prevHash\":\"").append(height > 0 ? blockHash(height - 1).toLatin1() : QByteArray(64, '0'))
+           .append("\",\"farmer\":\"").append(farmer(height).toLatin1())
+           .append("\",\"txCount\":").append(QByteArray::number(static_cast<int>(mix(height) % 32)))
+           .append(",\"timestamp\":\"").append(QByteArray::number(timestamp(height)))
+           .append("\",\"difficulty\":\"").append(QByteArray::number(1000000 + height % 1000))
+           .append("\"}");
+    }
+    out.append(']');
+    return out;
+}
+
+QByteArray recentTransactions(quint64 tip, int count, int txsPerBlock)
+{
+    QByteArray out;
+    out.reserve(count * 300);
+    out.append('[');
+    if (txsPerBlock <= 0) {
+        return out.append(']');
+    }
+    quint64 height = tip;
+    int index = txsPerBlock - 1;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) {
+            out.append(',');
+        }
+        out.append("{\"hash\":\"").append(txHash(height, index).toLatin1())
+           .append("\",\"from\":\"").append(sender(height, index).toLatin1())
+           .append("\",\"to\":\"").append(recipient(height, index).toLatin1())
+           .append("\",\"amount\":\"").append(QByteArray::number(amount(height, index)))
+           .append("\",\"fee\":\"").append(QByteArray::number(fee(height, index)))
+           .append("\",\"height\":\"").append(QByteArray::number(height))
+           .append("\",\"timestamp\":\"").append(QByteArray::number(timestamp(height)))
+           .append("\"}");
+        if (--index < 0) {
+            if (height == 0) {
+                break;
+            }
+            --height;
+            index = txsPerBlock - 1;
+        }
+    }
+    out.append(']');
+    return out;
+}
+
+}
+
+static QVector<BenchmarkFactory>& benchmarks()
+{
+    static QVector<BenchmarkFactory> factories;
+    return factories;
+}
+
+int registerBenchmark(BenchmarkFactory factory)
+{
+    benchmarks().append(factory);
+    return benchmarks().size();
+}
+
+QVector<BenchmarkFactory> registeredBenchmarks()
+{
+    return benchmarks();
+}
@@ -0,0 +1,136 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+#include "chaintypes.h"
+
+// Shared pieces of the benchmark suite. Every benchmark runs offline against
+// generated data or MockRpcServer and prints its measurements with qInfo.
+
+// Sizes named by the benchmarks are multiplied by ARCHIVAS_BENCH_SCALE
+// (default 1). ctest runs the suite at a small scale as a smoke test; run the
+// binary directly for the full-size numbers.
+double benchScale();
+int scaled(qint64 count, int minimum = 1);
+
+// CPU time spent by the calling thread, in nanoseconds. On the GUI thread this
+// is how long the event loop was busy rather than waiting.
+qint64 threadCpuNs();
+
+// Heap allocations made through malloc and operator new since the process
+// started, counted on glibc by wrapping the allocator. Elsewhere supported()
+// is false and the counters stay 0.
+struct AllocationCounter
+{
+    static bool supported();
+    static quint64 total();      // All threads
+    static quint64 thisThread(); // The calling thread only
+    static qint64 liveBytes();   // Allocated and not yet freed, all threads
+};
+
+// Wall time, GUI-thread CPU time and allocations over one scope
+class Measurement
+{
+public:
+    Measurement() { restart(); }
+    void restart();
+
+    qint64 elapsedNs() const { return m_timer.nsecsElapsed(); }
+    qint64 busyNs() const { return threadCpuNs() - m_cpuStart; }
+    quint64 allocations() const { return AllocationCounter::total() - m_allocStart; }
+    quint64 threadAllocations() const { return AllocationCounter::thisThread() - m_threadAllocStart; }
+
+private:
+    QElapsedTimer m_timer;
+    qint64 m_cpuStart;
+    quint64 m_allocStart;
+    quint64 m_threadAllocStart;
+};
+
+// Longest stretch the calling thread's event loop went without getting to a
+// 1 ms timer, while started: how long the window would have been frozen
+class StallProbe
+{
+public:
+    StallProbe();
+    void start();
+    void stop();
+    qint64 longestNs() const;
+
+private:
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_lastNs;
+    qint64 m_longestNs;
+};
+
+// Samples of one quantity, reported as percentiles
+class Samples
+{
+public:
+    void add(qint64 value) { m_values.append(value); }
+    int count() const { return m_values.size(); }
+    bool isEmpty() const { return m_values.isEmpty(); }
+    qint64 percentile(double p) const;  // p in [0, 100]
+    qint64 max() const { return percentile(100); }
+    double mean() const;
+
+private:
+    QVector<qint64> m_values;
+};
+
+QString formatNs(qint64 ns);
+QString formatBytes(qint64 bytes);
+// One aligned "name  value" line in the benchmark output
+void report(const QString& name, const QString& value);
+void report(const QString& name, const Samples& samples);  // As durations in ns
+void reportAllocations(const QString& name, const Samples& samples);
+
+// Runs the event loop until done() holds, at most timeoutMs. False on timeout.
+bool waitUntil(const std::function<bool()>& done, int timeoutMs = 30000);
+
+// Synthetic chain data, the same for every run. Hashes are derived from the
+// height so any part of a chain can be produced without the rest.
+namespace Synthetic {
+QString blockHash(quint64 height);
+QString txHash(quint64 height, int index);
+const int kFarmers = 64;
+const int kWallets = 100000;
+
+// Address n, shaped like a real one
+QString address(quint64 n);
+// One of population addresses. Half of the picks go to the busiest 1%, the way
+// payouts and exchanges dominate real traffic.
+QString pickAddress(quint64 seed, int population);
+QString farmer(quint64 height);
+// Fields of transaction index within the block at height
+QString sender(quint64 height, int index);
+QString recipient(quint64 height, int index);
+qint64 amount(quint64 height, int index);
+qint64 fee(quint64 height, int index);
+qint64 timestamp(quint64 height);
+
+// The same block and transaction as parsed records
+BlockInfo block(quint64 height, int txCount);
+TransactionInfo transaction(quint64 height, int index);
+
+// Payloads in the shapes the node serves
+QByteArray recentBlocks(quint64 tip, int count);
+QByteArray recentTransactions(quint64 tip, int count, int txsPerBlock);
+}
+
+// Benchmark classes register themselves; main runs each through QTest::qExec
+using BenchmarkFactory = QObject* (*)();
+int registerBenchmark(BenchmarkFactory factory);
+QVector<BenchmarkFactory> registeredBenchmarks();
+
+#define ARCHIVAS_BENCHMARK(Class) \
+    static const int Class##Registration = registerBenchmark([]() -> QObject* { return new Class; })
+
+#endif // BENCHUTIL_H
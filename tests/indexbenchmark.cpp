@@ -0,0 +1,230 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "benchutil.h"
+#include "archivasrpcclient.h"
+#include "transactionindex.h"
+
+static const int kTxsPerBlock = 10;
+// Blocks per page fed to the index while it is built
+static const int kBuildPageBlocks = 1000;
+// As many rows as the Transactions page asks for
+static const int kSearchLimit = 1000;
+static const int kRuns = 5;
+static const qint64 kLookupTargetNs = 5 * 1000000LL;
+
+// Searches over an index of 10M transactions: lookups by hash, position and
+// address, and filtered searches, first run and kept current as blocks
+// arrive. The index is built from synthetic pages
+// handed to it as the client would, but without the backfill's pacing; its
+// files go to a temporary directory. Times run from search() to
+// searchFinished on the GUI thread, so they include the worker's queue.
+class IndexBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void filter_data();
+    void filter();
+    void update();
+    void lookup_data();
+    void lookup();
+
+private:
+    QTemporaryDir m_dir;
+    ArchivasRpcClient* m_client = nullptr;
+    TransactionIndex* m_index = nullptr;
+    quint64 m_blocks = 0;
+
+    bool feed(quint64 from, int count, QElapsedTimer* delivered = nullptr);
+    bool search(const QString& text, const TransactionFilter& filter, qint64* ns, TransactionSummary* summary);
+};
+
+// Indexes count blocks from height from, as if a /blocks/range page had come
+// in; delivered is started once the page is generated
+bool IndexBenchmark::feed(quint64 from, int count, QElapsedTimer* delivered)
+{
+    QList<BlockInfo> blocks;
+    QList<TransactionInfo> txs;
+    for (quint64 height = from; height < from + static_cast<quint64>(count); ++height) {
+        blocks.append(Synthetic::block(height, kTxsPerBlock));
+        for (int index = 0; index < kTxsPerBlock; ++index) {
+            txs.append(Synthetic::transaction(height, index));
+        }
+    }
+    if (delivered) {
+        delivered->start();
+    }
+    m_index->m_requestPending = true;
+    m_index->m_requestFrom = from;
+    m_index->onBlockPageLoaded(from, blocks, txs);
+    return waitUntil([this, from, count]() {
+        return m_index->indexedHeight() == from + static_cast<quint64>(count);
+    }, 600000);
+}
+
+bool IndexBenchmark::search(const QString& text, const TransactionFilter& filter, qint64* ns, TransactionSummary* summary)
+{
+    bool finished = false;
+    QMetaObject::Connection connection = connect(m_index, &TransactionIndex::searchFinished, this,
+        [&finished, summary](const QString&, const QList<TransactionInfo>&, const TransactionSummary& result) {
+            finished = true;
+            *summary = result;
+        });
+    QElapsedTimer timer;
+    timer.start();
+    m_index->search(text, filter, kSearchLimit);
+    bool ok = waitUntil([&finished]() { return finished; });
+    *ns = timer.nsecsElapsed();
+    disconnect(connection);
+    return ok;
+}
+
+void IndexBenchmark::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_client = new ArchivasRpcClient(this);
+    m_index = new TransactionIndex(m_client, this);
+    m_index->open(m_dir.path());
+    QVERIFY(waitUntil([this]() { return m_index->isReady(); }));
+
+    m_blocks = static_cast<quint64>(scaled(10000000, 10000)) / kTxsPerBlock;
+    Measurement measurement;
+    for (quint64 from = 0; from < m_blocks; from += kBuildPageBlocks) {
+        QVERIFY(feed(from, static_cast<int>(qMin<quint64>(kBuildPageBlocks, m_blocks - from))));
+    }
+    report("transactions indexed", QString::number(m_blocks * kTxsPerBlock));
+    report("index build, generation included", formatNs(measurement.elapsedNs()));
+}
+
+void IndexBenchmark::cleanupTestCase()
+{
+    delete m_index;
+    m_index = nullptr;
+}
+
+void IndexBenchmark::filter_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<qint64>("minAmount");
+    QTest::addColumn<qint64>("maxAmount");
+    QTest::addColumn<qint64>("minFee");
+    QTest::addColumn<qint64>("maxFee");
+    QTest::addColumn<int>("fromPercent");  // Of the chain's time span
+
+    const qint64 noMin = std::numeric_limits<qint64>::min();
+    const qint64 noMax = std::numeric_limits<qint64>::max();
+    QString busy = Synthetic::address(0);
+    QString quiet = Synthetic::address(Synthetic::kWallets / 2);
+
+    QTest::newRow("no filter") << QString() << noMin << noMax << noMin << noMax << 0;
+    QTest::newRow("amount range") << QString() << qint64(100000000) << qint64(200000000) << noMin << noMax << 0;
+    QTest::newRow("fee range") << QString() << noMin << noMax << qint64(1000) << qint64(2000) << 0;
+    QTest::newRow("time range, newest 10%") << QString() << noMin << noMax << noMin << noMax << 90;
+    QTest::newRow("all ranges") << QString() << qint64(100000000) << qint64(900000000) << qint64(1000) << qint64(9000) << 50;
+    QTest::newRow("busy address and amount range") << busy << qint64(100000000) << qint64(200000000) << noMin << noMax << 0;
+    QTest::newRow("quiet address and amount range") << quiet << qint64(100000000) << qint64(200000000) << noMin << noMax << 0;
+}
+
+void IndexBenchmark::filter()
+{
+    QFETCH(QString, text);
+    QFETCH(qint64, minAmount);
+    QFETCH(qint64, maxAmount);
+    QFETCH(qint64, minFee);
+    QFETCH(qint64, maxFee);
+    QFETCH(int, fromPercent);
+
+    TransactionFilter filter;
+    filter.minAmount = minAmount;
+    filter.maxAmount = maxAmount;
+    filter.minFee = minFee;
+    filter.maxFee = maxFee;
+    if (fromPercent > 0) {
+        filter.fromTime = Synthetic::timestamp(m_blocks * static_cast<quint64>(fromPercent) / 100);
+    }
+
+    Samples latency;
+    TransactionSummary summary;
+    for (int run = 0; run < kRuns; ++run) {
+        qint64 ns = 0;
+        QVERIFY(search(text, filter, &ns, &summary));
+        latency.add(ns);
+    }
+    QVERIFY(summary.count > 0);
+
+    report("matches", QString::number(summary.count));
+    report("search latency", latency);
+}
+
+void IndexBenchmark::update()
+{
+    // Every new transaction matches, so each block sends the search again
+    TransactionFilter filter;
+    filter.fromTime = Synthetic::timestamp(m_blocks / 2);
+    qint64 ns = 0;
+    TransactionSummary summary;
+    QVERIFY(search(QString(), filter, &ns, &summary));
+
+    QElapsedTimer delivered;
+    qint64 finishedNs = -1;
+    connect(m_index, &TransactionIndex::searchFinished, this,
+            [&delivered, &finishedNs, &summary](const QString&, const QList<TransactionInfo>&, const TransactionSummary& result) {
+                finishedNs = delivered.nsecsElapsed();
+                summary = result;
+            });
+
+    Samples latency;
+    int before = summary.count;
+    int appends = scaled(200, 20);
+    for (int i = 0; i < appends; ++i) {
+        finishedNs = -1;
+        QVERIFY(feed(m_blocks++, 1, &delivered));
+        QVERIFY(waitUntil([&finishedNs]() { return finishedNs >= 0; }));
+        latency.add(finishedNs);
+    }
+    disconnect(m_index, &TransactionIndex::searchFinished, this, nullptr);
+    m_index->clearSearch();
+    QCOMPARE(summary.count, before + appends * kTxsPerBlock);
+
+    report("update latency per block", latency);
+}
+
+void IndexBenchmark::lookup_data()
+{
+    QTest::addColumn<QString>("text");
+
+    quint64 height = m_blocks / 2;
+    QString hash = Synthetic::txHash(height, 3);
+    QString quiet = Synthetic::address(Synthetic::kWallets / 2);
+
+    QTest::newRow("hash") << hash;
+    QTest::newRow("hash prefix") << hash.left(8);
+    QTest::newRow("height:index") << QString("%1:3").arg(height);
+    QTest::newRow("busy address") << Synthetic::address(0);
+    QTest::newRow("quiet address") << quiet;
+    QTest::newRow("address prefix") << quiet.left(8);
+}
+
+void IndexBenchmark::lookup()
+{
+    QFETCH(QString, text);
+
+    Samples latency;
+    TransactionSummary summary;
+    for (int run = 0; run < kRuns; ++run) {
+        qint64 ns = 0;
+        QVERIFY(search(text, TransactionFilter(), &ns, &summary));
+        latency.add(ns);
+    }
+    QVERIFY(summary.count > 0);
+
+    report("matches", QString::number(summary.count));
+    report("lookup latency", latency);
+    report("under 5 ms at p99", latency.percentile(99) < kLookupTargetNs ? "yes" : "no");
+}
+
+ARCHIVAS_BENCHMARK(IndexBenchmark);
+
+#include "indexbenchmark.moc"
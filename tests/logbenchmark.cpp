@@ -0,0 +1,108 @@
+#include <QtTest>
+#include <thread>
+#include "benchutil.h"
+#include "archivasnodemanager.h"
+
+static const char kLogLine[] = "IBD: Received block height=1234567 hash=9f86d081884c7d65 txs=10 from 203.0.113.7:9090";
+static const QLatin1String kDroppedSuffix(" log lines dropped (log buffer full)");
+
+static ArchivasNodeManager* s_legacyManager = nullptr;
+
+// ArchivasNodeManager's log callback before the arena: each line is converted
+// and handed to the GUI thread as a queued event of its own
+static void legacyLogCallback(char* level, char* message)
+{
+    ArchivasNodeManager *manager = s_legacyManager;
+    LogRecord record;
+    record.source = LogRecord::Node;
+    record.level = QString::fromUtf8(level);
+    record.message = QString::fromUtf8(message);
+    record.timestampNs = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    QMetaObject::invokeMethod(manager, [manager, record]() {
+        emit manager->logBatch(QVector<LogRecord>{record});
+    }, Qt::QueuedConnection);
+}
+
+// Node log lines written as fast as a bridge thread can, until each one has
+// reached logBatch on the GUI thread or been counted as dropped. Through the
+// arena, appendLogRecord copies a line in and flushLogs drains up to a
+// frame's worth per wakeup; through the callback, every line costs two
+// C strings, two QString conversions and a queued event. GUI-thread CPU is
+// what delivering the lines took away from painting.
+class LogBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void throughput_data();
+    void throughput();
+};
+
+void LogBenchmark::throughput_data()
+{
+    QTest::addColumn<bool>("arena");
+
+    QTest::newRow("log arena") << true;
+    QTest::newRow("per-line callback") << false;
+}
+
+void LogBenchmark::throughput()
+{
+    QFETCH(bool, arena);
+    const qint64 lines = scaled(1000000, 10000);
+
+    ArchivasNodeManager manager;
+    manager.setLogLevel(LogRecord::Node, "DEBUG");
+    if (!arena) {
+        s_legacyManager = &manager;
+        archivas_logs_enable(0);
+        archivas_node_set_log_callback(legacyLogCallback);
+    }
+
+    qint64 delivered = 0;
+    qint64 dropped = 0;
+    qint64 batches = 0;
+    connect(&manager, &ArchivasNodeManager::logBatch, this, [&](const QVector<LogRecord> &records) {
+        ++batches;
+        for (const LogRecord &record : records) {
+            if (record.message.endsWith(kDroppedSuffix)) {
+                dropped += record.message.section(' ', 0, 0).toLongLong();
+            } else {
+                ++delivered;
+            }
+        }
+    });
+
+    Measurement measurement;
+    std::thread producer([lines]() {
+        for (qint64 i = 0; i < lines; ++i) {
+            archivas_logs_write(ARCHIVAS_LOG_SOURCE_NODE, ARCHIVAS_LOG_DEBUG, const_cast<char*>(kLogLine));
+        }
+    });
+    bool done = waitUntil([&]() { return delivered + dropped >= lines; }, 300000);
+    qint64 elapsedNs = measurement.elapsedNs();
+    qint64 busyNs = measurement.busyNs();
+    producer.join();
+
+    if (!arena) {
+        archivas_node_set_log_callback(nullptr);
+        archivas_logs_enable(1);
+        s_legacyManager = nullptr;
+    }
+    QVERIFY(done);
+
+    double seconds = elapsedNs / 1e9;
+    report("lines written", QString::number(lines));
+    report("lines delivered", QString::number(delivered));
+    report("lines dropped", QString::number(dropped));
+    report("delivered per second", QString::number(qRound64(delivered / seconds)));
+    report("logBatch signals", QString::number(batches));
+    report("GUI-thread CPU", QString("%1 (%2% of wall time)").arg(formatNs(busyNs)).arg(100.0 * busyNs / elapsedNs, 0, 'f', 1));
+    if (delivered > 0) {
+        report("GUI-thread CPU per 1k lines", formatNs(busyNs * 1000 / delivered));
+    }
+}
+
+ARCHIVAS_BENCHMARK(LogBenchmark);
+
+#include "logbenchmark.moc"
@@ -0,0 +1,452 @@
+#include "mockrpcserver.h"
+#include "benchutil.h"
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+
+// Blocks resent to a stream client that resumes, as stream.go caps them
+static const quint64 kStreamMaxBackfill = 100;
+
+static QByteArray statusText(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    default: return "Internal Server Error";
+    }
+}
+
+MockRpcServer::MockRpcServer(QObject *parent)
+    : QTcpServer(parent)
+    , m_thread(nullptr)
+    , m_port(0)
+    , m_random(1)
+    , m_tipHeight(0)
+    , m_requestCount(0)
+    , m_mempoolNonce(0)
+{
+}
+
+MockRpcServer::~MockRpcServer()
+{
+    if (!m_thread) {
+        return;
+    }
+    // Brought back to this thread, closed, so the rest of the destructor is
+    // safe here
+    QThread* home = QThread::currentThread();
+    onServerThread([this, home]() {
+        close();
+        qDeleteAll(m_connections.keys());
+        m_connections.clear();
+        m_streams.clear();
+        moveToThread(home);
+    });
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+bool MockRpcServer::start()
+{
+    if (!m_thread) {
+        m_thread = new QThread();
+        m_thread->setObjectName("MockRpcServer");
+        moveToThread(m_thread);
+        m_thread->start();
+    }
+    bool ok = false;
+    onServerThread([this, &ok]() {
+        ok = listen(QHostAddress::LocalHost, 0);
+        m_port = serverPort();
+    });
+    return ok;
+}
+
+void MockRpcServer::onServerThread(const std::function<void()>& f)
+{
+    if (QThread::currentThread() == thread()) {
+        f();
+    } else {
+        QMetaObject::invokeMethod(this, f, Qt::BlockingQueuedConnection);
+    }
+}
+
+QString MockRpcServer::url() const
+{
+    return QString("http://127.0.0.1:%1").arg(m_port);
+}
+
+void MockRpcServer::setConfig(const Config& config)
+{
+    onServerThread([this, config]() { m_config = config; });
+}
+
+void MockRpcServer::setSeed(quint32 seed)
+{
+    onServerThread([this, seed]() { m_random.seed(seed); });
+}
+
+void MockRpcServer::setTipHeight(quint64 height)
+{
+    m_tipHeight = height;
+}
+
+void MockRpcServer::appendBlocks(int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    onServerThread([this, count]() {
+        quint64 from = m_tipHeight + 1;
+        m_tipHeight += static_cast<quint64>(count);
+        for (QTcpSocket* socket : m_streams) {
+            writeBlockEvents(socket, from, m_tipHeight);
+        }
+    });
+}
+
+void MockRpcServer::announceTransaction(const QString& from, const QString& to, qint64 amount, qint64 fee)
+{
+    onServerThread([this, from, to, amount, fee]() {
+        QJsonObject tx;
+        tx["hash"] = Synthetic::txHash(m_tipHeight + 1, static_cast<int>(m_mempoolNonce));
+        tx["from"] = from;
+        tx["to"] = to;
+        tx["amount"] = amount;
+        tx["fee"] = fee;
+        tx["nonce"] = static_cast<qint64>(m_mempoolNonce++);
+        tx["height"] = static_cast<qint64>(m_tipHeight + 1);
+        tx["timestamp"] = Synthetic::timestamp(m_tipHeight + 1);
+        QByteArray data = QJsonDocument(tx).toJson(QJsonDocument::Compact);
+        for (QTcpSocket* socket : m_streams) {
+            writeEvent(socket, "tx", QByteArray(), data);
+        }
+    });
+}
+
+void MockRpcServer::setResponse(const QString& path, const QByteArray& body, int status)
+{
+    onServerThread([this, path, body, status]() { m_recorded.insert(path, Recorded{body, status}); });
+}
+
+void MockRpcServer::clearResponse(const QString& path)
+{
+    onServerThread([this, path]() { m_recorded.remove(path); });
+}
+
+void MockRpcServer::clearResponses()
+{
+    onServerThread([this]() { m_recorded.clear(); });
+}
+
+void MockRpcServer::incomingConnection(qintptr socketDescriptor)
+{
+    QTcpSocket* socket = new QTcpSocket(this);
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        delete socket;
+        return;
+    }
+    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    m_connections.insert(socket, Connection());
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+        m_connections.remove(socket);
+        m_streams.removeOne(socket);
+        socket->deleteLater();
+    });
+}
+
+void MockRpcServer::readRequests(QTcpSocket* socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+    it->buffer.append(socket->readAll());
+    // One request at a time per connection, so responses keep their order
+    // however the delays fall
+    Request request;
+    if (it->busy || !takeRequest(&*it, &request)) {
+        return;
+    }
+    ++m_requestCount;
+
+    if (request.path == "/events") {
+        openStream(socket, request);
+        return;
+    }
+
+    it->busy = true;
+    int delayMs = m_config.latencyMs;
+    if (m_config.jitterMs > 0) {
+        delayMs += m_random.bounded(m_config.jitterMs + 1);
+    }
+    QTimer::singleShot(delayMs, socket, [this, socket, request]() {
+        respond(socket, request);
+        auto it = m_connections.find(socket);
+        if (it != m_connections.end()) {
+            it->busy = false;
+            if (!it->buffer.isEmpty()) {
+                readRequests(socket);
+            }
+        }
+    });
+}
+
+bool MockRpcServer::takeRequest(Connection* connection, Request* request)
+{
+    int headerEnd = connection->buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return false;
+    }
+    QList<QByteArray> lines = connection->buffer.left(headerEnd).split('\n');
+    QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+    if (requestLine.size() < 2) {
+        connection->buffer.clear();
+        return false;
+    }
+    for (int i = 1; i < lines.size(); ++i) {
+        int colon = lines[i].indexOf(':');
+        if (colon > 0) {
+            request->headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+        }
+    }
+    int length = request->headers.value("content-length").toInt();
+    if (connection->buffer.size() < headerEnd + 4 + length) {
+        return false; // Body still arriving
+    }
+
+    QUrl url(QString::fromLatin1(requestLine[1]));
+    request->method = requestLine[0];
+    request->path = url.path();
+    for (const auto& item : QUrlQuery(url).queryItems()) {
+        request->query.insert(item.first, item.second);
+    }
+    request->body = connection->buffer.mid(headerEnd + 4, length);
+    connection->buffer.remove(0, headerEnd + 4 + length);
+    return true;
+}
+
+int MockRpcServer::limitOf(const Request& request, int fallback) const
+{
+    bool ok = false;
+    int limit = request.query.value("limit").toInt(&ok);
+    return qBound(1, ok ? limit : fallback, m_config.maxLimit);
+}
+
+void MockRpcServer::respond(QTcpSocket* socket, const Request& request)
+{
+    bool keepAlive = request.headers.value("connection").toLower() != "close";
+    const QString& path = request.path;
+
+    if (m_config.errorRate > 0 && m_random.generateDouble() < m_config.errorRate) {
+        writeResponse(socket, 500, "{\"error\":\"injected failure\"}", keepAlive);
+        emit requestServed(path, 500);
+        return;
+    }
+
+    auto recorded = m_recorded.constFind(path);
+    if (recorded != m_recorded.constEnd()) {
+        if (recorded->status == 0) {
+            socket->abort();
+        } else {
+            writeResponse(socket, recorded->status, recorded->body, keepAlive);
+        }
+        emit requestServed(path, recorded->status);
+        return;
+    }
+
+    int status = 200;
+    QByteArray body;
+    if (path == "/batch") {
+        if (request.method != "POST") {
+            status = 405;
+        } else {
+            body = batch(request.body);
+        }
+    } else if (request.method != "GET") {
+        status = 405;
+    } else if (path == "/chainTip") {
+        body = chainTip();
+    } else if (path == "/blocks/recent") {
+        body = Synthetic::recentBlocks(m_tipHeight, limitOf(request, 20));
+    } else if (path == "/blocks/range") {
+        body = blockRange(request.query.value("from").toULongLong(), limitOf(request, 100));
+    } else if (path == "/tx/recent") {
+        body = Synthetic::recentTransactions(m_tipHeight, limitOf(request, 50), m_config.txsPerBlock);
+    } else if (path.startsWith("/account/")) {
+        body = account(path.mid(9));
+    } else {
+        status = 404;
+    }
+    if (status != 200) {
+        body = "{\"error\":\"" + statusText(status) + "\"}";
+    }
+    writeResponse(socket, status, body, keepAlive);
+    emit requestServed(path, status);
+}
+
+void MockRpcServer::writeResponse(QTcpSocket* socket, int status, const QByteArray& body, bool keepAlive)
+{
+    QByteArray head = "HTTP/1.1 " + QByteArray::number(status) + " " + statusText(status) + "\r\n"
+                      "Content-Type: application/json\r\n"
+                      "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    head += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    socket->write(head);
+    socket->write(body);
+    if (!keepAlive) {
+        socket->disconnectFromHost();
+    }
+}
+
+void MockRpcServer::openStream(QTcpSocket* socket, const Request& request)
+{
+    socket->write("HTTP/1.1 200 OK\r\n"
+                  "Content-Type: text/event-stream\r\n"
+                  "Cache-Control: no-cache\r\n"
+                  "Connection: keep-alive\r\n\r\n");
+    m_streams.append(socket);
+
+    // Resume after the block the client names, as stream.go does
+    bool resume = false;
+    quint64 last = request.headers.value("last-event-id").toULongLong(&resume);
+    if (!resume) {
+        quint64 from = request.query.value("from").toULongLong(&resume);
+        resume = resume && from > 0;
+        last = from - 1;
+    }
+    if (resume && last < m_tipHeight) {
+        quint64 from = qMax(last + 1, m_tipHeight >= kStreamMaxBackfill ? m_tipHeight - kStreamMaxBackfill + 1 : 0);
+        writeBlockEvents(socket, from, m_tipHeight);
+    } else {
+        writeEvent(socket, "tip", QByteArray::number(m_tipHeight), chainTip());
+    }
+}
+
+void MockRpcServer::writeEvent(QTcpSocket* socket, const QByteArray& event, const QByteArray& id, const QByteArray& data)
+{
+    QByteArray out = "event: " + event + "\n";
+    if (!id.isEmpty()) {
+        out += "id: " + id + "\n";
+    }
+    out += "data: " + data + "\n\n";
+    socket->write(out);
+}
+
+void MockRpcServer::writeBlockEvents(QTcpSocket* socket, quint64 from, quint64 to)
+{
+    for (quint64 height = from; height <= to; ++height) {
+        writeEvent(socket, "block", QByteArray::number(height), blockSummary(height));
+    }
+    writeEvent(socket, "tip", QByteArray::number(to), chainTip());
+}
+
+QByteArray MockRpcServer::chainTip() const
+{
+    return "{\"height\":\"" + QByteArray::number(m_tipHeight) +
+           "\",\"hash\":\"" + Synthetic::blockHash(m_tipHeight).toLatin1() +
+           "\",\"difficulty\":\"" + QByteArray::number(1000000 + m_tipHeight % 1000) +
+           "\",\"timestamp\":\"" + QByteArray::number(Synthetic::timestamp(m_tipHeight)) + "\"}";
+}
+
+// Numeric fields, as stream.go's blockSummary sends them
+QByteArray MockRpcServer::blockSummary(quint64 height) const
+{
+    QJsonObject block;
+    block["height"] = static_cast<qint64>(height);
+    block["hash"] = Synthetic::blockHash(height);
+    block["prevHash"] = height > 0 ? Synthetic::blockHash(height - 1) : QString(64, '0');
+    block["farmer"] = Synthetic::farmer(height);
+    block["txCount"] = m_config.txsPerBlock;
+    block["timestamp"] = Synthetic::timestamp(height);
+    block["difficulty"] = static_cast<qint64>(1000000 + height % 1000);
+    return QJsonDocument(block).toJson(QJsonDocument::Compact);
+}
+
+// Whole blocks with their transactions, as node.go's OnBlocksRangeRequest
+// encodes them
+QByteArray MockRpcServer::blockRange(quint64 from, int limit) const
+{
+    QByteArray out = "{\"blocks\":[";
+    for (quint64 height = from; height <= m_tipHeight && height < from + static_cast<quint64>(limit); ++height) {
+        if (height > from) {
+            out.append(',');
+        }
+        out.append("{\"height\":").append(QByteArray::number(height))
+           .append(",\"hash\":\"").append(Synthetic::blockHash(height).toLatin1())
+           .append("\",\"prevHash\":\"").append(height > 0 ? Synthetic::blockHash(height - 1).toLatin1() : QByteArray(64, '0'))
+           .append("\",\"farmerAddr\":\"").append(Synthetic::farmer(height).toLatin1())
+           .append("\",\"timestamp\":").append(QByteArray::number(Synthetic::timestamp(height)))
+           .append(",\"difficulty\":").append(QByteArray::number(1000000 + height % 1000))
+           .append(",\"txs\":[");
+        for (int i = 0; i < m_config.txsPerBlock; ++i) {
+            if (i > 0) {
+                out.append(',');
+            }
+            out.append("{\"from\":\"").append(Synthetic::sender(height, i).toLatin1())
+               .append("\",\"to\":\"").append(Synthetic::recipient(height, i).toLatin1())
+               .append("\",\"amount\":").append(QByteArray::number(Synthetic::amount(height, i)))
+               .append(",\"fee\":").append(QByteArray::number(Synthetic::fee(height, i)))
+               .append('}');
+        }
+        out.append("]}");
+    }
+    out.append("]}");
+    return out;
+}
+
+QByteArray MockRpcServer::account(const QString& address) const
+{
+    QJsonObject obj;
+    obj["address"] = address;
+    quint64 seed = qHash(address);
+    obj["balance"] = QString::number(seed % 1000000 * 1000);
+    obj["nonce"] = QString::number(seed % 100);
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+QByteArray MockRpcServer::batch(const QByteArray& body) const
+{
+    QJsonObject request = QJsonDocument::fromJson(body).object();
+    QByteArray out = "{";
+    auto member = [&out](const char* name, const QByteArray& value) {
+        if (out.size() > 1) {
+            out.append(',');
+        }
+        out.append('"').append(name).append("\":").append(value);
+    };
+    if (request.value("chainTip").toBool()) {
+        member("chainTip", chainTip());
+    }
+    int blocks = qMin(request.value("recentBlocks").toInt(), m_config.maxLimit);
+    if (blocks > 0) {
+        member("recentBlocks", Synthetic::recentBlocks(m_tipHeight, blocks));
+    }
+    int txs = qMin(request.value("recentTxs").toInt(), m_config.maxLimit);
+    if (txs > 0) {
+        member("recentTxs", Synthetic::recentTransactions(m_tipHeight, txs, m_config.txsPerBlock));
+    }
+    QJsonArray addresses = request.value("accounts").toArray();
+    if (!addresses.isEmpty()) {
+        QByteArray list = "[";
+        for (int i = 0; i < addresses.size(); ++i) {
+            if (i > 0) {
+                list.append(',');
+            }
+            list.append(account(addresses[i].toString()));
+        }
+        list.append(']');
+        member("accounts", list);
+    }
+    out.append('}');
+    return out;
+}
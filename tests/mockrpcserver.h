@@ -0,0 +1,125 @@
+#ifndef MOCKRPCSERVER_H
+#define MOCKRPCSERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QRandomGenerator>
+#include <QString>
+#include <QTcpServer>
+#include <atomic>
+#include <functional>
+
+class QThread;
+class QTcpSocket;
+
+// Stand-in for a node's RPC server and the embedded node's GUI service, on
+// 127.0.0.1, for benchmarks that must run offline. It serves a synthetic
+// chain (see Synthetic in benchutil.h) of any height without holding it in
+// memory:
+//
+//   GET  /chainTip, /blocks/recent?limit=, /blocks/range?from=&limit=,
+//        /tx/recent?limit=, /account/<address>
+//   GET  /events       Server-Sent Events, as stream.go sends them
+//   POST /batch        as batch.go answers it
+//
+// Responses are delayed by a configurable latency and jitter, a share of
+// requests fails with 500, and recorded bodies can replace generated ones
+// (see ReplayHarness). The server runs on its own thread, so serving does not
+// count towards the GUI thread being measured; its methods may be called from
+// any thread.
+class MockRpcServer : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    struct Config {
+        int latencyMs = 0;        // Before every response
+        int jitterMs = 0;         // Uniform extra delay, up to this
+        double errorRate = 0;     // Share of requests answered with 500
+        int txsPerBlock = 10;     // Payload size; applies to the whole chain
+        int maxLimit = 100000;    // Largest limit a list endpoint honours
+    };
+
+    explicit MockRpcServer(QObject *parent = nullptr);
+    ~MockRpcServer();
+
+    // Starts the server thread and listens on a free local port
+    bool start();
+    QString url() const;
+    QString streamUrl() const { return url() + "/events"; }
+
+    void setConfig(const Config& config);
+    // Seeds latency, jitter and errors, so runs are repeatable
+    void setSeed(quint32 seed);
+
+    quint64 tipHeight() const { return m_tipHeight; }
+    void setTipHeight(quint64 height);
+    // Extends the chain and sends the new blocks and tip to stream clients
+    void appendBlocks(int count = 1);
+    // Sends a mempool transaction to stream clients
+    void announceTransaction(const QString& from, const QString& to, qint64 amount, qint64 fee);
+
+    // body is served for path (without the query) instead of generated data,
+    // until cleared. status 0 drops the connection instead of answering.
+    void setResponse(const QString& path, const QByteArray& body, int status = 200);
+    void clearResponse(const QString& path);
+    void clearResponses();
+
+    quint64 requestCount() const { return m_requestCount; }
+    int streamClientCount() const { return m_streams.size(); }
+
+signals:
+    // After the response to path was written
+    void requestServed(const QString& path, int status);
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;  // A response is pending; later requests wait
+    };
+    struct Request {
+        QByteArray method;
+        QString path;
+        QHash<QString, QString> query;
+        QHash<QByteArray, QByteArray> headers;  // Lowercase names
+        QByteArray body;
+    };
+    struct Recorded {
+        QByteArray body;
+        int status = 200;
+    };
+
+    QThread* m_thread;
+    quint16 m_port;
+    Config m_config;
+    QRandomGenerator m_random;
+    std::atomic<quint64> m_tipHeight;
+    std::atomic<quint64> m_requestCount;
+    quint64 m_mempoolNonce;
+    QHash<QTcpSocket*, Connection> m_connections;
+    QList<QTcpSocket*> m_streams;
+    QHash<QString, Recorded> m_recorded;
+
+    // Runs f on the server thread and waits for it
+    void onServerThread(const std::function<void()>& f);
+    void readRequests(QTcpSocket* socket);
+    bool takeRequest(Connection* connection, Request* request);
+    void respond(QTcpSocket* socket, const Request& request);
+    void writeResponse(QTcpSocket* socket, int status, const QByteArray& body, bool keepAlive);
+    void openStream(QTcpSocket* socket, const Request& request);
+    void writeEvent(QTcpSocket* socket, const QByteArray& event, const QByteArray& id, const QByteArray& data);
+    void writeBlockEvents(QTcpSocket* socket, quint64 from, quint64 to);
+
+    QByteArray chainTip() const;
+    QByteArray blockSummary(quint64 height) const;
+    QByteArray blockRange(quint64 from, int limit) const;
+    QByteArray account(const QString& address) const;
+    QByteArray batch(const QByteArray& body) const;
+    int limitOf(const Request& request, int fallback) const;
+};
+
+#endif // MOCKRPCSERVER_H
@@ -0,0 +1,123 @@
+#include <QtTest>
+#include "benchutil.h"
+#include "mockrpcserver.h"
+#include "archivasrpcclient.h"
+
+static const quint64 kTipHeight = 200000;
+
+// GUI-thread cost of decoding large replies in the two designs: inline, as
+// onReplyFinished used to parse every reply on the GUI thread, and on the
+// client's parse pool, where the GUI thread only reads the reply and takes the
+// typed result. Both see the same payloads: 10k recent blocks and 100k recent
+// transactions. The inline numbers are the parse alone; the pool numbers are
+// the whole request, network handling included, so they are an upper bound.
+class ParseBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void parse_data();
+    void parse();
+
+private:
+    MockRpcServer m_server;
+    QByteArray m_blocks;
+    QByteArray m_txs;
+    int m_blockCount = 0;
+    int m_txCount = 0;
+};
+
+void ParseBenchmark::initTestCase()
+{
+    m_blockCount = scaled(10000);
+    m_txCount = scaled(100000);
+    m_blocks = Synthetic::recentBlocks(kTipHeight, m_blockCount);
+    m_txs = Synthetic::recentTransactions(kTipHeight, m_txCount, 10);
+
+    QVERIFY(m_server.start());
+    m_server.setTipHeight(kTipHeight);
+    // Served as they are, so both designs parse the same bytes
+    m_server.setResponse("/blocks/recent", m_blocks);
+    m_server.setResponse("/tx/recent", m_txs);
+
+    report("blocks payload", QString("%1 blocks, %2").arg(m_blockCount).arg(formatBytes(m_blocks.size())));
+    report("transactions payload", QString("%1 transactions, %2").arg(m_txCount).arg(formatBytes(m_txs.size())));
+}
+
+void ParseBenchmark::parse_data()
+{
+    QTest::addColumn<bool>("transactions");
+    QTest::addColumn<bool>("pool");
+
+    QTest::newRow("blocks, inline") << false << false;
+    QTest::newRow("blocks, parse pool") << false << true;
+    QTest::newRow("transactions, inline") << true << false;
+    QTest::newRow("transactions, parse pool") << true << true;
+}
+
+void ParseBenchmark::parse()
+{
+    QFETCH(bool, transactions);
+    QFETCH(bool, pool);
+
+    const int runs = 5;
+    int expected = transactions ? m_txCount : m_blockCount;
+    Samples wall;
+    Samples busy;
+    Samples stall;
+
+    if (!pool) {
+        const QByteArray& data = transactions ? m_txs : m_blocks;
+        for (int run = 0; run < runs; ++run) {
+            Measurement measurement;
+            QJsonDocument doc = QJsonDocument::fromJson(data);
+            ArchivasRpcClient::ParsedReply parsed = transactions
+                ? ArchivasRpcClient::parseTransactionsReply(doc)
+                : ArchivasRpcClient::parseBlocksReply(doc);
+            // All of it happens in one event, so it is one stall
+            wall.add(measurement.elapsedNs());
+            busy.add(measurement.busyNs());
+            stall.add(measurement.busyNs());
+            QCOMPARE(static_cast<int>(transactions ? parsed.txs.size() : parsed.blocks.size()), expected);
+        }
+    } else {
+        ArchivasRpcClient client;
+        client.setEndpoints({m_server.url()});
+        client.setCacheTtl(0);
+        client.setRequestTimeout(60000);
+        int received = 0;
+        connect(&client, &ArchivasRpcClient::blocksUpdated, this, [&received](const QList<BlockInfo>& blocks) {
+            received = blocks.size();
+        });
+        connect(&client, &ArchivasRpcClient::transactionsUpdated, this, [&received](const QList<TransactionInfo>& txs) {
+            received = txs.size();
+        });
+
+        StallProbe probe;
+        for (int run = 0; run < runs; ++run) {
+            received = 0;
+            probe.start();
+            Measurement measurement;
+            if (transactions) {
+                client.getRecentTransactions(expected);
+            } else {
+                client.getRecentBlocks(expected);
+            }
+            QVERIFY(waitUntil([&received]() { return received > 0; }, 120000));
+            wall.add(measurement.elapsedNs());
+            busy.add(measurement.busyNs());
+            stall.add(probe.longestNs());
+            probe.stop();
+            QCOMPARE(received, expected);
+        }
+    }
+
+    report("wall time", wall);
+    report("GUI thread busy", busy);
+    report("longest GUI thread stall", stall);
+}
+
+ARCHIVAS_BENCHMARK(ParseBenchmark);
+
+#include "parsebenchmark.moc"
@@ -0,0 +1,176 @@
+#include <QtTest>
+#include <QTableView>
+#include "benchutil.h"
+#include "mockrpcserver.h"
+#include "replayharness.h"
+#include "archivasrpcclient.h"
+#include "blockheadercache.h"
+#include "blockspage.h"
+#include "transactionindex.h"
+#include "transactionspage.h"
+
+// A refresh that gets no answer is sent again after this, as the scheduler's
+// next tick would
+static const qint64 kResendNs = 500 * 1000000LL;
+static const int kRefreshTimeoutMs = 15000;
+
+// Refresh latency through the whole client-to-page pipeline. The mock node
+// gains a block, the refresh MainWindow sends on each tip poll goes out (one
+// batch with the tip and recent transactions; the followed tip then fetches
+// the new block), and the clock stops once the Blocks page shows the block
+// and the Transactions page has the new list. Set ARCHIVAS_BENCH_SESSION to a
+// ReplayHarness session file to time recorded traffic instead of one block
+// per refresh; it should leave /chainTip and /blocks/range generated, since
+// those decide when a refresh is shown.
+class PipelineBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void refreshLatency_data();
+    void refreshLatency();
+};
+
+void PipelineBenchmark::refreshLatency_data()
+{
+    QTest::addColumn<int>("latencyMs");
+    QTest::addColumn<int>("jitterMs");
+    QTest::addColumn<double>("errorRate");
+    QTest::addColumn<int>("txsPerBlock");
+
+    QTest::newRow("loopback") << 0 << 0 << 0.0 << 10;
+    QTest::newRow("lan") << 2 << 3 << 0.0 << 10;
+    QTest::newRow("wan, 2% errors") << 40 << 30 << 0.02 << 10;
+    QTest::newRow("loopback, 1000 tx per block") << 0 << 0 << 0.0 << 1000;
+}
+
+void PipelineBenchmark::refreshLatency()
+{
+    QFETCH(int, latencyMs);
+    QFETCH(int, jitterMs);
+    QFETCH(double, errorRate);
+    QFETCH(int, txsPerBlock);
+
+    MockRpcServer server;
+    QVERIFY(server.start());
+    MockRpcServer::Config config;
+    config.latencyMs = latencyMs;
+    config.jitterMs = jitterMs;
+    config.errorRate = errorRate;
+    config.txsPerBlock = txsPerBlock;
+    server.setConfig(config);
+    server.setTipHeight(10000);
+
+    ArchivasRpcClient client;
+    client.setEndpoints({server.url()});
+    client.setCacheTtl(0);
+    client.setRequestTimeout(5000);
+
+    BlockHeaderCache headerCache(&client);
+    TransactionIndex txIndex(&client);
+    BlocksPage blocksPage(&client, &headerCache);
+    TransactionsPage transactionsPage(&client, &txIndex);
+    blocksPage.resize(1000, 700);
+    transactionsPage.resize(1000, 700);
+    blocksPage.show();
+    transactionsPage.show();
+    QAbstractItemModel* blocks = blocksPage.findChild<QTableView*>()->model();
+    QAbstractItemModel* txs = transactionsPage.findChild<QTableView*>()->model();
+
+    auto refresh = [&client, &transactionsPage]() {
+        RpcBatch batch = client.batch().chainTip();
+        transactionsPage.addRefreshTo(batch);
+        return batch.send();
+    };
+    auto blockShown = [blocks](quint64 height) {
+        return blocks->rowCount() > 0 &&
+               blocks->index(0, BlockHistoryModel::HeightColumn).data().toULongLong() == height &&
+               !blocks->index(0, BlockHistoryModel::HashColumn).data().isNull();
+    };
+
+    // Refreshes until height is on the pages, sending again whenever one
+    // finished without getting it there
+    int resent = 0;
+    auto refreshUntilShown = [&](quint64 height) {
+        QElapsedTimer sinceSent;
+        sinceSent.start();
+        QFuture<RpcBatchResult> pending = refresh();
+        return waitUntil([&]() {
+            if (!pending.isFinished()) {
+                return false;
+            }
+            if (blockShown(height)) {
+                return true;
+            }
+            if (sinceSent.nsecsElapsed() > kResendNs) {
+                pending = refresh();
+                sinceSent.start();
+                ++resent;
+            }
+            return false;
+        }, kRefreshTimeoutMs);
+    };
+    QVERIFY(refreshUntilShown(server.tipHeight()));
+    resent = 0;
+
+    ReplayHarness harness(&server);
+    QString session = qEnvironmentVariable("ARCHIVAS_BENCH_SESSION");
+    bool replaying = !session.isEmpty();
+    if (replaying) {
+        QVERIFY2(harness.load(session), qPrintable(harness.errorString()));
+    } else {
+        harness.setSteps(ReplayHarness::generated(scaled(200, 5), 0));
+    }
+
+    Samples latency;
+    Samples busy;
+    Samples allocations;
+    Samples mainAllocations;
+    int timedOut = 0;
+    RpcStats before = client.stats();
+
+    // Recorded sessions keep their own timing; generated ones step as soon as
+    // the previous refresh is shown
+    int step = 0;
+    if (replaying) {
+        harness.play();
+    }
+    for (; step < harness.stepCount(); ++step) {
+        if (replaying) {
+            QVERIFY(waitUntil([&]() { return harness.appliedAtNs(step) >= 0; }, 600000));
+        } else {
+            harness.stepNow();
+        }
+        quint64 height = server.tipHeight();
+
+        Measurement measurement;
+        if (!refreshUntilShown(height)) {
+            ++timedOut;
+            continue;
+        }
+        latency.add(replaying ? harness.elapsedNs() - harness.appliedAtNs(step) : measurement.elapsedNs());
+        busy.add(measurement.busyNs());
+        allocations.add(static_cast<qint64>(measurement.allocations()));
+        mainAllocations.add(static_cast<qint64>(measurement.threadAllocations()));
+    }
+    harness.stop();
+
+    // With injected errors the last list may be one that failed
+    if (!replaying && errorRate == 0) {
+        QCOMPARE(txs->index(0, TransactionTableModel::HeightColumn).data().toULongLong(), server.tipHeight());
+    }
+    QVERIFY2(timedOut < qMax(1, harness.stepCount() / 10), "Too many refreshes never reached the pages");
+
+    RpcStats after = client.stats();
+    report("refresh latency", latency);
+    report("GUI thread busy per refresh", busy);
+    reportAllocations("allocations per refresh, all threads", allocations);
+    reportAllocations("allocations per refresh, GUI thread", mainAllocations);
+    report("HTTP requests per refresh",
+           QString::number(static_cast<double>(after.issued - before.issued) / qMax(1, latency.count()), 'f', 2));
+    report("refreshes resent / timed out", QString("%1 / %2").arg(resent).arg(timedOut));
+}
+
+ARCHIVAS_BENCHMARK(PipelineBenchmark);
+
+#include "pipelinebenchmark.moc"
@@ -0,0 +1,119 @@
+#include <QtTest>
+#include <QJsonArray>
+#include "benchutil.h"
+#include "archivasrpcclient.h"
+#include "chaintablemodels.h"
+
+// Transactions in one payload; a million are generated and parsed in chunks,
+// so only the records outlive their JSON
+static const int kChunk = 10000;
+static const int kTxsPerBlock = 10;
+
+// TransactionInfo as it was before the typed records: every field a QString,
+// hashes and addresses in hex
+struct LegacyTransactionInfo {
+    QString hash;
+    QString from;
+    QString to;
+    QString amount;
+    QString fee;
+    QString height;
+    QString timestamp;
+};
+
+static QList<LegacyTransactionInfo> legacyParseTransactions(const QJsonArray& jsonArray)
+{
+    QList<LegacyTransactionInfo> txs;
+    for (const QJsonValue& value : jsonArray) {
+        if (value.isObject()) {
+            QJsonObject obj = value.toObject();
+            LegacyTransactionInfo tx;
+            tx.hash = obj.value("hash").toString();
+            tx.from = obj.value("from").toString();
+            tx.to = obj.value("to").toString();
+            tx.amount = obj.value("amount").toString();
+            tx.fee = obj.value("fee").toString();
+            tx.height = obj.value("height").toString();
+            tx.timestamp = obj.value("timestamp").toString();
+            txs.append(tx);
+        }
+    }
+    return txs;
+}
+
+// Heap held per transaction and parse time for a million of them, with the
+// all-QString records the client used to build and with TransactionInfo
+// (numbers, Hash32 and interned addresses). TransactionColumns, the layout
+// the index and the tables keep, is measured alongside. The typed figures
+// include the shared address table, which only grows with distinct addresses.
+class RecordBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void records_data();
+    void records();
+};
+
+void RecordBenchmark::records_data()
+{
+    QTest::addColumn<int>("layout");
+
+    QTest::newRow("QString fields (before)") << 0;
+    QTest::newRow("TransactionInfo (after)") << 1;
+    QTest::newRow("TransactionColumns") << 2;
+}
+
+void RecordBenchmark::records()
+{
+    QFETCH(int, layout);
+
+    int total = scaled(1000000, kChunk);
+    quint64 tip = static_cast<quint64>(total / kTxsPerBlock) + 1000;
+
+    QList<LegacyTransactionInfo> legacy;
+    QList<TransactionInfo> typed;
+    TransactionColumns columns;
+    qint64 parseNs = 0;
+    quint64 allocations = 0;
+
+    qint64 liveBefore = AllocationCounter::liveBytes();
+    for (int done = 0; done < total; done += kChunk) {
+        quint64 chunkTip = tip - static_cast<quint64>(done / kTxsPerBlock);
+        QJsonArray array = QJsonDocument::fromJson(
+            Synthetic::recentTransactions(chunkTip, qMin(kChunk, total - done), kTxsPerBlock)).array();
+        Measurement measurement;
+        if (layout == 0) {
+            legacy.append(legacyParseTransactions(array));
+        } else {
+            QList<TransactionInfo> txs = ArchivasRpcClient::parseTransactions(array);
+            if (layout == 1) {
+                typed.append(txs);
+            } else {
+                for (const TransactionInfo& tx : txs) {
+                    columns.append(tx);
+                }
+            }
+        }
+        parseNs += measurement.elapsedNs();
+        allocations += measurement.allocations();
+    }
+    qint64 held = AllocationCounter::liveBytes() - liveBefore;
+    int count = layout == 0 ? static_cast<int>(legacy.size())
+              : layout == 1 ? static_cast<int>(typed.size()) : columns.size();
+    QCOMPARE(count, total);
+
+    report("parse time per transaction", formatNs(parseNs / count));
+    report("parse time, all", formatNs(parseNs));
+    if (AllocationCounter::supported()) {
+        report("heap held per transaction", formatBytes(held / count));
+        report("heap held, all", formatBytes(held));
+        report("allocations per transaction", QString::number(static_cast<double>(allocations) / count, 'f', 2));
+    } else {
+        report("heap held", "not counted on this platform");
+    }
+}
+
+ARCHIVAS_BENCHMARK(RecordBenchmark);
+
+#include "recordbenchmark.moc"
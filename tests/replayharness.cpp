@@ -0,0 +1,135 @@
+#include "replayharness.h"
+#include "mockrpcserver.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+ReplayHarness::ReplayHarness(MockRpcServer* server, QObject *parent)
+    : QObject(parent)
+    , m_server(server)
+    , m_next(0)
+    , m_playing(false)
+    , m_generation(0)
+{
+    m_clock.start();
+}
+
+bool ReplayHarness::load(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_error = file.errorString();
+        return false;
+    }
+
+    QList<Step> steps;
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            m_error = QString("%1:%2: %3").arg(fileName).arg(lineNumber).arg(parseError.errorString());
+            return false;
+        }
+        QJsonObject obj = doc.object();
+        Step step;
+        step.atMs = static_cast<qint64>(obj.value("atMs").toDouble());
+        step.blocks = obj.value("blocks").toInt();
+        step.path = obj.value("path").toString();
+        step.status = obj.value("status").toInt(200);
+        step.clear = obj.value("clear").toBool();
+        QJsonValue body = obj.value("body");
+        if (body.isObject()) {
+            step.body = QJsonDocument(body.toObject()).toJson(QJsonDocument::Compact);
+        } else if (body.isArray()) {
+            step.body = QJsonDocument(body.toArray()).toJson(QJsonDocument::Compact);
+        } else {
+            step.body = body.toString().toUtf8();
+        }
+        steps.append(step);
+    }
+    m_steps = steps;
+    m_error.clear();
+    return true;
+}
+
+QList<ReplayHarness::Step> ReplayHarness::generated(int steps, int intervalMs, int blocksPerStep)
+{
+    QList<Step> result;
+    for (int i = 0; i < steps; ++i) {
+        Step step;
+        step.atMs = static_cast<qint64>(i) * intervalMs;
+        step.blocks = blocksPerStep;
+        result.append(step);
+    }
+    return result;
+}
+
+void ReplayHarness::play()
+{
+    stop();
+    m_next = 0;
+    m_appliedAtNs.clear();
+    m_playing = true;
+    m_clock.restart();
+    scheduleNext();
+}
+
+void ReplayHarness::stop()
+{
+    m_playing = false;
+    ++m_generation;
+}
+
+bool ReplayHarness::stepNow()
+{
+    if (m_next >= m_steps.size()) {
+        return false;
+    }
+    apply(m_next++);
+    return true;
+}
+
+void ReplayHarness::scheduleNext()
+{
+    if (m_next >= m_steps.size()) {
+        m_playing = false;
+        emit finished();
+        return;
+    }
+    qint64 waitMs = qMax<qint64>(0, m_steps[m_next].atMs - m_clock.elapsed());
+    quint64 generation = m_generation;
+    QTimer::singleShot(static_cast<int>(waitMs), this, [this, generation]() {
+        if (generation != m_generation) {
+            return;
+        }
+        apply(m_next++);
+        scheduleNext();
+    });
+}
+
+void ReplayHarness::apply(int i)
+{
+    const Step& step = m_steps[i];
+    if (!step.path.isEmpty()) {
+        if (step.clear) {
+            m_server->clearResponse(step.path);
+        } else {
+            m_server->setResponse(step.path, step.body, step.status);
+        }
+    }
+    m_server->appendBlocks(step.blocks);
+
+    while (m_appliedAtNs.size() <= i) {
+        m_appliedAtNs.append(-1);
+    }
+    m_appliedAtNs[i] = m_clock.nsecsElapsed();
+    emit stepApplied(i, m_server->tipHeight());
+}
@@ -0,0 +1,72 @@
+#ifndef REPLAYHARNESS_H
+#define REPLAYHARNESS_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+class MockRpcServer;
+
+// Plays a session against a MockRpcServer: the chain grows and recorded
+// responses change at set times, the way they did on a real node. A session
+// file has one JSON object per line:
+//
+//   {"atMs": 0,    "blocks": 1}                                grow the chain
+//   {"atMs": 2000, "path": "/tx/recent", "status": 200, "body": [...]}
+//   {"atMs": 4000, "path": "/tx/recent", "clear": true}        back to generated
+//
+// Bodies are captured with e.g. curl from a node and pasted in. Without a
+// file, generated() makes a session that appends blocks at a steady rate.
+class ReplayHarness : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Step {
+        qint64 atMs = 0;
+        int blocks = 0;        // Appended when the step runs
+        QString path;          // Recorded response to install, if any
+        QByteArray body;
+        int status = 200;
+        bool clear = false;    // Remove the recorded response for path
+    };
+
+    explicit ReplayHarness(MockRpcServer* server, QObject *parent = nullptr);
+
+    // False, with the failing line in errorString(), if the file is unusable
+    bool load(const QString& fileName);
+    QString errorString() const { return m_error; }
+    static QList<Step> generated(int steps, int intervalMs, int blocksPerStep = 1);
+    void setSteps(const QList<Step>& steps) { m_steps = steps; }
+    int stepCount() const { return m_steps.size(); }
+
+    void play();
+    void stop();
+    bool isPlaying() const { return m_playing; }
+    // Applies the next step now, whatever its time; false when none is left
+    bool stepNow();
+
+    // When step i was applied, on the harness clock; -1 if it has not been
+    qint64 appliedAtNs(int i) const { return m_appliedAtNs.value(i, -1); }
+    qint64 elapsedNs() const { return m_clock.nsecsElapsed(); }
+
+signals:
+    void stepApplied(int step, quint64 tipHeight);
+    void finished();
+
+private:
+    MockRpcServer* m_server;
+    QList<Step> m_steps;
+    QList<qint64> m_appliedAtNs;
+    QString m_error;
+    QElapsedTimer m_clock;
+    int m_next;
+    bool m_playing;
+    quint64 m_generation;  // Invalidates timers of an earlier play()
+
+    void apply(int i);
+    void scheduleNext();
+};
+
+#endif // REPLAYHARNESS_H
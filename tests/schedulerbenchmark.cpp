@@ -0,0 +1,93 @@
+#include <QtTest>
+#include <QWidget>
+#include "benchutil.h"
+#include "refreshscheduler.h"
+
+// Intervals as MainWindow schedules them
+static const int kTipPollMs = 5000;           // Default RpcConfig::pollIntervalMs
+static const int kStreamingTipPollMs = 60000;
+static const int kEndpointProbeMs = 15000;
+
+// Refresh wakeups in a minute of an idle window: the tip does not move and
+// nobody touches the window. Before the scheduler seven timers ran whatever
+// the window showed: MainWindow's 5 s poll, the 5 s status timers of
+// OverviewPage, NodePage, FarmerPage and ArchivasNodeManager, and the 10 s
+// refresh timers of BlocksPage and TransactionsPage; they are rebuilt here as
+// plain QTimers. Now RefreshScheduler runs the tasks MainWindow registers and
+// counts its wakeups itself. Each case settles first, so back-off has reached
+// its limit before the minute that is counted.
+class SchedulerBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void legacyTimers();
+    void scheduler_data();
+    void scheduler();
+
+private:
+    int settleMs() const { return scaled(60000, 1000); }
+    int windowMs() const { return scaled(60000, 1000); }
+};
+
+void SchedulerBenchmark::legacyTimers()
+{
+    int wakeups = 0;
+    QObject owner;
+    for (int intervalMs : {5000, 5000, 5000, 5000, 5000, 10000, 10000}) {
+        QTimer* timer = new QTimer(&owner);
+        connect(timer, &QTimer::timeout, this, [&wakeups]() { ++wakeups; });
+        timer->start(intervalMs);
+    }
+
+    QTest::qWait(settleMs());
+    wakeups = 0;
+    QTest::qWait(windowMs());
+
+    report("timers", QString::number(owner.children().size()));
+    report("wakeups in the last minute", QString::number(wakeups));
+}
+
+void SchedulerBenchmark::scheduler_data()
+{
+    QTest::addColumn<bool>("streaming");
+    QTest::addColumn<bool>("minimized");
+
+    QTest::newRow("visible, polling") << false << false;
+    QTest::newRow("visible, event stream live") << true << false;
+    QTest::newRow("minimized") << false << true;
+}
+
+void SchedulerBenchmark::scheduler()
+{
+    QFETCH(bool, streaming);
+    QFETCH(bool, minimized);
+
+    QWidget overviewPage;
+    QWidget transactionsPage;
+    RefreshScheduler scheduler;
+    scheduler.setCurrentPage(&overviewPage);
+    scheduler.setPaused(minimized);
+
+    // As in MainWindow::startPolling; the tip never moves, so every poll backs off
+    int tipRuns = 0;
+    int tipTask = -1;
+    tipTask = scheduler.addTask(nullptr, streaming ? kStreamingTipPollMs : kTipPollMs, [&]() {
+        ++tipRuns;
+        scheduler.backOff(tipTask);
+    });
+    scheduler.addTask(nullptr, kEndpointProbeMs, []() {});
+    int transactionsTask = scheduler.addTask(&transactionsPage, 0, []() {});
+    scheduler.addTask(&overviewPage, 0, []() {});
+    scheduler.requestRun(tipTask);
+    scheduler.requestRun(transactionsTask);
+
+    QTest::qWait(settleMs() + windowMs());
+
+    report("tip polls", QString::number(tipRuns));
+    report("wakeups in the last minute", QString::number(scheduler.wakeupsPerMinute()));
+}
+
+ARCHIVAS_BENCHMARK(SchedulerBenchmark);
+
+#include "schedulerbenchmark.moc"
@@ -0,0 +1,141 @@
+#include <QtTest>
+#include <QTableView>
+#include "benchutil.h"
+#include "mockrpcserver.h"
+#include "archivasrpcclient.h"
+#include "blockheadercache.h"
+#include "blockspage.h"
+#include "transactionindex.h"
+#include "transactionspage.h"
+
+// Latency from the node applying a block to its row being on the Blocks page,
+// and from a transaction entering the mempool to its pending row on the
+// Transactions page, with the client subscribed to the mock node's event
+// stream instead of polling. Nothing else refreshes the pages meanwhile, so
+// the rows can only arrive through the stream.
+class StreamBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void blockLatency_data();
+    void blockLatency();
+    void mempoolLatency();
+
+private:
+    MockRpcServer* m_server = nullptr;
+    ArchivasRpcClient* m_client = nullptr;
+    BlockHeaderCache* m_headerCache = nullptr;
+    TransactionIndex* m_txIndex = nullptr;
+    BlocksPage* m_blocksPage = nullptr;
+    TransactionsPage* m_transactionsPage = nullptr;
+    QAbstractItemModel* m_blocks = nullptr;
+    QAbstractItemModel* m_txs = nullptr;
+
+    bool blockShown(quint64 height) const;
+};
+
+bool StreamBenchmark::blockShown(quint64 height) const
+{
+    return m_blocks->rowCount() > 0 &&
+           m_blocks->index(0, BlockHistoryModel::HeightColumn).data().toULongLong() == height &&
+           !m_blocks->index(0, BlockHistoryModel::HashColumn).data().isNull();
+}
+
+void StreamBenchmark::initTestCase()
+{
+    m_server = new MockRpcServer(this);
+    QVERIFY(m_server->start());
+    m_server->setTipHeight(10000);
+
+    m_client = new ArchivasRpcClient(this);
+    m_client->setEndpoints({m_server->url()});
+    m_client->setCacheTtl(0);
+    m_headerCache = new BlockHeaderCache(m_client, this);
+    m_txIndex = new TransactionIndex(m_client, this);
+    m_blocksPage = new BlocksPage(m_client, m_headerCache);
+    m_transactionsPage = new TransactionsPage(m_client, m_txIndex);
+    m_blocksPage->resize(1000, 700);
+    m_transactionsPage->resize(1000, 700);
+    m_blocksPage->show();
+    m_transactionsPage->show();
+    m_blocks = m_blocksPage->findChild<QTableView*>()->model();
+    m_txs = m_transactionsPage->findChild<QTableView*>()->model();
+
+    // One poll, so the followed chain has a cursor for streamed blocks to extend
+    m_client->getChainTip();
+    m_transactionsPage->refresh();
+    QVERIFY(waitUntil([this]() { return blockShown(m_server->tipHeight()) && m_txs->rowCount() > 0; }));
+
+    m_client->subscribe(m_server->streamUrl());
+    QVERIFY(waitUntil([this]() { return m_client->isSubscribed(); }));
+}
+
+void StreamBenchmark::cleanupTestCase()
+{
+    m_client->subscribe(QString());
+    delete m_blocksPage;
+    delete m_transactionsPage;
+}
+
+void StreamBenchmark::blockLatency_data()
+{
+    QTest::addColumn<int>("blocksPerStep");
+
+    QTest::newRow("1 block") << 1;
+    QTest::newRow("burst of 10 blocks") << 10;
+}
+
+void StreamBenchmark::blockLatency()
+{
+    QFETCH(int, blocksPerStep);
+
+    Samples latency;
+    Samples busy;
+    int timedOut = 0;
+    int steps = scaled(200, 10);
+    RpcStats before = m_client->stats();
+    for (int step = 0; step < steps; ++step) {
+        Measurement measurement;
+        m_server->appendBlocks(blocksPerStep);
+        quint64 height = m_server->tipHeight();
+        if (!waitUntil([this, height]() { return blockShown(height); }, 10000)) {
+            ++timedOut;
+            continue;
+        }
+        latency.add(measurement.elapsedNs());
+        busy.add(measurement.busyNs());
+    }
+    QVERIFY2(timedOut < qMax(1, steps / 10), "Too many streamed blocks never reached the page");
+
+    RpcStats after = m_client->stats();
+    report("block applied to row shown", latency);
+    report("GUI thread busy per step", busy);
+    report("HTTP requests per step",
+           QString::number(static_cast<double>(after.issued - before.issued) / qMax(1, latency.count()), 'f', 2));
+    report("steps timed out", QString::number(timedOut));
+}
+
+void StreamBenchmark::mempoolLatency()
+{
+    Samples latency;
+    int steps = scaled(200, 10);
+    for (int step = 0; step < steps; ++step) {
+        // An amount no listed transaction has, so the row is this one
+        qint64 amount = 2000000000LL + step;
+        Measurement measurement;
+        m_server->announceTransaction(Synthetic::address(step), Synthetic::address(step + 1), amount, 100);
+        QVERIFY(waitUntil([this, amount]() {
+            return m_txs->index(0, TransactionTableModel::AmountColumn).data().toLongLong() == amount;
+        }, 10000));
+        latency.add(measurement.elapsedNs());
+    }
+
+    report("transaction announced to row shown", latency);
+}
+
+ARCHIVAS_BENCHMARK(StreamBenchmark);
+
+#include "streambenchmark.moc"
@@ -0,0 +1,275 @@
+#include <QtTest>
+#include <QHeaderView>
+#include <QTableView>
+#include <QTableWidget>
+#include "benchutil.h"
+#include "mockrpcserver.h"
+#include "archivasrpcclient.h"
+#include "blockheadercache.h"
+#include "blockspage.h"
+#include "chaintablemodels.h"
+
+static const int kTxsPerBlock = 10;
+// Rows in the block history; the model holds none of them, so this is not scaled
+static const quint64 kHistoryTip = 1000000;
+static const qint64 kTargetNs = 1000000;
+
+// BlockInfo as it was while BlocksPage filled a QTableWidget
+struct LegacyBlockInfo {
+    QString height;
+    QString hash;
+    QString farmer;
+    int txCount;
+    QString timestamp;
+    QString difficulty;
+};
+
+static LegacyBlockInfo legacyBlock(quint64 height)
+{
+    LegacyBlockInfo block;
+    block.height = QString::number(height);
+    block.hash = Synthetic::blockHash(height);
+    block.farmer = Synthetic::farmer(height);
+    block.txCount = kTxsPerBlock;
+    block.timestamp = formatTimestamp(Synthetic::timestamp(height));
+    block.difficulty = QString::number(1000000 + height % 1000);
+    return block;
+}
+
+// BlocksPage::updateTable before the model: every refresh rebuilt every cell
+static void legacyUpdateTable(QTableWidget* table, const QList<LegacyBlockInfo>& blocks)
+{
+    table->setRowCount(blocks.size());
+
+    for (int i = 0; i < blocks.size(); ++i) {
+        const LegacyBlockInfo& block = blocks[i];
+
+        table->setItem(i, 0, new QTableWidgetItem(block.height));
+
+        QString shortHash = block.hash;
+        if (shortHash.length() > 16) {
+            shortHash = shortHash.left(8) + "..." + shortHash.right(8);
+        }
+        QTableWidgetItem* hashItem = new QTableWidgetItem(shortHash);
+        hashItem->setData(Qt::UserRole, block.hash);
+        hashItem->setToolTip(block.hash);
+        table->setItem(i, 1, hashItem);
+
+        QString shortFarmer = block.farmer;
+        if (shortFarmer.length() > 16) {
+            shortFarmer = shortFarmer.left(8) + "..." + shortFarmer.right(8);
+        }
+        QTableWidgetItem* farmerItem = new QTableWidgetItem(shortFarmer);
+        farmerItem->setToolTip(block.farmer);
+        table->setItem(i, 2, farmerItem);
+
+        table->setItem(i, 3, new QTableWidgetItem(QString::number(block.txCount)));
+        table->setItem(i, 4, new QTableWidgetItem(block.timestamp));
+        table->setItem(i, 5, new QTableWidgetItem(block.difficulty));
+    }
+
+    table->resizeColumnsToContents();
+}
+
+// The transactions of the block at height, last first, as the client lists them
+static QList<TransactionInfo> blockTransactions(quint64 height)
+{
+    QList<TransactionInfo> txs;
+    for (int index = kTxsPerBlock - 1; index >= 0; --index) {
+        txs.append(Synthetic::transaction(height, index));
+    }
+    return txs;
+}
+
+// Until the update is on screen: deferred layout runs and the viewport paints
+static void flushAndPaint(QAbstractItemView* view)
+{
+    QCoreApplication::sendPostedEvents();
+    view->viewport()->repaint();
+}
+
+static void reportTarget(const Samples& samples)
+{
+    report("under 1 ms at p99", samples.percentile(99) < kTargetNs ? "yes" : "no");
+}
+
+// Cost of showing one new block. Before, BlocksPage rebuilt a QTableWidget of
+// the whole list on each refresh, so the cost grew with the rows kept; it is
+// measured up to 100k rows, past which the widget alone runs to gigabytes.
+// Now BlockHistoryModel spans the chain and a new block inserts one row, so it
+// is measured at a 1M block tip, as are TransactionTableModel's diffed updates
+// at the list sizes the Transactions page shows. Each sample includes the
+// view's layout and a repaint of the visible rows.
+class TableBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tableWidget_data();
+    void tableWidget();
+    void blockHistory();
+    void transactionTable_data();
+    void transactionTable();
+};
+
+void TableBenchmark::tableWidget_data()
+{
+    QTest::addColumn<int>("rows");
+
+    QTest::newRow("QTableWidget, 20 rows") << 20;
+    QTest::newRow("QTableWidget, 1k rows") << 1000;
+    QTest::newRow("QTableWidget, 10k rows") << 10000;
+    QTest::newRow("QTableWidget, 100k rows") << 100000;
+}
+
+void TableBenchmark::tableWidget()
+{
+    QFETCH(int, rows);
+    rows = scaled(rows, qMin(rows, 20));
+    int updates = rows >= 10000 ? 5 : scaled(200, 20);
+
+    QTableWidget table;
+    table.setColumnCount(6);
+    table.setHorizontalHeaderLabels({"Height", "Hash", "Farmer", "Tx Count", "Timestamp", "Difficulty"});
+    table.resize(1000, 700);
+    table.show();
+
+    quint64 tip = kHistoryTip;
+    QList<LegacyBlockInfo> blocks;
+    for (int i = 0; i < rows; ++i) {
+        blocks.append(legacyBlock(tip - static_cast<quint64>(i)));
+    }
+    legacyUpdateTable(&table, blocks);
+    flushAndPaint(&table);
+
+    Samples latency;
+    Samples allocations;
+    for (int i = 0; i < updates; ++i) {
+        blocks.prepend(legacyBlock(++tip));
+        blocks.removeLast();
+
+        Measurement measurement;
+        legacyUpdateTable(&table, blocks);
+        flushAndPaint(&table);
+        latency.add(measurement.elapsedNs());
+        allocations.add(static_cast<qint64>(measurement.threadAllocations()));
+        QCoreApplication::processEvents();
+    }
+
+    report("update latency", latency);
+    reportAllocations("allocations per update", allocations);
+    reportTarget(latency);
+}
+
+void TableBenchmark::blockHistory()
+{
+    // Serves the pages the first screen asks for; new blocks are then handed
+    // to the model as the client reports them
+    MockRpcServer server;
+    QVERIFY(server.start());
+    server.setTipHeight(kHistoryTip);
+
+    ArchivasRpcClient client;
+    client.setEndpoints({server.url()});
+    client.setCacheTtl(0);
+    BlockHeaderCache headerCache(&client);
+    BlocksPage page(&client, &headerCache);
+    page.resize(1000, 700);
+    page.show();
+    QTableView* view = page.findChild<QTableView*>();
+    QAbstractItemModel* model = view->model();
+
+    quint64 tip = kHistoryTip;
+    ChainTip chainTip;
+    chainTip.height = tip;
+    chainTip.hash = Hash32::fromHex(Synthetic::blockHash(tip));
+    emit client.chainTipUpdated(chainTip);
+    QVERIFY(waitUntil([model]() {
+        return !model->index(0, BlockHistoryModel::HashColumn).data().isNull();
+    }));
+
+    Samples latency;
+    Samples allocations;
+    int updates = scaled(1000, 50);
+    for (int i = 0; i < updates; ++i) {
+        BlockInfo block = Synthetic::block(++tip, kTxsPerBlock);
+        server.setTipHeight(tip);
+        chainTip.height = tip;
+        chainTip.hash = block.hash;
+
+        // In the order the client reports a followed block
+        Measurement measurement;
+        emit client.chainTipUpdated(chainTip);
+        emit client.blocksAppended({block});
+        flushAndPaint(view);
+        latency.add(measurement.elapsedNs());
+        allocations.add(static_cast<qint64>(measurement.threadAllocations()));
+        QCoreApplication::processEvents();
+    }
+
+    QCOMPARE(model->rowCount(), static_cast<int>(tip + 1));
+    QCOMPARE(model->index(0, BlockHistoryModel::HeightColumn).data().toULongLong(), tip);
+    QVERIFY(!model->index(0, BlockHistoryModel::HashColumn).data().isNull());
+
+    report("rows", QString::number(model->rowCount()));
+    report("update latency", latency);
+    reportAllocations("allocations per update", allocations);
+    reportTarget(latency);
+}
+
+void TableBenchmark::transactionTable_data()
+{
+    QTest::addColumn<int>("rows");
+
+    QTest::newRow("TransactionTableModel, 50 rows") << 50;
+    QTest::newRow("TransactionTableModel, 1000 rows") << 1000;
+}
+
+void TableBenchmark::transactionTable()
+{
+    QFETCH(int, rows);
+
+    TransactionTableModel model;
+    QTableView view;
+    view.setModel(&model);
+    view.verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view.resize(1000, 700);
+    view.show();
+
+    quint64 tip = kHistoryTip;
+    QList<TransactionInfo> txs;
+    for (quint64 height = tip; txs.size() < rows; --height) {
+        txs.append(blockTransactions(height));
+    }
+    txs = txs.mid(0, rows);
+    model.setTransactions(txs);
+    flushAndPaint(&view);
+
+    // Each refresh lists one block more at the top and drops as many at the bottom
+    Samples latency;
+    Samples allocations;
+    int updates = scaled(1000, 50);
+    for (int i = 0; i < updates; ++i) {
+        QList<TransactionInfo> newer = blockTransactions(++tip);
+        newer.append(txs.mid(0, rows - newer.size()));
+        txs = newer;
+
+        Measurement measurement;
+        model.setTransactions(txs);
+        flushAndPaint(&view);
+        latency.add(measurement.elapsedNs());
+        allocations.add(static_cast<qint64>(measurement.threadAllocations()));
+        QCoreApplication::processEvents();
+    }
+
+    QCOMPARE(model.rowCount(), rows);
+    QCOMPARE(model.index(0, TransactionTableModel::HeightColumn).data().toULongLong(), tip);
+
+    report("update latency", latency);
+    reportAllocations("allocations per update", allocations);
+    reportTarget(latency);
+}
+
+ARCHIVAS_BENCHMARK(TableBenchmark);
+
+#include "tablebenchmark.moc"